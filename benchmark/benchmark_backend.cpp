@@ -0,0 +1,297 @@
+//!
+//! @file benchmark_backend.cpp
+//!
+//! @brief 数学ライブラリの A/B 計測 (object/math_policy.h の Policy 毎)
+//!        同じシーン (姿勢・カメラ・プレイヤーの移動とジャンプ・ミサイルのホーミング) を
+//!        amg_math (_AMG_MATH) と dx_math (DX ライブラリ) で処理して、処理毎の時間と amg_math との誤差を出力する
+//!        描画はしないのでウィンドウは作らない(DX ライブラリの計算関数は DxLib_Init なしで使える)
+//!
+//! @details
+//! benchmark/CMakeLists.txt の benchmark_backend ターゲット
+//! dx_math は DXLIB_DIR (DxLib.h と lib のあるディレクトリ) を指定した場合だけ計測する
+//!   cmake -S benchmark -B build -DDXLIB_DIR=C:/DxLib/プロジェクトに追加すべきファイル_VC用
+//!
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+#include "math_policy.h"
+#if defined(BENCHMARK_DXLIB)
+#include "dx_math_policy.h"
+#endif
+
+namespace {
+    constexpr auto object_num = 4096;
+    constexpr auto frame_num = 60;
+    constexpr auto repeat_num = 20;
+    constexpr auto gravity = 9.8;
+
+    volatile double sink = 0.0;
+
+    // 処理毎の時間 (ns / 要素) と結果 (誤差の比較用)
+    struct subsystem_result {
+        double ns;
+        std::vector<double> values;
+    };
+
+    template <typename Function>
+    double measure(const std::size_t count, Function function) {
+        const auto start = std::chrono::steady_clock::now();
+
+        for (auto r = 0; r < repeat_num; ++r) {
+            function();
+        }
+
+        const auto end = std::chrono::steady_clock::now();
+        const auto ns = std::chrono::duration<double, std::nano>(end - start).count();
+
+        return ns / (static_cast<double>(repeat_num) * count);
+    }
+
+    // 入力はどの Policy でも同じ値にする
+    double get_input(const int i, const double scale, const double offset) {
+        return std::fmod(i * scale, 1.0) * offset;
+    }
+
+    template <typename Policy, typename Matrix>
+    void add_matrix(std::vector<double>& values, const Matrix& matrix) {
+        for (auto i = 0; i < 4; ++i) {
+            for (auto j = 0; j < 4; ++j) {
+                values.emplace_back(Policy::get_value(matrix, i, j));
+            }
+        }
+    }
+
+    template <typename Policy>
+    void add_vector(std::vector<double>& values, const typename Policy::vector& vector) {
+        values.emplace_back(Policy::get_x(vector));
+        values.emplace_back(Policy::get_y(vector));
+        values.emplace_back(Policy::get_z(vector));
+    }
+
+    // 姿勢 : スケール x オイラー角の回転 x 平行移動
+    template <typename Policy>
+    subsystem_result run_posture() {
+        using posture = backend::posture_math<Policy>;
+
+        std::vector<typename Policy::vector> scales;
+        std::vector<typename Policy::vector> rotations;
+        std::vector<typename Policy::vector> positions;
+
+        for (auto i = 0; i < object_num; ++i) {
+            scales.emplace_back(Policy::make_vector(1.0 + get_input(i, 0.37, 2.0), 1.0, 1.0 + get_input(i, 0.53, 2.0)));
+            rotations.emplace_back(Policy::make_vector(get_input(i, 0.11, 360.0), get_input(i, 0.29, 360.0), get_input(i, 0.71, 360.0)));
+            positions.emplace_back(Policy::make_vector(get_input(i, 0.13, 5000.0), get_input(i, 0.17, 500.0), get_input(i, 0.19, 5000.0)));
+        }
+
+        subsystem_result result;
+
+        result.ns = measure(object_num, [&]() {
+            auto sum = 0.0;
+
+            for (auto i = 0; i < object_num; ++i) {
+                sum += Policy::get_value(posture::make(scales[i], rotations[i], positions[i]).posture, 3, 0);
+            }
+
+            sink = sink + sum;
+        });
+
+        for (auto i = 0; i < object_num; ++i) {
+            add_matrix<Policy>(result.values, posture::make(scales[i], rotations[i], positions[i]).posture);
+        }
+
+        return result;
+    }
+
+    // カメラ : ビュー、射影、ビルボード
+    template <typename Policy>
+    subsystem_result run_camera() {
+        using camera = backend::camera_math<Policy>;
+
+        const auto up = Policy::make_vector(0.0, 1.0, 0.0);
+        std::vector<typename Policy::vector> positions;
+        std::vector<typename Policy::vector> targets;
+
+        for (auto i = 0; i < object_num; ++i) {
+            positions.emplace_back(Policy::make_vector(get_input(i, 0.13, 2000.0) - 1000.0, 100.0 + get_input(i, 0.17, 500.0), -1000.0 - get_input(i, 0.19, 500.0)));
+            targets.emplace_back(Policy::make_vector(get_input(i, 0.23, 100.0), get_input(i, 0.31, 100.0), get_input(i, 0.37, 100.0)));
+        }
+
+        const auto projection = [](const int i) {
+            return camera::projection(0.5 + get_input(i, 0.41, 0.5), 16.0 / 9.0, 1.0, 10000.0);
+        };
+
+        subsystem_result result;
+
+        result.ns = measure(object_num, [&]() {
+            auto sum = 0.0;
+
+            for (auto i = 0; i < object_num; ++i) {
+                const auto view = camera::view(positions[i], targets[i], up);
+
+                sum += Policy::get_value(view, 3, 2) + Policy::get_value(projection(i), 0, 0) + Policy::get_value(camera::billboard(view), 0, 1);
+            }
+
+            sink = sink + sum;
+        });
+
+        for (auto i = 0; i < object_num; ++i) {
+            const auto view = camera::view(positions[i], targets[i], up);
+
+            add_matrix<Policy>(result.values, view);
+            add_matrix<Policy>(result.values, projection(i));
+            add_matrix<Policy>(result.values, camera::billboard(view));
+        }
+
+        return result;
+    }
+
+    // プレイヤー : 回転しながら前進して、ジャンプの放物線を frame_num フレーム分求める
+    template <typename Policy>
+    subsystem_result run_player() {
+        using player = backend::player_math<Policy>;
+
+        const auto simulate = [](const int i, std::vector<double>* values) {
+            auto position = Policy::make_vector(0.0, 0.0, 0.0);
+            auto direction = Policy::make_vector(0.0, 0.0, -1.0);
+            auto moved = Policy::make_vector(0.0, 0.0, 0.0);
+            const auto rotate = get_input(i, 0.07, 10.0) - 5.0;
+
+            for (auto frame = 0; frame < frame_num; ++frame) {
+                direction = player::rotate_direction(direction, rotate);
+                std::tie(position, moved) = player::forward(position, direction, 10.0);
+            }
+
+            auto velocity = player::jump_velocity(110.0, 85.0, rotate * frame_num);
+            auto jump_position = position;
+
+            for (auto frame = 1; frame <= frame_num; ++frame) {
+                jump_position = player::jump_position(position, velocity, frame, gravity);
+            }
+
+            velocity = player::reflect_velocity(velocity);
+
+            if (values != nullptr) {
+                add_vector<Policy>(*values, position);
+                add_vector<Policy>(*values, jump_position);
+                add_vector<Policy>(*values, velocity);
+            }
+
+            return Policy::get_y(jump_position) + Policy::get_x(moved);
+        };
+
+        subsystem_result result;
+
+        result.ns = measure(object_num, [&]() {
+            auto sum = 0.0;
+
+            for (auto i = 0; i < object_num; ++i) {
+                sum += simulate(i, nullptr);
+            }
+
+            sink = sink + sum;
+        }) / (frame_num * 2);
+
+        for (auto i = 0; i < object_num; ++i) {
+            simulate(i, &result.values);
+        }
+
+        return result;
+    }
+
+    // ミサイル : 上昇した位置から目標へ frame_num 回ホーミングする
+    template <typename Policy>
+    subsystem_result run_missile() {
+        using missile = backend::missile_math<Policy>;
+
+        const auto simulate = [](const int i, std::vector<double>* values) {
+            const auto target = Policy::make_vector(get_input(i, 0.13, 2000.0) - 1000.0, 0.0, get_input(i, 0.17, 2000.0) - 1000.0);
+            auto position = Policy::make_vector(get_input(i, 0.19, 200.0), 1500.0, get_input(i, 0.23, 200.0));
+            auto posture = math::quaternionf();
+
+            for (auto frame = 0; frame < frame_num; ++frame) {
+                posture = missile::homing(posture, position, target, 0.2f);
+
+                const auto y = posture.rotate(math::vector4f(0.0f, 1.0f, 0.0f));
+
+                position = Policy::add(position, Policy::make_vector(y.get_x() * 20.0, y.get_y() * 20.0, y.get_z() * 20.0));
+            }
+
+            if (values != nullptr) {
+                add_vector<Policy>(*values, position);
+            }
+
+            return Policy::get_y(position);
+        };
+
+        subsystem_result result;
+
+        result.ns = measure(object_num, [&]() {
+            auto sum = 0.0;
+
+            for (auto i = 0; i < object_num; ++i) {
+                sum += simulate(i, nullptr);
+            }
+
+            sink = sink + sum;
+        }) / frame_num;
+
+        for (auto i = 0; i < object_num; ++i) {
+            simulate(i, &result.values);
+        }
+
+        return result;
+    }
+
+    template <typename Policy>
+    std::array<subsystem_result, 4> run() {
+        return { run_posture<Policy>(), run_camera<Policy>(), run_player<Policy>(), run_missile<Policy>() };
+    }
+
+    // 基準 (amg_math) との最大誤差
+    double get_drift(const std::vector<double>& base, const std::vector<double>& values) {
+        auto drift = 0.0;
+
+        for (std::size_t i = 0; i < std::min(base.size(), values.size()); ++i) {
+            drift = std::max(drift, std::abs(base[i] - values[i]));
+        }
+
+        return drift;
+    }
+
+    void print(const char* name, const std::array<subsystem_result, 4>& base, const std::array<subsystem_result, 4>& results) {
+        std::printf("%-8s", name);
+
+        for (std::size_t i = 0; i < results.size(); ++i) {
+            std::printf(" %9.2f ns %9.2e", results[i].ns, get_drift(base[i].values, results[i].values));
+        }
+
+        std::printf("\n");
+    }
+}
+
+int main() {
+    const char* names[] = { "posture", "camera", "player", "missile" };
+
+    std::printf("%-8s", "backend");
+
+    for (const auto* name : names) {
+        std::printf(" %12s %9s", name, "drift");
+    }
+
+    std::printf("\n");
+
+    const auto amg = run<backend::amg_math>();
+
+    print(backend::amg_math::name, amg, amg);
+
+#if defined(BENCHMARK_DXLIB)
+    print(backend::dx_math::name, amg, run<backend::dx_math>());
+#else
+    std::printf("%-8s (DXLIB_DIR が指定されていないので計測しない)\n", "dx");
+#endif
+
+    return 0;
+}
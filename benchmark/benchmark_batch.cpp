@@ -0,0 +1,418 @@
+//!
+//! @file benchmark_batch.cpp
+//!
+//! @brief batch class (SoA 一括変換) の計測
+//!        vector4 * matrix44 を要素毎に呼ぶ場合と、命令セット毎の batch::transform_point を比較する
+//!        線分と四角形の交差判定は utility::collision_polygon_line を四角形毎に呼ぶ場合と batch::intersect_segment_quad を比較する
+//!        三角形の内外判定は 変更前の正規化による判定 と utility::inside_triangle_point、batch::inside_triangle_point を比較する
+//!        視錐台カリングは frustum::intersect_sphere / intersect_aabb をオブジェクト毎に呼ぶ場合と batch::cull を比較する
+//!
+//! @details
+//! g++ -std=c++20 -O2 -I../math benchmark_batch.cpp ../math/batch.cpp ../math/frustum.cpp ../math/matrix44.cpp ../math/vector4.cpp ../math/utility.cpp ../math/simd.cpp ../math/fast_math.cpp -o benchmark_batch
+//!
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <span>
+#include <vector>
+#include "batch.h"
+#include "frustum.h"
+#include "matrix44.h"
+#include "vector4.h"
+#include "simd.h"
+#include "utility.h"
+
+namespace {
+    constexpr auto vertex_num = 40000;
+    constexpr auto repeat_num = 200;
+
+    volatile double sink = 0.0;
+
+    template <typename Function>
+    double measure(Function function) {
+        const auto start = std::chrono::steady_clock::now();
+
+        for (auto r = 0; r < repeat_num; ++r) {
+            function();
+        }
+
+        const auto end = std::chrono::steady_clock::now();
+        const auto ns = std::chrono::duration<double, std::nano>(end - start).count();
+
+        return ns / (static_cast<double>(repeat_num) * vertex_num);
+    }
+
+    const char* get_name(const math::simd_level level) {
+        switch (level) {
+        case math::simd_level::avx2:
+            return "avx2";
+
+        case math::simd_level::sse2:
+            return "sse2";
+
+        case math::simd_level::scalar:
+        default:
+            return "scalar";
+        }
+    }
+
+    template <typename T>
+    void run(const char* type_name) {
+        math::basic_matrix44<T> matrix;
+
+        matrix.rotate_y(30, true);
+        matrix.rotate_x(15, false);
+        matrix = matrix + math::basic_vector4<T>(100, 200, 300);
+
+        std::vector<math::basic_vector4<T>> vectors;
+        math::basic_soa_buffer<T> source;
+        math::basic_soa_buffer<T> result;
+
+        source.resize(vertex_num);
+        result.resize(vertex_num);
+
+        auto source_span = source.span();
+
+        for (auto i = 0; i < vertex_num; ++i) {
+            const auto x = static_cast<T>(i % 200);
+            const auto y = static_cast<T>((i / 200) % 200);
+            const auto z = static_cast<T>(i % 7);
+
+            vectors.emplace_back(x, y, z);
+            source_span.x[i] = x;
+            source_span.y[i] = y;
+            source_span.z[i] = z;
+        }
+
+        std::vector<math::basic_vector4<T>> expected;
+
+        for (const auto& v : vectors) {
+            expected.emplace_back(v * matrix);
+        }
+
+        const auto aos = measure([&vectors, &matrix]() {
+            T sum = 0;
+
+            for (const auto& v : vectors) {
+                sum += (v * matrix).get_x();
+            }
+
+            sink = sink + sum;
+        });
+
+        std::printf("[%s] %d vertices\n%-8s %10s %10s %12s\n", type_name, vertex_num, "level", "ns/vertex", "speedup", "max error");
+        std::printf("%-8s %10.3f %10s %12s\n", "vec*mat", aos, "x1.0", "-");
+
+        const auto detected = math::simd::detect();
+        const std::array<math::simd_level, 3> levels = {
+            math::simd_level::scalar, math::simd_level::sse2, math::simd_level::avx2
+        };
+
+        for (const auto level : levels) {
+            if (static_cast<int>(level) > static_cast<int>(detected) || !math::simd::set_level(level)) {
+                continue;
+            }
+
+            const auto ns = measure([&matrix, &source, &result]() {
+                math::batch::transform_point(matrix, source.span(), result.span());
+                sink = sink + result.span().x[0];
+            });
+
+            const auto values = result.span();
+            auto error = 0.0;
+
+            for (auto i = 0; i < vertex_num; ++i) {
+                error = std::max(error, static_cast<double>(std::abs(values.x[i] - expected[i].get_x())));
+                error = std::max(error, static_cast<double>(std::abs(values.y[i] - expected[i].get_y())));
+                error = std::max(error, static_cast<double>(std::abs(values.z[i] - expected[i].get_z())));
+            }
+
+            std::printf("%-8s %10.3f %9s%.1f %12.3e\n", get_name(level), ns, "x", aos / ns, error);
+        }
+
+        math::simd::set_level(detected);
+    }
+
+    // x = i の位置に YZ 平面の四角形を並べて、x 軸方向の線分で交差判定する(7 枚中 2 枚が線分と交差する)
+    template <typename T>
+    void run_intersect(const char* type_name) {
+        std::array<math::basic_soa_buffer<T>, 4> points;
+
+        for (auto& point : points) {
+            point.resize(vertex_num);
+        }
+
+        std::vector<std::array<math::vector4, 4>> quads;
+
+        for (auto i = 0; i < vertex_num; ++i) {
+            const auto x = static_cast<double>(vertex_num - i);
+            const auto center = static_cast<double>(i % 7) - 3.0;
+            const std::array<math::vector4, 4> quad = {
+                math::vector4(x, center - 1.0, -1.0), math::vector4(x, center + 1.0, -1.0),
+                math::vector4(x, center - 1.0,  1.0), math::vector4(x, center + 1.0,  1.0)
+            };
+
+            for (auto k = 0; k < 4; ++k) {
+                const auto span = points[k].span();
+
+                span.x[i] = static_cast<T>(quad[k].get_x());
+                span.y[i] = static_cast<T>(quad[k].get_y());
+                span.z[i] = static_cast<T>(quad[k].get_z());
+            }
+
+            quads.emplace_back(quad);
+        }
+
+        const auto start = math::vector4(vertex_num + 1.0, 0.3, 0.2);
+        const auto end = math::vector4(-1.0, 0.3, 0.2);
+
+        // 四角形毎に判定して最も近い交点を探す
+        auto expected_index = static_cast<std::size_t>(vertex_num);
+        auto expected_distance = 0.0;
+
+        const auto per_quad = measure([&]() {
+            auto nearest = static_cast<std::size_t>(vertex_num);
+            auto distance = 0.0;
+
+            for (auto i = 0; i < vertex_num; ++i) {
+                const auto [hit, point] = math::utility::collision_polygon_line(quads[i][0], quads[i][1], quads[i][2], quads[i][3], start, end);
+
+                if (hit && (nearest == static_cast<std::size_t>(vertex_num) || (point - start).length() < distance)) {
+                    nearest = i;
+                    distance = (point - start).length();
+                }
+            }
+
+            expected_index = nearest;
+            expected_distance = distance;
+            sink = sink + distance;
+        });
+
+        std::printf("[%s] segment x %d quads\n%-8s %10s %10s %10s %12s\n", type_name, vertex_num, "level", "ns/quad", "speedup", "index", "ratio error");
+        std::printf("%-8s %10.3f %10s %10zu %12s\n", "utility", per_quad, "x1.0", expected_index, "-");
+
+        const auto expected_ratio = expected_distance / (end - start).length();
+        const auto typed_start = math::basic_vector4<T>(start);
+        const auto typed_end = math::basic_vector4<T>(end);
+        const auto detected = math::simd::detect();
+
+        for (const auto level : { math::simd_level::scalar, math::simd_level::sse2, math::simd_level::avx2 }) {
+            if (static_cast<int>(level) > static_cast<int>(detected) || !math::simd::set_level(level)) {
+                continue;
+            }
+
+            auto result = math::basic_segment_hit<T>();
+
+            const auto ns = measure([&]() {
+                result = math::batch::intersect_segment_quad(typed_start, typed_end, points[0].span(), points[1].span(), points[2].span(), points[3].span());
+                sink = sink + std::get<2>(result);
+            });
+
+            const auto [hit, index, ratio] = result;
+
+            std::printf("%-8s %10.3f %9s%.1f %10zu %12.3e\n", get_name(level), ns, "x", per_quad / ns,
+                        hit ? index : static_cast<std::size_t>(vertex_num), std::abs(static_cast<double>(ratio) - expected_ratio));
+        }
+
+        math::simd::set_level(detected);
+        std::printf("\n");
+    }
+
+    // 変更前の utility::inside_triangle_point (外積を正規化して内積の符号を比較する)
+    bool inside_triangle_point_normalize(const math::vector4& point0, const math::vector4& point1, const math::vector4& point2, const math::vector4& point) {
+        auto c0 = (point1 - point0).cross(point - point0);
+        auto c1 = (point2 - point1).cross(point - point1);
+        auto c2 = (point0 - point2).cross(point - point2);
+
+        c0.normalized(math::math_mode::fast);
+        c1.normalized(math::math_mode::fast);
+        c2.normalized(math::math_mode::fast);
+
+        return c0.dot(c1) > 0.0 && c0.dot(c2) > 0.0;
+    }
+
+    // 傾いた三角形と同平面の点 (三角形の外側も含む範囲) の内外判定
+    template <typename T>
+    void run_inside(const char* type_name) {
+        const auto point0 = math::vector4(10.0, 5.0, -3.0);
+        const auto point1 = math::vector4(110.0, 45.0, 17.0);
+        const auto point2 = math::vector4(-20.0, 80.0, 60.0);
+        const auto edge1 = point1 - point0;
+        const auto edge2 = point2 - point0;
+
+        std::vector<math::vector4> points;
+        math::basic_soa_buffer<T> source;
+
+        source.resize(vertex_num);
+
+        const auto span = source.span();
+
+        for (auto i = 0; i < vertex_num; ++i) {
+            const auto s = (i % 211) / 105.0 - 0.5;
+            const auto t = (i % 199) / 99.0 - 0.5;
+            const auto point = point0 + edge1 * s + edge2 * t;
+
+            points.emplace_back(point);
+            span.x[i] = static_cast<T>(point.get_x());
+            span.y[i] = static_cast<T>(point.get_y());
+            span.z[i] = static_cast<T>(point.get_z());
+        }
+
+        std::vector<char> expected(vertex_num);
+
+        const auto normalize = measure([&]() {
+            auto count = 0;
+
+            for (auto i = 0; i < vertex_num; ++i) {
+                expected[i] = inside_triangle_point_normalize(point0, point1, point2, points[i]);
+                count += expected[i];
+            }
+
+            sink = sink + count;
+        });
+
+        const auto edge_function = measure([&]() {
+            auto count = 0;
+
+            for (const auto& point : points) {
+                count += math::utility::inside_triangle_point(point0, point1, point2, point);
+            }
+
+            sink = sink + count;
+        });
+
+        auto inside_num = 0;
+        auto utility_mismatch = 0;
+
+        for (auto i = 0; i < vertex_num; ++i) {
+            inside_num += expected[i];
+            utility_mismatch += (math::utility::inside_triangle_point(point0, point1, point2, points[i]) != static_cast<bool>(expected[i])) ? 1 : 0;
+        }
+
+        // 辺上の点は判定が変わるので件数を出しておく
+        std::printf("[%s] %d points (inside %d)\n%-9s %10s %10s %10s\n", type_name, vertex_num, inside_num, "method", "ns/point", "speedup", "mismatch");
+        std::printf("%-9s %10.3f %10s %10s\n", "normalize", normalize, "x1.0", "-");
+        std::printf("%-9s %10.3f %9s%.1f %10d\n", "utility", edge_function, "x", normalize / edge_function, utility_mismatch);
+
+        const auto typed0 = math::basic_vector4<T>(point0);
+        const auto typed1 = math::basic_vector4<T>(point1);
+        const auto typed2 = math::basic_vector4<T>(point2);
+        std::unique_ptr<bool[]> result(new bool[vertex_num]);
+        const auto detected = math::simd::detect();
+
+        for (const auto level : { math::simd_level::scalar, math::simd_level::sse2, math::simd_level::avx2 }) {
+            if (static_cast<int>(level) > static_cast<int>(detected) || !math::simd::set_level(level)) {
+                continue;
+            }
+
+            const auto ns = measure([&]() {
+                math::batch::inside_triangle_point(typed0, typed1, typed2, source.span(), std::span<bool>(result.get(), vertex_num));
+                sink = sink + result[0];
+            });
+
+            auto mismatch = 0;
+
+            for (auto i = 0; i < vertex_num; ++i) {
+                mismatch += (result[i] != static_cast<bool>(expected[i])) ? 1 : 0;
+            }
+
+            std::printf("%-9s %10.3f %9s%.1f %10d\n", get_name(level), ns, "x", normalize / ns, mismatch);
+        }
+
+        math::simd::set_level(detected);
+        std::printf("\n");
+    }
+
+    // カメラの周囲に散らばった境界 (球 + 軸平行境界箱) の視錐台カリング
+    template <typename T>
+    void run_cull(const char* type_name) {
+        auto view = math::basic_matrix44<T>();
+        auto projection = math::basic_matrix44<T>();
+
+        view.look_at(math::basic_vector4<T>(0, 500, -2000), math::basic_vector4<T>(0, 0, 0), math::basic_vector4<T>(0, 1, 0));
+        projection.perspective(static_cast<T>(1.0), static_cast<T>(16.0 / 9.0), 1, 10000);
+
+        const auto frustum = math::basic_frustum<T>(view * projection);
+
+        math::basic_soa_buffer<T> center;
+        math::basic_soa_buffer<T> extent;
+        std::vector<T> radius(vertex_num);
+
+        center.resize(vertex_num);
+        extent.resize(vertex_num);
+
+        const auto c = center.span();
+        const auto e = extent.span();
+
+        for (auto i = 0; i < vertex_num; ++i) {
+            c.x[i] = static_cast<T>(((i * 37) % 1999) * 10.0 - 10000.0);
+            c.y[i] = static_cast<T>(((i * 53) % 401) * 5.0 - 1000.0);
+            c.z[i] = static_cast<T>(((i * 71) % 2003) * 10.0 - 10000.0);
+            e.x[i] = static_cast<T>(20 + (i % 13) * 10);
+            e.y[i] = static_cast<T>(20 + (i % 7) * 10);
+            e.z[i] = static_cast<T>(20 + (i % 11) * 10);
+            radius[i] = std::sqrt(e.x[i] * e.x[i] + e.y[i] * e.y[i] + e.z[i] * e.z[i]);
+        }
+
+        std::vector<char> expected(vertex_num);
+
+        const auto per_object = measure([&]() {
+            auto count = 0;
+
+            for (auto i = 0; i < vertex_num; ++i) {
+                const auto position = math::basic_vector4<T>(c.x[i], c.y[i], c.z[i]);
+                const auto size = math::basic_vector4<T>(e.x[i], e.y[i], e.z[i]);
+
+                expected[i] = frustum.intersect_sphere(position, radius[i]) && frustum.intersect_aabb(position - size, position + size);
+                count += expected[i];
+            }
+
+            sink = sink + count;
+        });
+
+        const auto visible_num = std::count(expected.begin(), expected.end(), 1);
+
+        std::printf("[%s] %d bounds (visible %d)\n%-9s %10s %10s %10s\n", type_name, vertex_num, static_cast<int>(visible_num), "method", "ns/bound", "speedup", "mismatch");
+        std::printf("%-9s %10.3f %10s %10s\n", "frustum", per_object, "x1.0", "-");
+
+        std::unique_ptr<bool[]> result(new bool[vertex_num]);
+        const auto detected = math::simd::detect();
+
+        for (const auto level : { math::simd_level::scalar, math::simd_level::sse2, math::simd_level::avx2 }) {
+            if (static_cast<int>(level) > static_cast<int>(detected) || !math::simd::set_level(level)) {
+                continue;
+            }
+
+            const auto ns = measure([&]() {
+                sink = sink + math::batch::cull(frustum, center.span(), extent.span(), radius, std::span<bool>(result.get(), vertex_num));
+            });
+
+            auto mismatch = 0;
+
+            for (auto i = 0; i < vertex_num; ++i) {
+                mismatch += (result[i] != static_cast<bool>(expected[i])) ? 1 : 0;
+            }
+
+            std::printf("%-9s %10.3f %9s%.1f %10d\n", get_name(level), ns, "x", per_object / ns, mismatch);
+        }
+
+        math::simd::set_level(detected);
+        std::printf("\n");
+    }
+}
+
+int main() {
+    run<double>("double");
+    run<float>("float");
+    run_intersect<double>("double");
+    run_intersect<float>("float");
+    run_inside<double>("double");
+    run_inside<float>("float");
+    run_cull<double>("double");
+    run_cull<float>("float");
+
+    return 0;
+}
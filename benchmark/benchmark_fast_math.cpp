@@ -0,0 +1,135 @@
+//!
+//! @file benchmark_fast_math.cpp
+//!
+//! @brief fast_math (近似の sin_cos / rsqrt) の計測
+//!        precise (標準ライブラリ) と fast の処理時間と、標準ライブラリに対する誤差を出力する
+//!
+//! @details
+//! g++ -std=c++20 -O2 -I../math benchmark_fast_math.cpp ../math/fast_math.cpp ../math/vector4.cpp ../math/matrix44.cpp ../math/utility.cpp ../math/simd.cpp -o benchmark_fast_math
+//!
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <tuple>
+#include <vector>
+#include "fast_math.h"
+#include "vector4.h"
+
+namespace {
+    constexpr auto sample_num = 4096;
+    constexpr auto repeat_num = 500;
+    // 割り込みなどの揺れを除くため、trial_num 回計測した最小値を使う
+    constexpr auto trial_num = 5;
+    constexpr auto error_sample_num = 2000000;
+    constexpr auto error_range = 10000.0; // 誤差を計測する角度(ラジアン)の範囲
+
+    volatile double sink = 0.0;
+
+    template <typename Function>
+    double measure(Function function) {
+        auto best = 0.0;
+
+        for (auto trial = 0; trial < trial_num; ++trial) {
+            const auto start = std::chrono::steady_clock::now();
+
+            for (auto r = 0; r < repeat_num; ++r) {
+                function();
+            }
+
+            const auto end = std::chrono::steady_clock::now();
+            const auto ns = std::chrono::duration<double, std::nano>(end - start).count();
+
+            best = (trial == 0) ? ns : std::min(best, ns);
+        }
+
+        return best / (static_cast<double>(repeat_num) * sample_num);
+    }
+
+    const char* get_name(const math::math_mode mode) {
+        return (mode == math::math_mode::fast) ? "fast" : "precise";
+    }
+
+    template <typename T>
+    void run(const char* type_name) {
+        std::vector<T> angles;
+        std::vector<math::basic_vector4<T>> vectors;
+
+        for (auto i = 0; i < sample_num; ++i) {
+            angles.emplace_back(static_cast<T>((i - sample_num / 2) * 0.01));
+            vectors.emplace_back(static_cast<T>(i % 17 + 1), static_cast<T>(i % 5 - 2), static_cast<T>(i % 11 - 5));
+        }
+
+        std::printf("[%s]\n%-8s %12s %12s %12s\n", type_name, "mode", "sincos ns", "rsqrt ns", "normalize ns");
+
+        for (const auto mode : { math::math_mode::precise, math::math_mode::fast }) {
+            const auto sin_cos = measure([&angles, mode]() {
+                T sum = 0;
+
+                for (const auto angle : angles) {
+                    const auto [sin, cos] = math::fast_math::sin_cos(angle, mode);
+
+                    sum += sin + cos;
+                }
+
+                sink = sink + sum;
+            });
+
+            const auto rsqrt = measure([&angles, mode]() {
+                T sum = 0;
+
+                for (const auto angle : angles) {
+                    sum += math::fast_math::rsqrt(std::abs(angle) + 1, mode);
+                }
+
+                sink = sink + sum;
+            });
+
+            const auto normalize = measure([&vectors, mode]() {
+                T sum = 0;
+
+                for (const auto& v : vectors) {
+                    sum += v.normalize(mode).get_x();
+                }
+
+                sink = sink + sum;
+            });
+
+            std::printf("%-8s %12.3f %12.3f %12.3f\n", get_name(mode), sin_cos, rsqrt, normalize);
+        }
+
+        // 標準ライブラリ(long double)に対する誤差
+        auto sin_cos_error = 0.0;
+        auto rsqrt_error = 0.0;
+        auto length_error = 0.0;
+
+        for (auto i = 0; i < error_sample_num; ++i) {
+            const auto angle = static_cast<T>(-error_range + 2.0 * error_range * i / error_sample_num);
+            const auto [sin, cos] = math::fast_math::sin_cos(angle, math::math_mode::fast);
+            const auto reference = static_cast<long double>(angle);
+
+            sin_cos_error = std::max(sin_cos_error, static_cast<double>(std::abs(sin - std::sin(reference))));
+            sin_cos_error = std::max(sin_cos_error, static_cast<double>(std::abs(cos - std::cos(reference))));
+
+            const auto value = static_cast<T>(1.0e-6 + 1.0e6 * i / error_sample_num);
+            const auto rsqrt = static_cast<long double>(math::fast_math::rsqrt(value, math::math_mode::fast));
+            const auto expected = 1.0L / std::sqrt(static_cast<long double>(value));
+
+            rsqrt_error = std::max(rsqrt_error, static_cast<double>(std::abs(rsqrt - expected) / expected));
+
+            const auto normal = vectors[i % sample_num].normalize(math::math_mode::fast);
+
+            length_error = std::max(length_error, std::abs(static_cast<double>(normal.length()) - 1.0));
+        }
+
+        std::printf("fast max error : sincos abs %.3e (|radian| <= %.0f), rsqrt rel %.3e, |normalize| - 1 %.3e\n\n",
+                    sin_cos_error, error_range, rsqrt_error, length_error);
+    }
+}
+
+int main() {
+    run<double>("double");
+    run<float>("float");
+
+    return 0;
+}
@@ -0,0 +1,544 @@
+//!
+//! @file benchmark_math.cpp
+//!
+//! @brief math/ の公開関数をまとめて計測して JSON で出力する
+//!        matrix44 / vector4 / batch / utility / random の各関数を
+//!        single (L1 に収まる件数を繰り返す) と batch (キャッシュに収まらない件数を 1 回ずつ) の 2 通りで計測する
+//!
+//! @details
+//! benchmark/CMakeLists.txt の benchmark_math ターゲット
+//! ./benchmark_math [出力ファイル] (省略時は標準出力に JSON を出す)
+//! 結果を保存しておいて、変更前後で ns_per_op を比較する
+//! checksum は決まった入力で動かした結果のハッシュで、MATH_DETERMINISTIC (benchmark_math_deterministic) では
+//! 最適化オプションや CPU が違っても同じ値になる(リプレイの再現性の確認用)
+//! 最後に quaternion::from_to を 0 ～ 180 度で確かめ、誤差が大きければ終了コード 1 を返す
+//!
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <span>
+#include <string>
+#include <tuple>
+#include <vector>
+#include "batch.h"
+#include "fast_math.h"
+#include "matrix44.h"
+#include "quaternion.h"
+#include "random.h"
+#include "simd.h"
+#include "utility.h"
+#include "vector4.h"
+
+namespace {
+    constexpr std::size_t single_num = 64;
+    constexpr std::size_t batch_num = 1 << 16;
+    constexpr auto single_repeat = 20000;
+    constexpr auto batch_repeat = 20;
+
+    // 最適化で処理が消えない様に結果を書き込む
+    volatile double sink = 0.0;
+
+    struct record {
+        std::string name;
+        std::string type;
+        std::string size;
+        std::size_t count;
+        double ns_per_op;
+    };
+
+    std::vector<record> records;
+
+    const char* get_name(const math::simd_level level) {
+        switch (level) {
+        case math::simd_level::avx2:
+            return "avx2";
+
+        case math::simd_level::sse2:
+            return "sse2";
+
+        case math::simd_level::scalar:
+        default:
+            return "scalar";
+        }
+    }
+
+    // function(件数) を repeat 回呼んで 1 件あたりの時間を返す
+    template <typename Function>
+    double measure(const std::size_t count, const int repeat, Function function) {
+        // 1 回目はキャッシュと分岐予測を温める
+        function(count);
+
+        const auto start = std::chrono::steady_clock::now();
+
+        for (auto r = 0; r < repeat; ++r) {
+            function(count);
+        }
+
+        const auto end = std::chrono::steady_clock::now();
+        const auto ns = std::chrono::duration<double, std::nano>(end - start).count();
+
+        return ns / (static_cast<double>(repeat) * count);
+    }
+
+    // 要素毎の処理を single / batch で計測する(function(i) の戻り値は合計して捨てる)
+    template <typename Function>
+    void run_case(const char* name, const char* type, Function function) {
+        const auto loop = [&function](const std::size_t count) {
+            double sum = 0.0;
+
+            for (std::size_t i = 0; i < count; ++i) {
+                sum += static_cast<double>(function(i));
+            }
+
+            sink = sink + sum;
+        };
+
+        const auto single = measure(single_num, single_repeat, loop);
+        const auto batch = measure(batch_num, batch_repeat, loop);
+
+        records.push_back({ name, type, "single", single_num, single });
+        records.push_back({ name, type, "batch", batch_num, batch });
+
+        std::fprintf(stderr, "%-40s %-7s %10.2f ns %10.2f ns\n", name, type, single, batch);
+    }
+
+    // 件数をまとめて受け取る処理を single / batch で計測する
+    template <typename Function>
+    void run_span_case(const char* name, const char* type, Function function) {
+        const auto single = measure(single_num, single_repeat, function);
+        const auto batch = measure(batch_num, batch_repeat, function);
+
+        records.push_back({ name, type, "single", single_num, single });
+        records.push_back({ name, type, "batch", batch_num, batch });
+
+        std::fprintf(stderr, "%-40s %-7s %10.2f ns %10.2f ns\n", name, type, single, batch);
+    }
+
+    template <typename T>
+    std::vector<math::basic_matrix44<T>> make_matrices() {
+        std::vector<math::basic_matrix44<T>> list;
+
+        for (std::size_t i = 0; i < batch_num; ++i) {
+            math::basic_matrix44<T> matrix;
+
+            matrix.scale(static_cast<T>(1.0 + (i % 97) * 0.01), 1, static_cast<T>(1.0 + (i % 89) * 0.02), true);
+            matrix.rotate_x(static_cast<T>(i * 0.7), false);
+            matrix.rotate_y(static_cast<T>(i * 1.3), false);
+            matrix.rotate_z(static_cast<T>(i * 0.3), false);
+            matrix = matrix + math::basic_vector4<T>(static_cast<T>(i % 100), static_cast<T>(i % 50), static_cast<T>(i % 30));
+
+            list.emplace_back(matrix);
+        }
+
+        return list;
+    }
+
+    template <typename T>
+    std::vector<math::basic_vector4<T>> make_vectors() {
+        std::vector<math::basic_vector4<T>> list;
+
+        for (std::size_t i = 0; i < batch_num; ++i) {
+            list.emplace_back(static_cast<T>(i % 17 + 1), static_cast<T>(i % 5) - 2, static_cast<T>(i % 11) - 5);
+        }
+
+        return list;
+    }
+
+    template <typename T>
+    void run_type(const char* type) {
+        using vector = math::basic_vector4<T>;
+        using matrix = math::basic_matrix44<T>;
+
+        const auto matrices = make_matrices<T>();
+        const auto vectors = make_vectors<T>();
+        const auto next = [](const std::size_t i) { return (i + 1) % batch_num; };
+
+        // vector4
+        run_case("vector4::operator+", type, [&](const std::size_t i) { return (vectors[i] + vectors[next(i)]).get_x(); });
+        run_case("vector4::add_scaled", type, [&](const std::size_t i) { return vectors[i].add_scaled(vectors[next(i)], 2).get_x(); });
+        run_case("vector4::dot", type, [&](const std::size_t i) { return vectors[i].dot(vectors[next(i)]); });
+        run_case("vector4::cross", type, [&](const std::size_t i) { return vectors[i].cross(vectors[next(i)]).get_x(); });
+        run_case("vector4::length", type, [&](const std::size_t i) { return vectors[i].length(); });
+        run_case("vector4::normalize(precise)", type, [&](const std::size_t i) { return vectors[i].normalize(math::math_mode::precise).get_x(); });
+        run_case("vector4::normalize(fast)", type, [&](const std::size_t i) { return vectors[i].normalize(math::math_mode::fast).get_x(); });
+        run_case("vector4::operator*(matrix44)", type, [&](const std::size_t i) { return (vectors[i] * matrices[i]).get_x(); });
+
+        // matrix44
+        run_case("matrix44::operator*", type, [&](const std::size_t i) { return (matrices[i] * matrices[next(i)]).get_value(3, 0); });
+        run_case("matrix44::multiply(a,b,c,d)", type, [&](const std::size_t i) {
+            return matrix::multiply(matrices[i], matrices[next(i)], matrices[i], matrices[next(i)]).get_value(3, 0);
+        });
+        run_case("matrix44::compose", type, [&](const std::size_t i) { return matrix::compose(vectors[i], matrices[i], vectors[next(i)]).get_value(3, 0); });
+        run_case("matrix44::get_transpose", type, [&](const std::size_t i) { return matrices[i].get_transpose().get_value(3, 0); });
+        run_case("matrix44::determinant", type, [&](const std::size_t i) { return matrices[i].determinant(); });
+        run_case("matrix44::get_inverse", type, [&](const std::size_t i) { return matrices[i].get_inverse().get_value(3, 0); });
+        run_case("matrix44::get_inverse_gauss_jordan", type, [&](const std::size_t i) { return matrices[i].get_inverse_gauss_jordan().get_value(3, 0); });
+        run_case("matrix44::affine_inverse", type, [&](const std::size_t i) { return matrices[i].affine_inverse().get_value(3, 0); });
+        run_case("matrix44::rotate_y", type, [&](const std::size_t i) {
+            auto m = matrices[i];
+
+            m.rotate_y(static_cast<T>(i % 360), false);
+
+            return m.get_value(0, 0);
+        });
+        run_case("matrix44::look_at", type, [&](const std::size_t i) {
+            matrix m;
+
+            m.look_at(vectors[i] * 10, vectors[next(i)], vector(0, 1, 0));
+
+            return m.get_value(3, 2);
+        });
+        run_case("matrix44::perspective", type, [&](const std::size_t i) {
+            matrix m;
+
+            m.perspective(static_cast<T>(0.5 + (i % 64) * 0.01), static_cast<T>(16.0 / 9.0), static_cast<T>(0.1), static_cast<T>(1000));
+
+            return m.get_value(0, 0);
+        });
+        run_case("matrix44::viewport", type, [&](const std::size_t i) {
+            matrix m;
+
+            m.viewport(static_cast<T>(1280 + i % 64), static_cast<T>(720));
+
+            return m.get_value(3, 0);
+        });
+
+        // batch (SoA の一括変換)
+        math::basic_soa_buffer<T> source;
+        math::basic_soa_buffer<T> result;
+
+        source.resize(batch_num);
+        result.resize(batch_num);
+
+        const auto source_span = source.span();
+
+        for (std::size_t i = 0; i < batch_num; ++i) {
+            source_span.x[i] = vectors[i].get_x();
+            source_span.y[i] = vectors[i].get_y();
+            source_span.z[i] = vectors[i].get_z();
+        }
+
+        const auto transform = [&](const bool point) {
+            return [&, point](const std::size_t count) {
+                const auto all_source = source.span();
+                const auto all_result = result.span();
+                const math::basic_soa_span<const T> part_source = { all_source.x.first(count), all_source.y.first(count), all_source.z.first(count) };
+                const math::basic_soa_span<T> part_result = { all_result.x.first(count), all_result.y.first(count), all_result.z.first(count) };
+
+                if (point) {
+                    math::batch::transform_point(matrices[0], part_source, part_result);
+                }
+                else {
+                    math::batch::transform_normal(matrices[0], part_source, part_result);
+                }
+
+                sink = sink + part_result.x[count - 1];
+            };
+        };
+
+        run_span_case("batch::transform_point", type, transform(true));
+        run_span_case("batch::transform_normal", type, transform(false));
+    }
+
+    // utility は double 版のみ
+    void run_utility() {
+        constexpr auto type = "double";
+
+        // y = 0 の平面上の四角形 と 平面を跨ぐ(半分程度は四角形の外を通る)線分
+        std::vector<std::array<math::vector4, 4>> quads;
+        std::vector<math::vector4> starts;
+        std::vector<math::vector4> ends;
+        std::vector<math::vector4> points;
+
+        for (std::size_t i = 0; i < batch_num; ++i) {
+            const auto size = 50.0 + (i % 13) * 10.0;
+            const auto center = math::vector4((i % 31) * 10.0, 0.0, (i % 29) * 10.0);
+            const auto offset = math::vector4(((i % 7) - 3.0) * size * 0.4, 0.0, ((i % 5) - 2.0) * size * 0.4);
+
+            quads.push_back({
+                center + math::vector4(-size, 0.0, -size), center + math::vector4(-size, 0.0, size),
+                center + math::vector4( size, 0.0, -size), center + math::vector4( size, 0.0, size)
+            });
+            starts.emplace_back(center + offset + math::vector4(0.0, 10.0 + (i % 3), 0.0));
+            ends.emplace_back(center + offset + math::vector4(0.0, -10.0 - (i % 4), 0.0));
+            points.emplace_back(center + offset);
+        }
+
+        run_case("utility::get_normal", type, [&](const std::size_t i) {
+            return math::utility::get_normal(quads[i][0], quads[i][1], quads[i][2]).get_y();
+        });
+        run_case("utility::inside_triangle_point", type, [&](const std::size_t i) {
+            return math::utility::inside_triangle_point(quads[i][0], quads[i][1], quads[i][2], points[i]) ? 1 : 0;
+        });
+        run_case("utility::collision_plane_line", type, [&](const std::size_t i) {
+            const auto plane = std::make_tuple(quads[i][0], math::vector4(0.0, 1.0, 0.0));
+            auto result = std::make_tuple(false, math::vector4());
+
+            return math::utility::collision_plane_line(plane, starts[i], ends[i], result) ? std::get<1>(result).get_x() : 0.0;
+        });
+        run_case("utility::collision_polygon_line", type, [&](const std::size_t i) {
+            const auto result = math::utility::collision_polygon_line(quads[i][0], quads[i][1], quads[i][2], quads[i][3], starts[i], ends[i]);
+
+            return std::get<0>(result) ? std::get<1>(result).get_x() : 0.0;
+        });
+        run_case("utility::collision_triangle_line", type, [&](const std::size_t i) {
+            const auto result = math::utility::collision_triangle_line(quads[i][0], quads[i][1], quads[i][2], starts[i], ends[i]);
+
+            return std::get<0>(result) ? std::get<1>(result).get_x() : 0.0;
+        });
+
+        // 1 本の線分と count 個の四角形 (1 個あたりの時間)
+        std::array<math::basic_soa_buffer<double>, 4> quad_points;
+
+        for (auto k = 0; k < 4; ++k) {
+            quad_points[k].resize(batch_num);
+
+            const auto span = quad_points[k].span();
+
+            for (std::size_t i = 0; i < batch_num; ++i) {
+                span.x[i] = quads[i][k].get_x();
+                span.y[i] = quads[i][k].get_y();
+                span.z[i] = quads[i][k].get_z();
+            }
+        }
+
+        // 1 つの三角形と count 個の点
+        math::basic_soa_buffer<double> inside_points;
+        std::unique_ptr<bool[]> inside_result(new bool[batch_num]);
+
+        inside_points.resize(batch_num);
+
+        for (std::size_t i = 0; i < batch_num; ++i) {
+            const auto span = inside_points.span();
+
+            span.x[i] = points[i].get_x();
+            span.y[i] = points[i].get_y();
+            span.z[i] = points[i].get_z();
+        }
+
+        run_span_case("batch::inside_triangle_point", type, [&](const std::size_t count) {
+            const auto span = inside_points.span();
+            const math::basic_soa_span<const double> part = { span.x.first(count), span.y.first(count), span.z.first(count) };
+
+            math::batch::inside_triangle_point(quads[0][0], quads[0][1], quads[0][2], part, std::span<bool>(inside_result.get(), count));
+            sink = sink + inside_result[count - 1];
+        });
+
+        run_span_case("batch::intersect_segment_quad", type, [&](const std::size_t count) {
+            const auto get_span = [&quad_points, count](const int k) -> math::basic_soa_span<const double> {
+                const auto span = quad_points[k].span();
+
+                return { span.x.first(count), span.y.first(count), span.z.first(count) };
+            };
+            const auto [hit, index, ratio] = math::batch::intersect_segment_quad(starts[0], ends[0], get_span(0), get_span(1), get_span(2), get_span(3));
+
+            sink = sink + (hit ? ratio + index : 0.0);
+        });
+    }
+
+    // 乱数 (変更前の get_random と同じ 呼び出し毎に分布を作る std::mt19937_64 と比較する)
+    void run_random() {
+        std::mt19937_64 mt_engine(1);
+
+        run_case("std::mt19937_64+uniform_int_distribution", "int", [&](const std::size_t i) {
+            std::uniform_int_distribution<int> distribution(0, static_cast<int>(i % 100) + 1);
+
+            return distribution(mt_engine);
+        });
+        run_case("utility::get_random", "int", [](const std::size_t i) { return math::utility::get_random(0, static_cast<int>(i % 100) + 1); });
+
+        std::vector<int> ints(batch_num);
+        std::vector<float> floats(batch_num);
+        math::basic_soa_buffer<float> unit_vectors;
+
+        unit_vectors.resize(batch_num);
+
+        run_span_case("random::fill", "int", [&](const std::size_t count) {
+            math::random::fill(std::span<int>(ints.data(), count), 0, 99);
+            sink = sink + ints[count - 1];
+        });
+        run_span_case("random::fill", "float", [&](const std::size_t count) {
+            math::random::fill(std::span<float>(floats.data(), count), -1.0f, 1.0f);
+            sink = sink + floats[count - 1];
+        });
+        run_span_case("random::fill_unit_vector", "float", [&](const std::size_t count) {
+            const auto span = unit_vectors.span();
+
+            math::random::fill_unit_vector(math::basic_soa_span<float>{ span.x.first(count), span.y.first(count), span.z.first(count) });
+            sink = sink + span.z[count - 1];
+        });
+    }
+
+    // リプレイの再現性 : 固定のシードで移動・姿勢・カメラの計算を進めて、結果のビット列の FNV-1a ハッシュを求める
+    std::uint64_t get_checksum() {
+        constexpr auto frame_num = 2000;
+
+        auto hash = 0xcbf29ce484222325ull;
+        const auto add = [&hash](const double value) {
+            std::uint64_t bits;
+
+            std::memcpy(&bits, &value, sizeof(bits));
+
+            for (auto i = 0; i < 8; ++i) {
+                hash = (hash ^ ((bits >> (i * 8)) & 0xff)) * 0x100000001b3ull;
+            }
+        };
+        const auto add_matrix = [&add](const math::matrix44& matrix) {
+            for (auto i = 0; i < math::row_max; ++i) {
+                for (auto j = 0; j < math::column_max; ++j) {
+                    add(matrix.get_value(i, j));
+                }
+            }
+        };
+
+        math::xoshiro256 engine(20240601);
+        const auto up = math::vector4(0.0, 1.0, 0.0);
+        auto position = math::vector4(0.0, 0.0, 0.0);
+        auto velocity = math::vector4(0.0, 0.0, 0.0);
+        auto posture = math::quaternion();
+
+        for (auto frame = 0; frame < frame_num; ++frame) {
+            // 乱数の入力でジャンプと移動
+            if (position.get_y() <= 0.0) {
+                velocity.set(math::random::get_real(engine, -3.0, 3.0), math::random::get_real(engine, 5.0, 20.0), math::random::get_real(engine, -3.0, 3.0));
+            }
+
+            velocity.add(0.0, -9.8 / 60.0, 0.0);
+            position = position.add_scaled(velocity, 1.0 / 60.0);
+
+            if (position.get_y() < 0.0) {
+                position.set(position.get_x(), 0.0, position.get_z());
+            }
+
+            // 進行方向へ姿勢を向ける
+            const auto forward = posture.rotate(math::vector4(0.0, 0.0, 1.0));
+            const auto target = math::quaternion::from_to(forward, velocity.normalize()) * posture;
+
+            posture = math::quaternion::slerp(posture, target, 0.1);
+            posture.normalized();
+
+            // ワールド行列とカメラ
+            math::matrix44 rotate;
+
+            rotate.rotate_y(frame * 1.7, true);
+            rotate.rotate_x(frame * 0.3, false);
+
+            const auto world = math::matrix44::compose(math::vector4(1.0, 2.0, 1.0), posture.to_matrix() * rotate, position);
+            math::matrix44 view;
+            math::matrix44 projection;
+
+            view.look_at(position + math::vector4(0.0, 5.0, -10.0), position, up);
+            projection.perspective(math::utility::degree_to_radian(60.0), 16.0 / 9.0, 0.1, 1000.0);
+
+            const auto clip = math::vector4(1.0, 1.0, 1.0) * world * view * projection;
+
+            add_matrix(world.get_inverse());
+            add_matrix(view.affine_inverse());
+            add(clip.get_x());
+            add(clip.get_y());
+            add(clip.get_z());
+            add(clip.get_w());
+            add(posture.get_w());
+        }
+
+        return hash;
+    }
+
+    // from_to(a, b) で a を回転して b になるかを 0 ～ 180 度で確かめる(最大誤差が tolerance 以下なら true)
+    template <typename T>
+    bool check_from_to(const char* type, const T tolerance) {
+        using vector = math::basic_vector4<T>;
+        using quaternion = math::basic_quaternion<T>;
+
+        const vector from_list[] = {
+            vector(0, 1, 0), vector(1, 0, 0), vector(0, 0, -1),
+            vector(static_cast<T>(0.3), static_cast<T>(0.8), static_cast<T>(-0.5)).normalize()
+        };
+        auto error = static_cast<T>(0);
+
+        for (const auto& from : from_list) {
+            // from に直交する単位ベクトルの方向へ回す
+            auto side = vector(0, 0, 1).cross(from);
+
+            if (side.length() < static_cast<T>(0.1)) {
+                side = vector(1, 0, 0).cross(from);
+            }
+
+            side.normalized();
+
+            for (auto degree = 0; degree <= 180; ++degree) {
+                const auto radian = static_cast<T>(math::utility::degree_to_radian(static_cast<double>(degree)));
+                const auto to = from * static_cast<T>(std::cos(radian)) + side * static_cast<T>(std::sin(radian));
+                const auto rotated = quaternion::from_to(from, to).rotate(from);
+
+                error = std::max(error, (rotated - to).length());
+            }
+        }
+
+        const auto ok = (error <= tolerance);
+
+        std::fprintf(stderr, "check quaternion::from_to (%s) max error %.3e %s\n", type, static_cast<double>(error), ok ? "ok" : "NG");
+
+        return ok;
+    }
+
+    void write_json(std::FILE* file, const std::uint64_t checksum) {
+        std::fprintf(file, "{\n");
+        std::fprintf(file, "  \"suite\": \"math\",\n");
+        std::fprintf(file, "  \"simd_level\": \"%s\",\n", get_name(math::simd::get_level()));
+        std::fprintf(file, "  \"math_mode\": \"%s\",\n", math::fast_math::get_mode() == math::math_mode::fast ? "fast" : "precise");
+        std::fprintf(file, "  \"deterministic\": %s,\n", math::fast_math::is_deterministic() ? "true" : "false");
+        std::fprintf(file, "  \"checksum\": \"%016llx\",\n", static_cast<unsigned long long>(checksum));
+        std::fprintf(file, "  \"results\": [\n");
+
+        for (std::size_t i = 0; i < records.size(); ++i) {
+            const auto& r = records[i];
+
+            std::fprintf(file, "    { \"name\": \"%s\", \"type\": \"%s\", \"size\": \"%s\", \"count\": %zu, \"ns_per_op\": %.3f }%s\n",
+                         r.name.c_str(), r.type.c_str(), r.size.c_str(), r.count, r.ns_per_op, (i + 1 < records.size()) ? "," : "");
+        }
+
+        std::fprintf(file, "  ]\n}\n");
+    }
+}
+
+int main(int argc, char* argv[]) {
+    // 表は標準エラー、JSON は標準出力かファイルに出す
+    std::fprintf(stderr, "%-40s %-7s %13s %13s\n", "name", "type", "single", "batch");
+
+    run_type<double>("double");
+    run_type<float>("float");
+    run_utility();
+    run_random();
+
+    const auto checked = check_from_to<double>("double", 1e-6) && check_from_to<float>("float", 1e-4f);
+
+    const auto checksum = get_checksum();
+
+    std::fprintf(stderr, "checksum %016llx (deterministic %s)\n", static_cast<unsigned long long>(checksum), math::fast_math::is_deterministic() ? "on" : "off");
+
+    if (argc < 2) {
+        write_json(stdout, checksum);
+
+        return checked ? 0 : 1;
+    }
+
+    auto* file = std::fopen(argv[1], "w");
+
+    if (file == nullptr) {
+        std::fprintf(stderr, "cannot open %s\n", argv[1]);
+
+        return 1;
+    }
+
+    write_json(file, checksum);
+    std::fclose(file);
+
+    return checked ? 0 : 1;
+}
@@ -0,0 +1,320 @@
+//!
+//! @file benchmark_matrix44.cpp
+//!
+//! @brief matrix44 / vector4 の SIMD カーネルの計測
+//!        命令セット毎に 行列 x 行列、ベクトル x 行列、逆行列 の処理時間を計測して scalar との比較を出力する
+//!        逆行列は 掃き出し法 / 余因子 / アフィン専用 の精度(M * M^-1 と単位行列の誤差)を命令セット毎に確かめ、
+//!        許容誤差を超えるか行列式が 0 の行列の扱いが違う場合は終了コード 1 を返す (run_benchmark で実行する)
+//!        連続した乗算は 演算子 と multiply / compose を比較する
+//!
+//! @details
+//! math/ は DX ライブラリに依存しないので Linux でもビルドできる
+//! g++ -std=c++20 -O2 -I../math benchmark_matrix44.cpp ../math/matrix44.cpp ../math/vector4.cpp ../math/utility.cpp ../math/simd.cpp ../math/fast_math.cpp -o benchmark_matrix44
+//!
+#include <array>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+#include "matrix44.h"
+#include "vector4.h"
+#include "simd.h"
+
+namespace {
+    constexpr auto sample_num = 1024;
+    constexpr auto repeat_num = 400;
+    // 割り込みなどの揺れを除くため、trial_num 回計測した最小値を使う
+    constexpr auto trial_num = 5;
+
+    // 最適化で処理が消えない様に結果を書き込む
+    volatile double sink = 0.0;
+
+    template <typename T>
+    std::vector<math::basic_matrix44<T>> make_matrices() {
+        std::vector<math::basic_matrix44<T>> list;
+
+        for (auto i = 0; i < sample_num; ++i) {
+            math::basic_matrix44<T> matrix;
+
+            matrix.scale(static_cast<T>(1.0 + i * 0.001), 1, static_cast<T>(1.0 + i * 0.002), true);
+            matrix.rotate_x(static_cast<T>(i * 0.7), false);
+            matrix.rotate_y(static_cast<T>(i * 1.3), false);
+            matrix.rotate_z(static_cast<T>(i * 0.3), false);
+            matrix = matrix + math::basic_vector4<T>(static_cast<T>(i), static_cast<T>(i * 2), static_cast<T>(i * 3));
+
+            list.emplace_back(matrix);
+        }
+
+        return list;
+    }
+
+    template <typename Function>
+    double measure(Function function) {
+        auto best = 0.0;
+
+        for (auto trial = 0; trial < trial_num; ++trial) {
+            const auto start = std::chrono::steady_clock::now();
+
+            for (auto r = 0; r < repeat_num; ++r) {
+                function();
+            }
+
+            const auto end = std::chrono::steady_clock::now();
+            const auto ns = std::chrono::duration<double, std::nano>(end - start).count();
+
+            best = (trial == 0) ? ns : std::min(best, ns);
+        }
+
+        return best / (static_cast<double>(repeat_num) * sample_num);
+    }
+
+    const char* get_name(const math::simd_level level) {
+        switch (level) {
+        case math::simd_level::avx2:
+            return "avx2";
+
+        case math::simd_level::sse2:
+            return "sse2";
+
+        case math::simd_level::scalar:
+        default:
+            return "scalar";
+        }
+    }
+
+    // M * M^-1 と単位行列の最大誤差
+    template <typename T>
+    double get_identity_error(const math::basic_matrix44<T>& matrix, const math::basic_matrix44<T>& inverse) {
+        const auto identity = matrix * inverse;
+        auto error = 0.0;
+
+        for (auto i = 0; i < math::row_max; ++i) {
+            for (auto j = 0; j < math::column_max; ++j) {
+                const auto expected = (i == j) ? 1.0 : 0.0;
+
+                error = std::max(error, std::abs(static_cast<double>(identity.get_value(i, j)) - expected));
+            }
+        }
+
+        return error;
+    }
+
+    // 逆行列の精度を命令セット毎に確かめる(M * M^-1 と単位行列の最大誤差が tolerance 以下なら true)
+    // 掃き出し法 (変更前の処理) との差と、行列式が 0 の行列の扱いも確かめる
+    template <typename T>
+    bool check_inverse(const std::vector<math::basic_matrix44<T>>& matrices, const double tolerance) {
+        const auto detected = math::simd::detect();
+        const std::array<math::simd_level, 3> levels = {
+            math::simd_level::scalar, math::simd_level::sse2, math::simd_level::avx2
+        };
+
+        // 対角成分が 0 の行列 (90 度回転) は軸選択なしの掃き出し法では破綻する
+        math::basic_matrix44<T> rotate_90;
+
+        rotate_90.rotate_x(90, true);
+        rotate_90.rotate_z(90, false);
+
+        const auto singular = math::basic_matrix44<T>(math::basic_matrix_array<T>{});
+        auto ok = true;
+
+        for (const auto level : levels) {
+            if (static_cast<int>(level) > static_cast<int>(detected) || !math::simd::set_level(level)) {
+                continue;
+            }
+
+            auto gauss_jordan_error = 0.0;
+            auto cofactor_error = 0.0;
+            auto affine_error = 0.0;
+            auto difference = 0.0;
+
+            for (const auto& matrix : matrices) {
+                const auto gauss_jordan = matrix.get_inverse_gauss_jordan();
+                const auto cofactor = matrix.get_inverse();
+
+                gauss_jordan_error = std::max(gauss_jordan_error, get_identity_error(matrix, gauss_jordan));
+                cofactor_error = std::max(cofactor_error, get_identity_error(matrix, cofactor));
+                affine_error = std::max(affine_error, get_identity_error(matrix, matrix.affine_inverse()));
+
+                for (auto i = 0; i < math::row_max; ++i) {
+                    for (auto j = 0; j < math::column_max; ++j) {
+                        difference = std::max(difference, std::abs(static_cast<double>(gauss_jordan.get_value(i, j) - cofactor.get_value(i, j))));
+                    }
+                }
+            }
+
+            const auto rotate_error = std::max({ get_identity_error(rotate_90, rotate_90.get_inverse_gauss_jordan()),
+                                                 get_identity_error(rotate_90, rotate_90.get_inverse()),
+                                                 get_identity_error(rotate_90, rotate_90.affine_inverse()) });
+
+            // 行列式が 0 なら try_get_inverse は false で、get_inverse は掃き出し法と同じく有限の値にならない
+            auto untouched = math::basic_matrix44<T>();
+            const auto singular_ok = !singular.try_get_inverse(untouched)
+                                     && get_identity_error(math::basic_matrix44<T>(), untouched) == 0
+                                     && !std::isfinite(static_cast<double>(singular.get_inverse().get_value(0, 0)));
+
+            const auto level_ok = std::max({ gauss_jordan_error, cofactor_error, affine_error, rotate_error }) <= tolerance && singular_ok;
+
+            std::printf("check %-6s max |M * M^-1 - I| : gauss %.3e, cofactor %.3e, affine %.3e (cofactor - gauss %.3e), rotate 90 %.3e, singular %s : %s\n",
+                        get_name(level), gauss_jordan_error, cofactor_error, affine_error, difference, rotate_error,
+                        singular_ok ? "ok" : "NG", level_ok ? "ok" : "NG");
+
+            ok = ok && level_ok;
+        }
+
+        math::simd::set_level(detected);
+        std::printf("\n");
+
+        return ok;
+    }
+
+    template <typename T>
+    bool run(const char* type_name, const double tolerance) {
+        const auto matrices = make_matrices<T>();
+        const auto vectors = std::vector<math::basic_vector4<T>>(sample_num, math::basic_vector4<T>(1, 2, 3));
+        const auto detected = math::simd::detect();
+        const std::array<math::simd_level, 3> levels = {
+            math::simd_level::scalar, math::simd_level::sse2, math::simd_level::avx2
+        };
+
+        std::array<double, 5> scalar_ns = { 0.0, 0.0, 0.0, 0.0, 0.0 };
+
+        std::printf("[%s]\n%-8s %14s %14s %14s %14s %14s\n", type_name,
+                    "level", "mat*mat ns", "vec*mat ns", "gauss ns", "cofactor ns", "affine ns");
+
+        for (const auto level : levels) {
+            if (static_cast<int>(level) > static_cast<int>(detected) || !math::simd::set_level(level)) {
+                continue;
+            }
+
+            const auto multiply = measure([&matrices]() {
+                auto m = matrices[0];
+
+                for (auto i = 1; i < sample_num; ++i) {
+                    m = matrices[i] * m.get_rotate();
+                }
+
+                sink = sink + m.get_value(0, 0);
+            });
+
+            const auto transform = measure([&matrices, &vectors]() {
+                T sum = 0;
+
+                for (auto i = 0; i < sample_num; ++i) {
+                    sum += (vectors[i] * matrices[i]).get_x();
+                }
+
+                sink = sink + sum;
+            });
+
+            const auto gauss_jordan = measure([&matrices]() {
+                T sum = 0;
+
+                for (auto i = 0; i < sample_num; ++i) {
+                    sum += matrices[i].get_inverse_gauss_jordan().get_value(3, 0);
+                }
+
+                sink = sink + sum;
+            });
+
+            const auto cofactor = measure([&matrices]() {
+                T sum = 0;
+
+                for (auto i = 0; i < sample_num; ++i) {
+                    sum += matrices[i].get_inverse().get_value(3, 0);
+                }
+
+                sink = sink + sum;
+            });
+
+            const auto affine = measure([&matrices]() {
+                T sum = 0;
+
+                for (auto i = 0; i < sample_num; ++i) {
+                    sum += matrices[i].affine_inverse().get_value(3, 0);
+                }
+
+                sink = sink + sum;
+            });
+
+            const std::array<double, 5> ns = { multiply, transform, gauss_jordan, cofactor, affine };
+
+            if (level == math::simd_level::scalar) {
+                scalar_ns = ns;
+            }
+
+            std::printf("%-8s", get_name(level));
+
+            for (auto i = 0; i < static_cast<int>(ns.size()); ++i) {
+                std::printf(" %8.2f (x%3.1f)", ns[i], scalar_ns[i] / ns[i]);
+            }
+
+            std::printf("\n");
+        }
+
+        math::simd::set_level(detected);
+
+        // 連続した乗算 : 演算子 と 途中の行列を作らない multiply / compose
+        const auto chain_operator = measure([&matrices]() {
+            T sum = 0;
+
+            for (auto i = 3; i < sample_num; ++i) {
+                sum += (matrices[i] * matrices[i - 1] * matrices[i - 2] * matrices[i - 3]).get_value(3, 0);
+            }
+
+            sink = sink + sum;
+        });
+
+        const auto chain_multiply = measure([&matrices]() {
+            T sum = 0;
+
+            for (auto i = 3; i < sample_num; ++i) {
+                sum += math::basic_matrix44<T>::multiply(matrices[i], matrices[i - 1], matrices[i - 2], matrices[i - 3]).get_value(3, 0);
+            }
+
+            sink = sink + sum;
+        });
+
+        const auto scale = math::basic_vector4<T>(2, 3, 4);
+        const auto transfer = math::basic_vector4<T>(10, 20, 30);
+
+        const auto trs_operator = measure([&matrices, &scale, &transfer]() {
+            T sum = 0;
+
+            for (const auto& rotate : matrices) {
+                math::basic_matrix44<T> scale_matrix;
+                math::basic_matrix44<T> transfer_matrix;
+
+                scale_matrix.scale(scale.get_x(), scale.get_y(), scale.get_z(), true);
+                transfer_matrix.transfer(transfer.get_x(), transfer.get_y(), transfer.get_z(), true);
+
+                sum += (scale_matrix * rotate * transfer_matrix).get_value(3, 0);
+            }
+
+            sink = sink + sum;
+        });
+
+        const auto trs_compose = measure([&matrices, &scale, &transfer]() {
+            T sum = 0;
+
+            for (const auto& rotate : matrices) {
+                sum += math::basic_matrix44<T>::compose(scale, rotate, transfer).get_value(3, 0);
+            }
+
+            sink = sink + sum;
+        });
+
+        std::printf("a*b*c*d : operator %.2f ns, multiply %.2f ns / S*R*T : operator %.2f ns, compose %.2f ns\n",
+                    chain_operator, chain_multiply, trs_operator, trs_compose);
+
+        return check_inverse(matrices, tolerance);
+    }
+}
+
+int main() {
+    // 許容誤差は平行移動が 3000 程度の行列での M * M^-1 と単位行列の差 (double 1e-12、float 5e-4 程度) に余裕を持たせた値
+    const auto checked_double = run<double>("double", 1e-9);
+    const auto checked_float = run<float>("float", 1e-2);
+
+    return (checked_double && checked_float) ? 0 : 1;
+}
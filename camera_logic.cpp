@@ -1,8 +1,8 @@
 //!
 //! @file camera_logic.cpp
 //!
-//! @brief 3D main_world.cpp p̃J(camera_base class)̎
-//!           camera ̈ړƃLN^[Ƃ̃RW
+//! @brief 3D main_world.cpp 用のカメラ(camera_base class)処理の実装
+//!           camera の移動とキャラクターとのコリジョンを処理
 //!
 #include "DxLib.h"
 #include "camera_logic.h"
@@ -11,7 +11,7 @@
 
 namespace {
     constexpr auto DEGREE_TO_RADIAN = DX_PI_F / 180.0f;
-    // JRW
+    // カメラコリジョン情報
     constexpr auto CAMERA_MOVEMENT = 5.0;
     constexpr auto CAMERA_ROTATION = 2.0;
     constexpr auto CAMERA_SPHERE_RADIUS = 100.0;
@@ -23,7 +23,7 @@ namespace {
 #endif
         auto camera_position = camera->get_position();
 
-        // J̃^[Qbgƃ|WVZo
+        // カメラのターゲットとポジションを算出
 #if defined(_AMG_MATH)
         auto model_moved = model_position - model_last_position;
 
@@ -57,67 +57,67 @@ namespace {
 
         if (movement != 0.0) {
 #if defined(_AMG_MATH)
-            // JʒuJ^[Qbgւ̃xNg쐬
+            // カメラ位置からカメラターゲットへのベクトルを作成
             auto camera_direction = camera_target - camera_position;
 
-            // Pʉ
+            // 単位化する
             camera_direction.normalized();
 
-            // ړʂ|ZĈړ̃xNg쐬āAJ̈ʒuxNgɑ
-            auto camera_moved_position = camera_position + (camera_direction * movement);
+            // 移動量を掛け算して移動分のベクトルを作成して、カメラの位置ベクトルに足す
+            auto camera_moved_position = camera_position.add_scaled(camera_direction, movement);
 
-            // fƃJ̋œ蔻s
+            // モデルとカメラの球で当たり判定を行う
 
-            // JƃfԃxNg쐬
+            // カメラとモデルを結ぶベクトルを作成
             auto model_to_camera = camera_moved_position - camera_target;
 
-            // xNg̒ Sqrt sȂl
+            // ベクトルの長さの Sqrt を行わない値
             auto x = model_to_camera.get_x();
             auto y = model_to_camera.get_y();
             auto z = model_to_camera.get_z();
             auto check_size = x * x + y * y + z * z;
 
-            // xNg̒A蔻肽m̔a菬ΏՓ˂Ă
-            // (ۂ Sqrt sȂlŃ`FbN)
+            // ベクトルの長さが、当たり判定を取りたい球同士の半径より小さければ衝突している
+            // (実際は Sqrt を行わない値でチェック)
             auto collision_rasius = model_radius + CAMERA_SPHERE_RADIUS;
 
             if (check_size < collision_rasius * collision_rasius) {
-                // Փ˂Ăꍇ́AmȏՓˈʒu֍W߂
-                camera_position = (camera_direction * -collision_rasius) + camera_target;
+                // 衝突している場合は、正確な衝突位置へ座標を戻す
+                camera_position = camera_target.add_scaled(camera_direction, -collision_rasius);
             } else {
-                // Փ˂ĂȂΈړ
+                // 衝突していなければ移動させる
                 camera_position = camera_moved_position;
             }
 #else
-            // JʒuJ^[Qbgւ̃xNg쐬
+            // カメラ位置からカメラターゲットへのベクトルを作成
             VECTOR camera_direction = VSub(camera_target, camera_position);
 
-            // Pʉ
+            // 単位化する
             VECTOR dir = VNorm(camera_direction);
 
-            // ړʂ|ZĈړ̃xNg쐬āAJ̈ʒuxNgɑ
+            // 移動量を掛け算して移動分のベクトルを作成して、カメラの位置ベクトルに足す
             VECTOR camera_moved_position = VAdd(camera_position, VScale(dir, movement));
 
-            // fƃJ̋œ蔻s
+            // モデルとカメラの球で当たり判定を行う
 
-            // JƃfԃxNg쐬
+            // カメラとモデルを結ぶベクトルを作成
             VECTOR model_to_camera = VSub(camera_moved_position, camera_target);
 
-            // xNg̒ Sqrt sȂl
+            // ベクトルの長さの Sqrt を行わない値
             auto x = model_to_camera.x;
             auto y = model_to_camera.y;
             auto z = model_to_camera.z;
             auto check_size = x * x + y * y + z * z;
 
-            // xNg̒A蔻肽m̔a菬ΏՓ˂Ă
-            // (ۂ Sqrt sȂlŃ`FbN)
+            // ベクトルの長さが、当たり判定を取りたい球同士の半径より小さければ衝突している
+            // (実際は Sqrt を行わない値でチェック)
             auto collision_rasius = model_radius + CAMERA_SPHERE_RADIUS;
 
             if (check_size < collision_rasius * collision_rasius) {
-                // Փ˂Ăꍇ́AmȏՓˈʒu֍W߂
+                // 衝突している場合は、正確な衝突位置へ座標を戻す
                 camera_position = VAdd(VScale(dir, -collision_rasius), camera_target);
             } else {
-                // Փ˂ĂȂΈړ
+                // 衝突していなければ移動させる
                 camera_position = camera_moved_position;
             }
 #endif
@@ -128,24 +128,24 @@ namespace {
 
         if (angle != 0.0) {
 #if defined(_AMG_MATH)
-            // Ỷ]lx(fBO[)Ŏw肵čsŎ擾
+            // Y軸の回転値を度(ディグリー)で指定して行列で取得する
             auto camera_y_matrix = math::matrix44();
 
             camera_y_matrix.rotate_y(angle, true);
 
-            // fJւ̃xNg
+            // モデルからカメラへのベクトル
             auto model_to_camera = camera_position - model_position;
 
-            // fJւ̃xNg]āǍɃfʒu֖߂
+            // モデルからカメラへのベクトルを回転させて、その後にモデル位置へ戻す
             camera_position = (model_to_camera * camera_y_matrix) + model_position;
 #else
-            // Ỷ]lx(fBO[)Ŏw肵čsŎ擾
+            // Y軸の回転値を度(ディグリー)で指定して行列で取得する
             MATRIX camera_y_matrix = MGetRotY(angle * DEGREE_TO_RADIAN);
 
-            // fJւ̃xNg
+            // モデルからカメラへのベクトル
             VECTOR model_to_camera = VSub(camera_position, model_position);
 
-            // fJւ̃xNg]āǍɃfʒu֖߂
+            // モデルからカメラへのベクトルを回転させて、その後にモデル位置へ戻す
             camera_position = VAdd(VTransform(model_to_camera, camera_y_matrix), model_position);
 #endif
 
@@ -176,7 +176,7 @@ namespace {
 }
 
 std::optional<std::shared_ptr<world::camera_base>> camera_initialize(const int screen_width, const int screen_height, const std::shared_ptr<mv1::player>& player) {
-    // J
+    // カメラ
     auto camera = std::make_shared<world::camera_base>(screen_width, screen_height);
 
     if (!camera_initialize(camera, player)) {
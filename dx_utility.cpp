@@ -1,18 +1,24 @@
+#include <cstring>
 #include "DxLib.h"
 #include "dx_utility.h"
 #include "vector4.h"
 #include "matrix44.h"
 #include <utility>
 
-VECTOR ToDX(math::vector4& vector) {
+// 先頭の x, y, z が VECTOR、行優先の float[16] が MATRIX と一致する
+static_assert(sizeof(VECTOR) == sizeof(float) * 3);
+static_assert(sizeof(MATRIX) == sizeof(math::basic_matrix_array<float>));
+static_assert(sizeof(MATRIX) == sizeof(math::matrix44f));
+
+VECTOR ToDX(const math::vector4& vector) {
     return VGet(static_cast<float>(vector.get_x()), static_cast<float>(vector.get_y()), static_cast<float>(vector.get_z()));
 }
 
-math::vector4 ToMath(VECTOR& vector) {
+math::vector4 ToMath(const VECTOR& vector) {
     return math::vector4(static_cast<double>(vector.x), static_cast<double>(vector.y), static_cast<double>(vector.z));
 }
 
-MATRIX ToDX(math::matrix44& matrix) {
+MATRIX ToDX(const math::matrix44& matrix) {
     MATRIX ret;
 
     for (auto i = 0; i < math::row_max; ++i) {
@@ -24,7 +30,7 @@ MATRIX ToDX(math::matrix44& matrix) {
     return ret;
 }
 
-math::matrix44 ToMath(MATRIX& matrix) {
+math::matrix44 ToMath(const MATRIX& matrix) {
     math::matrix44 ret;
 
     for (auto i = 0; i < math::row_max; ++i) {
@@ -34,4 +40,24 @@ math::matrix44 ToMath(MATRIX& matrix) {
     }
 
     return ret;
-}
\ No newline at end of file
+}
+
+const VECTOR& ToDX(const math::vector4f& vector) {
+    return *reinterpret_cast<const VECTOR*>(vector.data());
+}
+
+const MATRIX& ToDX(const math::matrix44f& matrix) {
+    return *reinterpret_cast<const MATRIX*>(matrix.data());
+}
+
+math::vector4f ToMathF(const VECTOR& vector) {
+    return math::vector4f(vector.x, vector.y, vector.z);
+}
+
+math::matrix44f ToMathF(const MATRIX& matrix) {
+    math::matrix44f ret;
+
+    std::memcpy(ret.data(), matrix.m, sizeof(matrix.m));
+
+    return ret;
+}
@@ -1,17 +1,22 @@
 #pragma once
+#include "math_fwd.h"
 
 struct tagVECTOR;
 struct tagMATRIX;
 
-namespace math {
-    class vector4;
-    class matrix44;
-}
+VECTOR ToDX(const math::vector4& vector);
 
-VECTOR ToDX(math::vector4& vector);
+math::vector4 ToMath(const VECTOR& vector);
 
-math::vector4 ToMath(VECTOR& vector);
+MATRIX ToDX(const math::matrix44& matrix);
 
-MATRIX ToDX(math::matrix44& matrix);
+math::matrix44 ToMath(const MATRIX& matrix);
 
-math::matrix44 ToMath(MATRIX& matrix);
+// float 版は VECTOR / MATRIX とメモリ配置が同じなので変換せずにそのまま参照する
+const VECTOR& ToDX(const math::vector4f& vector);
+
+const MATRIX& ToDX(const math::matrix44f& matrix);
+
+math::vector4f ToMathF(const VECTOR& vector);
+
+math::matrix44f ToMathF(const MATRIX& matrix);
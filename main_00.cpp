@@ -1,7 +1,7 @@
 //!
 //! @file main_00.cpp
 //!
-//! @brief 3D fǂݍ݁AŒ̕\sTv
+//! @brief 3D モデルを読み込み、最低限の表示を行うサンプル
 //!
 #include "DxLib.h"
 
@@ -32,7 +32,7 @@ int CALLBACK WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance,
         return -1;
     }
 
-    // 3D f̓ǂݍ
+    // 3D モデルの読み込み
     auto handle = MV1LoadModel(MODEL_FILE);
 
     if (handle == -1) {
@@ -40,11 +40,11 @@ int CALLBACK WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance,
         return -1;
     }
 
-    // s 1 ǉ
+    // 並行光源を 1 つ追加する
     VECTOR light_dir = VGet(1.0f, 0.0f, -0.1f);
     auto light_handle = CreateDirLightHandle(light_dir);
 
-    // J
+    // カメラ情報
     VECTOR camera_position = VGet(-400.0f, 250.0f, -150.0f);
     VECTOR camera_target = VGet(0.0f, 0.0f, 0.0f);
     VECTOR camera_up = VGet(0.0f, 1.0f, 0.0f);
@@ -56,21 +56,21 @@ int CALLBACK WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance,
             break;
         }
 
-        // JZbg
+        // カメラ情報をセット
         SetCameraPositionAndTargetAndUpVec(camera_position, camera_target, camera_up);
 
         ClearDrawScreen();
 
-        // 3D f̕\
+        // 3D モデルの表示
         MV1DrawModel(handle);
 
         ScreenFlip();
     }
 
-    // 쐬̔j
+    // 作成した光源の破棄
     DeleteLightHandle(light_handle);
 
-    // ǂݍ 3D f̔j
+    // 読み込んだ 3D モデルの破棄
     MV1DeleteModel(handle);
 
     DxLib_End();
@@ -1,7 +1,7 @@
 //!
 //! @file main_01.cpp
 //!
-//! @brief 3D fǂݍ݁AŒ̕\sTv(+Jړ)
+//! @brief 3D モデルを読み込み、最低限の表示を行うサンプル(+カメラ移動)
 //!
 #include "DxLib.h"
 
@@ -32,7 +32,7 @@ int CALLBACK WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance,
         return -1;
     }
 
-    // 3D f̓ǂݍ
+    // 3D モデルの読み込み
     auto handle = MV1LoadModel(MODEL_FILE);
 
     if (handle == -1) {
@@ -40,11 +40,11 @@ int CALLBACK WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance,
         return -1;
     }
 
-    // s 1 ǉ
+    // 並行光源を 1 つ追加する
     VECTOR light_dir = VGet(1.0f, 0.0f, -0.1f);
     auto light_handle = CreateDirLightHandle(light_dir);
 
-    // J
+    // カメラ情報
     VECTOR camera_position = VGet(-400.0f, 250.0f, -150.0f);
     VECTOR camera_target = VGet(0.0f, 0.0f, 0.0f);
     VECTOR camera_up = VGet(0.0f, 1.0f, 0.0f);
@@ -60,7 +60,7 @@ int CALLBACK WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance,
         }
 
         // ==========================================
-        // JGɓĂ݂
+        // カメラを雑に動かしてみる
         if (1 == CheckHitKey(KEY_INPUT_UP)) {
             camera_position.y += 1.0f;
         }
@@ -75,12 +75,12 @@ int CALLBACK WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance,
         }
         // ==========================================
 
-        // JZbg
+        // カメラ情報をセット
         SetCameraPositionAndTargetAndUpVec(camera_position, camera_target, camera_up);
 
         ClearDrawScreen();
 
-        // 3D f̕\
+        // 3D モデルの表示
         MV1DrawModel(handle);
 
         DrawFormatString(0, 0, string_color, string_camera_position, camera_position.x, camera_position.y, camera_position.z);
@@ -88,10 +88,10 @@ int CALLBACK WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance,
         ScreenFlip();
     }
 
-    // 쐬̔j
+    // 作成した光源の破棄
     DeleteLightHandle(light_handle);
 
-    // ǂݍ 3D f̔j
+    // 読み込んだ 3D モデルの破棄
     MV1DeleteModel(handle);
 
     DxLib_End();
@@ -1,7 +1,7 @@
 //!
 //! @file main_04.cpp
 //!
-//! @brief 3D fǂݍ݁AŒ̕\sTv(+sł̃f]+s̃XP[ω)
+//! @brief 3D モデルを読み込み、最低限の表示を行うサンプル(+行列でのモデル回転+行列のスケール変化)
 //!
 #include "DxLib.h"
 #include <cmath>
@@ -34,7 +34,7 @@ int CALLBACK WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance,
         return -1;
     }
 
-    // 3D f̓ǂݍ
+    // 3D モデルの読み込み
     auto handle = MV1LoadModel(MODEL_FILE);
 
     if (handle == -1) {
@@ -42,11 +42,11 @@ int CALLBACK WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance,
         return -1;
     }
 
-    // s 1 ǉ
+    // 並行光源を 1 つ追加する
     VECTOR light_dir = VGet(1.0f, 0.0f, -0.1f);
     auto light_handle = CreateDirLightHandle(light_dir);
 
-    // J
+    // カメラ情報
     VECTOR camera_position = VGet(-400.0f, 250.0f, -150.0f);
     VECTOR camera_target = VGet(0.0f, 0.0f, 0.0f);
     VECTOR camera_up = VGet(0.0f, 1.0f, 0.0f);
@@ -60,39 +60,39 @@ int CALLBACK WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance,
             break;
         }
 
-        // f Y ŉ]Ă݂
-        model_y_angle += 0.5f; // 0.5 xÂZ
+        // モデルを Y 軸で回転させてみる
+        model_y_angle += 0.5f; // 0.5 度づつ加算
 
-        // x -> WAɕϊ
+        // 度 -> ラジアンに変換
         auto model_y_radian = model_y_angle * DEGREE_TO_RADIAN;
 
-        // Ỷ]lWAŎw肵čsŎ擾
+        // Y軸の回転値をラジアンで指定して行列で取得する
         MATRIX model_y_matrix = MGetRotY(model_y_radian);
 
         // ========================================================
-        // XP[ǉĂ݂(f Ypx𗬗p)
+        // スケールも追加してみる(モデルの Y軸角度を流用)
         auto model_scale = std::abs(std::cos(model_y_radian));
         MATRIX model_matritx = MScale(model_y_matrix, model_scale);
         // ========================================================
 
-        // fɑ΂Ă̏sŃZbg
+        // モデルに対しての情報を行列でセットする
         MV1SetMatrix(handle, model_matritx);
 
-        // JZbg
+        // カメラ情報をセット
         SetCameraPositionAndTargetAndUpVec(camera_position, camera_target, camera_up);
 
         ClearDrawScreen();
 
-        // 3D f̕\
+        // 3D モデルの表示
         MV1DrawModel(handle);
 
         ScreenFlip();
     }
 
-    // 쐬̔j
+    // 作成した光源の破棄
     DeleteLightHandle(light_handle);
 
-    // ǂݍ 3D f̔j
+    // 読み込んだ 3D モデルの破棄
     MV1DeleteModel(handle);
 
     DxLib_End();
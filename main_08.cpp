@@ -1,7 +1,7 @@
 //!
 //! @file main_08.cpp
 //!
-//! @brief 3D fǂݍ݁AŒ̕\sTv(+sł̃f]ƃXP[ƈړ+Jړ)
+//! @brief 3D モデルを読み込み、最低限の表示を行うサンプル(+行列でのモデル回転とスケールと移動+カメラ移動)
 //!
 #include "DxLib.h"
 #include <cmath>
@@ -34,7 +34,7 @@ int CALLBACK WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance,
         return -1;
     }
 
-    // 3D f̓ǂݍ
+    // 3D モデルの読み込み
     auto handle = MV1LoadModel(MODEL_FILE);
 
     if (handle == -1) {
@@ -42,11 +42,11 @@ int CALLBACK WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance,
         return -1;
     }
 
-    // s 1 ǉ
+    // 並行光源を 1 つ追加する
     VECTOR light_dir = VGet(1.0f, 0.0f, -0.1f);
     auto light_handle = CreateDirLightHandle(light_dir);
 
-    // J
+    // カメラ情報
     VECTOR camera_position = VGet(-400.0f, 250.0f, -150.0f);
     VECTOR camera_target = VGet(0.0f, 0.0f, 0.0f);
     VECTOR camera_up = VGet(0.0f, 1.0f, 0.0f);
@@ -63,43 +63,43 @@ int CALLBACK WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance,
             break;
         }
 
-        // f Yŉ]Ă݂
-        model_y_angle += 0.5f; // 0.5 xÂZ
+        // モデルを Y軸で回転させてみる
+        model_y_angle += 0.5f; // 0.5 度づつ加算
 
-        // x -> WAɕϊ
+        // 度 -> ラジアンに変換
         auto model_y_radian = model_y_angle * DEGREE_TO_RADIAN;
 
-        // Ỷ]lWAŎw肵čsŎ擾
+        // Y軸の回転値をラジアンで指定して行列で取得する
         MATRIX model_y_matrix = MGetRotY(model_y_radian);
 
-        // XP[ǉĂ݂(f Y px𗬗p)
+        // スケールも追加してみる(モデルの Y 軸角度を流用)
         auto model_scale = std::abs(std::cos(model_y_radian));
 
-        // XYZ ̊eɑ΂ẴXP[lxNgŎw
+        // XYZ の各軸に対してのスケール値をベクトルで指定
         VECTOR model_scale_vector = VGet(model_scale, model_scale, model_scale);
 
-        // XP[̍s擾
+        // スケールの行列を取得
         MATRIX model_scale_matrix = MGetScale(model_scale_vector);
 
-        // Z̈ړǉĂ݂(f Ypx𗬗p)
+        // Z方向の移動も追加してみる(モデルの Y軸角度を流用)
         auto model_z_position = 300.0f * std::sin(model_y_radian);
 
-        // f XYZ (ʒu)̃xNg
+        // モデルの XYZ (位置)のベクトル
         VECTOR model_position_vector = VGet(0.0f, 0.0f, model_z_position);
 
-        // sړ̍s擾
+        // 並行移動の行列を取得
         MATRIX model_position_matrix = MGetTranslate(model_position_vector);
 
-        // XP[̍s Y]̍s
+        // スケールの行列と Y軸回転の行列を合成する
         MATRIX model_matritx = MMult(model_scale_matrix, model_y_matrix);
 
-        // X Z̈ړ̍sǉ
+        // 更に Z方向の移動の行列を追加する
         model_matritx = MMult(model_matritx, model_position_matrix);
 
-        // fɑ΂Ă̏sŃZbg
+        // モデルに対しての情報を行列でセットする
         MV1SetMatrix(handle, model_matritx);
 
-        // JGɓĂ݂
+        // カメラを雑に動かしてみる
         if (1 == CheckHitKey(KEY_INPUT_UP)) {
             camera_position.y += 1.0f;
         } else if (1 == CheckHitKey(KEY_INPUT_DOWN)) {
@@ -110,12 +110,12 @@ int CALLBACK WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance,
             camera_position.x += 1.0f;
         }
 
-        // JZbg
+        // カメラ情報をセット
         SetCameraPositionAndTargetAndUpVec(camera_position, camera_target, camera_up);
 
         ClearDrawScreen();
 
-        // 3D f̕\
+        // 3D モデルの表示
         MV1DrawModel(handle);
 
         DrawFormatString(0, 0, string_color, string_camera_position, camera_position.x, camera_position.y, camera_position.z);
@@ -124,10 +124,10 @@ int CALLBACK WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance,
         ScreenFlip();
     }
 
-    // 쐬̔j
+    // 作成した光源の破棄
     DeleteLightHandle(light_handle);
 
-    // ǂݍ 3D f̔j
+    // 読み込んだ 3D モデルの破棄
     MV1DeleteModel(handle);
 
     DxLib_End();
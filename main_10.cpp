@@ -1,7 +1,7 @@
 //!
 //! @file main_10.cpp
 //!
-//! @brief 3D fǂݍ݁AŒ̕\sTv(+Jړ+JšvZ+vWFNVs)
+//! @brief 3D モデルを読み込み、最低限の表示を行うサンプル(+カメラ移動+カメラ行列の計算+プロジェクション行列)
 //!
 #include "DxLib.h"
 #include <cmath>
@@ -37,7 +37,7 @@ int CALLBACK WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance,
         return -1;
     }
 
-    // 3D f̓ǂݍ
+    // 3D モデルの読み込み
     auto handle = MV1LoadModel(MODEL_FILE);
 
     if (handle == -1) {
@@ -45,16 +45,16 @@ int CALLBACK WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance,
         return -1;
     }
 
-    // s 1 ǉ
+    // 並行光源を 1 つ追加する
     VECTOR light_dir = VGet(1.0f, 0.0f, -0.1f);
     auto light_handle = CreateDirLightHandle(light_dir);
 
-    // J
+    // カメラ情報
     VECTOR camera_position = VGet(-400.0f, 250.0f, -150.0f);
     VECTOR camera_target = VGet(0.0f, 0.0f, 0.0f);
     VECTOR camera_up = VGet(0.0f, 1.0f, 0.0f);
 
-    // p[XyNeBuɕKvȏ
+    // パースペクティブ処理に必要な情報
     auto camera_near = 1.0f;
     auto camera_far = 1000.f;
     auto fov = 60.0f * DEGREE_TO_RADIAN;
@@ -69,7 +69,7 @@ int CALLBACK WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance,
             break;
         }
 
-        // JGɓĂ݂
+        // カメラを雑に動かしてみる
         if (1 == CheckHitKey(KEY_INPUT_UP)) {
             camera_position.y += 1.0f;
         } else if (1 == CheckHitKey(KEY_INPUT_DOWN)) {
@@ -80,7 +80,7 @@ int CALLBACK WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance,
             camera_position.x += 1.0f;
         }
 
-        // JZbg
+        // カメラ情報をセット
         //SetCameraPositionAndTargetAndUpVec(camera_position, camera_target, camera_up);
         MATRIX camera_matrix = GetCameraViewMatrix(camera_position, camera_target, camera_up);
         SetCameraViewMatrix(camera_matrix);
@@ -92,7 +92,7 @@ int CALLBACK WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance,
 
         ClearDrawScreen();
 
-        // 3D f̕\
+        // 3D モデルの表示
         MV1DrawModel(handle);
 
         DrawFormatString(0, 0, string_color, string_camera_position, camera_position.x, camera_position.y, camera_position.z);
@@ -100,10 +100,10 @@ int CALLBACK WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance,
         ScreenFlip();
     }
 
-    // 쐬̔j
+    // 作成した光源の破棄
     DeleteLightHandle(light_handle);
 
-    // ǂݍ 3D f̔j
+    // 読み込んだ 3D モデルの破棄
     MV1DeleteModel(handle);
 
     DxLib_End();
@@ -114,9 +114,9 @@ int CALLBACK WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance,
 MATRIX GetCameraViewMatrix(VECTOR& cameraPosition, VECTOR& cameraTarget, VECTOR& cameraUp) {
     //SetCameraPositionAndTargetAndUpVec(camera_position, camera_target, camera_up);
     //MATRIX camera_matrix = GetCameraViewMatrix();
-    //  LƓ MATRIX ̓evZ
+    // ↑ 上記と同じ MATRIX の内容を計算する
 
-    // J̎pł XYZ 쐬
+    // カメラの姿勢での XYZ を作成
     VECTOR camera_z = VNorm(VSub(cameraTarget, cameraPosition));
     VECTOR camera_x = VNorm(VCross(cameraUp, camera_z));
     VECTOR camera_y = VCross(camera_z, camera_x);
@@ -134,7 +134,7 @@ MATRIX GetCameraViewMatrix(VECTOR& cameraPosition, VECTOR& cameraTarget, VECTOR&
     camera_matrix.m[2][0] = camera_x.z;
     camera_matrix.m[2][1] = camera_y.z;
     camera_matrix.m[2][2] = camera_z.z;
-    // DX Cuɂ VECTOR Ƀ}CiXZq@\͂Ȃ̂ VScale Ń}CiXɂ
+    // DX ライブラリには VECTOR にマイナス演算子をつける機能はないので VScale でマイナスにする
     camera_matrix.m[3][0] = VDot(VScale(camera_x, -1.0f), cameraPosition);
     camera_matrix.m[3][1] = VDot(VScale(camera_y, -1.0f), cameraPosition);
     camera_matrix.m[3][2] = VDot(VScale(camera_z, -1.0f), cameraPosition);
@@ -146,13 +146,13 @@ MATRIX GetCameraProjectionMatrix(float cameraNear, float cameraFar, float fov) {
     //SetCameraNearFar(camera_near, camera_far);
     //SetupCamera_Perspective(fov);
     //MATRIX projection_matrix = GetCameraProjectionMatrix();
-    //  LƓ MATRIX ̓evZ
+    // ↑ 上記と同じ MATRIX の内容を計算する
     auto aspect = static_cast<float>(SCREEN_WIDTH)/ static_cast<float>(SCREEN_HEIGHT);
     auto range = cameraFar - cameraNear;
     auto temp = cameraFar / range;
     auto cot = 1.0f / std::tan(fov * 0.5f);
 
-    // 0 s̎擾Ȃ̂ 0 XP[őΉ
+    // 0 行列の取得がないので 0 スケールで対応する
     MATRIX projection_matrix = MScale(MGetIdent(), 0.0f);
 
     projection_matrix.m[0][0] = cot / aspect;
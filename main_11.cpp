@@ -1,8 +1,8 @@
 //!
 //! @file main_11.cpp
 //!
-//! @brief 3D fǂݍ݁AŒ̕\sTv(+Jړ+JšvZ+vWFNVs)
-//!        main_10.cpp  vector4 / matrix44 class 
+//! @brief 3D モデルを読み込み、最低限の表示を行うサンプル(+カメラ移動+カメラ行列の計算+プロジェクション行列)
+//!        main_10.cpp の vector4 / matrix44 class 版
 //!
 #include "DxLib.h"
 #include "vector4.h"
@@ -42,7 +42,7 @@ int CALLBACK WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance,
         return -1;
     }
 
-    // 3D f̓ǂݍ
+    // 3D モデルの読み込み
     auto handle = MV1LoadModel(MODEL_FILE);
 
     if (handle == -1) {
@@ -50,16 +50,16 @@ int CALLBACK WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance,
         return -1;
     }
 
-    // s 1 ǉ
+    // 並行光源を 1 つ追加する
     VECTOR light_dir = VGet(1.0f, 0.0f, -0.1f);
     auto light_handle = CreateDirLightHandle(light_dir);
 
-    // J
+    // カメラ情報
     auto camera_position = math::vector4(-400.0, 250.0, -150.0);
     auto camera_target = math::vector4(0.0, 0.0, 0.0);
     auto camera_up = math::vector4(0.0, 1.0, 0.0);
 
-    // p[XyNeBuɕKvȏ
+    // パースペクティブ処理に必要な情報
     auto camera_near = 1.0;
     auto camera_far = 1000.;
     auto fov = math::utility::degree_to_radian(60.0);
@@ -74,7 +74,7 @@ int CALLBACK WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance,
             break;
         }
 
-        // JGɓĂ݂
+        // カメラを雑に動かしてみる
         if (1 == CheckHitKey(KEY_INPUT_UP)) {
             camera_position.add(0.0, 1.0, 0.0);
         } else if (1 == CheckHitKey(KEY_INPUT_DOWN)) {
@@ -85,7 +85,7 @@ int CALLBACK WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance,
             camera_position.add(1.0, 0.0, 0.0);
         }
 
-        // JZbg
+        // カメラ情報をセット
         //SetCameraPositionAndTargetAndUpVec(ToDX(camera_position), ToDX(camera_target), ToDX(camera_up));
         auto camera_matrix = GetCameraViewMatrix(camera_position, camera_target, camera_up);
         SetCameraViewMatrix(ToDX(camera_matrix));
@@ -97,7 +97,7 @@ int CALLBACK WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance,
 
         ClearDrawScreen();
 
-        // 3D f̕\
+        // 3D モデルの表示
         MV1DrawModel(handle);
 
         DrawFormatString(0, 0, string_color, string_camera_position, camera_position.get_x(), camera_position.get_y(), camera_position.get_z());
@@ -105,10 +105,10 @@ int CALLBACK WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance,
         ScreenFlip();
     }
 
-    // 쐬̔j
+    // 作成した光源の破棄
     DeleteLightHandle(light_handle);
 
-    // ǂݍ 3D f̔j
+    // 読み込んだ 3D モデルの破棄
     MV1DeleteModel(handle);
 
     DxLib_End();
@@ -119,7 +119,7 @@ int CALLBACK WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance,
 math::matrix44 GetCameraViewMatrix(math::vector4& cameraPosition, math::vector4& cameraTarget, math::vector4& cameraUp) {
     //SetCameraPositionAndTargetAndUpVec(camera_position, camera_target, camera_up);
     //MATRIX camera_matrix = GetCameraViewMatrix();
-    //  LƓ MATRIX ̓evZ
+    // ↑ 上記と同じ MATRIX の内容を計算する
     math::matrix44 camera_matrix = math::matrix44();
 
     camera_matrix.look_at(cameraPosition, cameraTarget, cameraUp);
@@ -131,7 +131,7 @@ math::matrix44 GetCameraProjectionMatrix(double cameraNear, double cameraFar, do
     //SetCameraNearFar(camera_near, camera_far);
     //SetupCamera_Perspective(fov);
     //MATRIX projection_matrix = GetCameraProjectionMatrix();
-    //  LƓ MATRIX ̓evZ
+    // ↑ 上記と同じ MATRIX の内容を計算する
     auto aspect = static_cast<float>(SCREEN_WIDTH) / static_cast<float>(SCREEN_HEIGHT);
     math::matrix44 projection_matrix = math::matrix44();
 
@@ -1,8 +1,8 @@
 //!
 //! @file main_12.cpp
 //!
-//! @brief 3D fǂݍ݁AŒ̕\sTv(+sł̃f]ƃXP[ƈړ+Jړ)
-//!        main_08.cpp  vector4 / matrix44 class 
+//! @brief 3D モデルを読み込み、最低限の表示を行うサンプル(+行列でのモデル回転とスケールと移動+カメラ移動)
+//!        main_08.cpp の vector4 / matrix44 class 版
 //!
 #include "DxLib.h"
 #include "vector4.h"
@@ -42,7 +42,7 @@ int CALLBACK WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance,
         return -1;
     }
 
-    // 3D f̓ǂݍ
+    // 3D モデルの読み込み
     auto handle = MV1LoadModel(MODEL_FILE);
 
     if (handle == -1) {
@@ -50,16 +50,16 @@ int CALLBACK WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance,
         return -1;
     }
 
-    // s 1 ǉ
+    // 並行光源を 1 つ追加する
     VECTOR light_dir = VGet(1.0f, 0.0f, -0.1f);
     auto light_handle = CreateDirLightHandle(light_dir);
 
-    // J
+    // カメラ情報
     math::vector4 camera_position = math::vector4(-400.0, 250.0, -150.0);
     math::vector4 camera_target = math::vector4(0.0, 0.0, 0.0);
     math::vector4 camera_up = math::vector4(0.0, 1.0, 0.0);
 
-    // p[XyNeBuɕKvȏ
+    // パースペクティブ処理に必要な情報
     auto camera_near = 1.0;
     auto camera_far = 1000.;
     auto fov = math::utility::degree_to_radian(60.0);
@@ -79,33 +79,33 @@ int CALLBACK WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance,
             break;
         }
 
-        // f Yŉ]Ă݂
-        model_y_angle += 0.5; // 0.5 xÂZ
+        // モデルを Y軸で回転させてみる
+        model_y_angle += 0.5; // 0.5 度づつ加算
 
-        // Ỷ]lx(fBO[)Ŏw肵čsŎ擾
+        // Y軸の回転値を度(ディグリー)で指定して行列で取得する
         model_y_matrix.rotate_y(model_y_angle, true);
 
-        // x -> WAɕϊ
+        // 度 -> ラジアンに変換
         auto model_y_radian = math::utility::degree_to_radian(model_y_angle);
 
-        // XP[ǉĂ݂(f Y px𗬗p)
+        // スケールも追加してみる(モデルの Y 軸角度を流用)
         auto model_scale = std::abs(std::cos(model_y_radian));
 
-        // XP[̍s擾
+        // スケールの行列を取得
         model_scale_matrix.scale(model_scale, model_scale, model_scale, true);
 
-        // Z̈ړǉĂ݂(f Ypx𗬗p)
+        // Z方向の移動も追加してみる(モデルの Y軸角度を流用)
         auto model_z_position = 300.0 * std::sin(model_y_radian);
 
-        // XP[̍s Y]̍s
+        // スケールの行列と Y軸回転の行列を合成する
         model_position_matrix.transfer(0.0, 0.0, model_z_position, true);
 
         auto model_matritx = model_y_matrix * model_scale_matrix * model_position_matrix;
 
-        // fɑ΂Ă̏sŃZbg
+        // モデルに対しての情報を行列でセットする
         MV1SetMatrix(handle, ToDX(model_matritx));
 
-        // JGɓĂ݂
+        // カメラを雑に動かしてみる
         if (1 == CheckHitKey(KEY_INPUT_UP)) {
             camera_position.add(0.0, 1.0, 0.0);
         } else if (1 == CheckHitKey(KEY_INPUT_DOWN)) {
@@ -116,7 +116,7 @@ int CALLBACK WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance,
             camera_position.add(1.0, 0.0, 0.0);
         }
 
-        // JZbg
+        // カメラ情報をセット
         //SetCameraPositionAndTargetAndUpVec(ToDX(camera_position), ToDX(camera_target), ToDX(camera_up));
         auto camera_matrix = GetCameraViewMatrix(camera_position, camera_target, camera_up);
         SetCameraViewMatrix(ToDX(camera_matrix));
@@ -128,7 +128,7 @@ int CALLBACK WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance,
 
         ClearDrawScreen();
 
-        // 3D f̕\
+        // 3D モデルの表示
         MV1DrawModel(handle);
 
         DrawFormatString(0, 0, string_color, string_camera_position, camera_position.get_x(), camera_position.get_y(), camera_position.get_z());
@@ -137,10 +137,10 @@ int CALLBACK WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance,
         ScreenFlip();
     }
 
-    // 쐬̔j
+    // 作成した光源の破棄
     DeleteLightHandle(light_handle);
 
-    // ǂݍ 3D f̔j
+    // 読み込んだ 3D モデルの破棄
     MV1DeleteModel(handle);
 
     DxLib_End();
@@ -151,7 +151,7 @@ int CALLBACK WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance,
 math::matrix44 GetCameraViewMatrix(math::vector4& cameraPosition, math::vector4& cameraTarget, math::vector4& cameraUp) {
     //SetCameraPositionAndTargetAndUpVec(camera_position, camera_target, camera_up);
     //MATRIX camera_matrix = GetCameraViewMatrix();
-    //  LƓ MATRIX ̓evZ
+    // ↑ 上記と同じ MATRIX の内容を計算する
     math::matrix44 camera_matrix = math::matrix44();
 
     camera_matrix.look_at(cameraPosition, cameraTarget, cameraUp);
@@ -163,7 +163,7 @@ math::matrix44 GetCameraProjectionMatrix(double cameraNear, double cameraFar, do
     //SetCameraNearFar(camera_near, camera_far);
     //SetupCamera_Perspective(fov);
     //MATRIX projection_matrix = GetCameraProjectionMatrix();
-    //  LƓ MATRIX ̓evZ
+    // ↑ 上記と同じ MATRIX の内容を計算する
     auto aspect = static_cast<float>(SCREEN_WIDTH) / static_cast<float>(SCREEN_HEIGHT);
     math::matrix44 projection_matrix = math::matrix44();
 
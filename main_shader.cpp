@@ -1,9 +1,9 @@
 //!
 //! @file main_shader.cpp
 //!
-//! @brief 3D fǂݍ݁AShader ł̕\sTv(f])
-//!        f̃eNX`́AftB[Y / m[}}bv / X؃L}bv
-//!        Shader  m[}}bvVF[_[
+//! @brief 3D モデルを読み込み、Shader での表示を行うサンプル(モデル回転あり)
+//!        モデルのテクスチャは、デフィーズ / ノーマルマップ / スぺキュラマップ
+//!        Shader は ノーマルマップシェーダー
 //!
 #include "DxLib.h"
 
@@ -23,7 +23,7 @@ namespace {
     auto string_shader_version = _T("Shader Version : [%.1f]");
     auto string_model_texture_num = _T("Model Texture Num : [%d]");
 
-    // J
+    // カメラ情報
     VECTOR camera_position = VGet(-400.0f, 250.0f, -150.0f);
     VECTOR camera_target = VGet(0.0f, 0.0f, 0.0f);
     VECTOR camera_up = VGet(0.0f, 1.0f, 0.0f);
@@ -46,10 +46,10 @@ int CALLBACK WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance,
     }
 
     auto handle = MV1LoadModel(MODEL_FILE);
-    // ShaderCompiler.exe ŃRpCς݂̒_VF[_[ƃsNZVF[_[[h
+    // ShaderCompiler.exe でコンパイル済みの頂点シェーダーとピクセルシェーダーをロード
     auto vertex_shder_handle = LoadVertexShader(VERTEX_SHADER_FILE);
     auto pixel_shader_handle = LoadPixelShader(PIXEL_SHADER_FILE);
-    // gp\ȃVF[_[o[W
+    // 使用可能なシェーダーバージョン
     auto shader_version = GetValidShaderVersion();
 
     if (handle == -1 || vertex_shder_handle == -1 || pixel_shader_handle == -1 || shader_version == 0) {
@@ -57,9 +57,9 @@ int CALLBACK WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance,
         return -1;
     }
 
-    // VF[_[Lɂf`
+    // シェーダーを有効にしたモデル描画
     MV1SetUseOrigShader(TRUE);
-    // VF[_[K
+    // シェーダーを適応
     SetUseVertexShader(vertex_shder_handle);
     SetUsePixelShader(pixel_shader_handle);
 
@@ -67,7 +67,7 @@ int CALLBACK WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance,
 
     auto model_y_angle = 0.0f;
     auto version = shader_version / 100.0f;
-    auto texture_num = MV1GetTextureNum(handle); // ftB[Y / m[}}bv / X؃L}bv 3 
+    auto texture_num = MV1GetTextureNum(handle); // デフィーズ / ノーマルマップ / スぺキュラマップの 3 枚
 
     while (ProcessMessage() != -1) {
         if (1 == CheckHitKey(KEY_INPUT_ESCAPE)) {
@@ -76,7 +76,7 @@ int CALLBACK WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance,
 
         model_y_angle += 0.5f;
 
-        // VF[_[̋ՂlɃf]
+        // シェーダーの具合が分かり易い様にモデルを回転させる
         MV1SetMatrix(handle, MGetRotY(model_y_angle * DEGREE_TO_RADIAN));
         SetCameraPositionAndTargetAndUpVec(camera_position, camera_target, camera_up);
 
@@ -1,9 +1,9 @@
 //!
 //! @file main_shader_skinmesh.cpp
 //!
-//! @brief 3D fǂݍ݁AShader ł̃XLjOAj[V\sTv
-//!        Shader  XLjO̒ʏ̒_ϊ̒_VF[_[(vertex_shader_skinmesh_dummy
-//!        pӂĐ؂ւ\(XLjOKvȎ𗝉)
+//! @brief 3D モデルを読み込み、Shader でのスキニング処理をしたアニメーション表示を行うサンプル
+//!        Shader は スキニング処理無しの通常の頂点変換の頂点シェーダー(vertex_shader_skinmesh_dummy
+//!        も用意して切り替え可能(スキニングが必要な事を理解する)
 //!
 #include "DxLib.h"
 
@@ -24,7 +24,7 @@ namespace {
     auto string_shader_version = _T("Shader Version : [%.1f]");
     auto string_shader_dummy = _T("No Skinning(Change Space Key) : [%d]");
 
-    // J
+    // カメラ情報
     VECTOR camera_position = VGet(0.0f, 100.0f, -225.0f);
     VECTOR camera_target = VGet(0.0f, 50.0f, 0.0f);
     VECTOR camera_up = VGet(0.0f, 1.0f, 0.0f);
@@ -47,11 +47,11 @@ int CALLBACK WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance,
     }
 
     auto handle = MV1LoadModel(MODEL_FILE);
-    // ShaderCompiler.exe ŃRpCς݂̒_VF[_[ƃsNZVF[_[[h
+    // ShaderCompiler.exe でコンパイル済みの頂点シェーダーとピクセルシェーダーをロード
     auto vertex_shder_handle = LoadVertexShader(VERTEX_SHADER_FILE);
     auto vertex_shder_dummy_handle = LoadVertexShader(VERTEX_SHADER_DUMMY_FILE);
     auto pixel_shader_handle = LoadPixelShader(PIXEL_SHADER_FILE);
-    // gp\ȃVF[_[o[W
+    // 使用可能なシェーダーバージョン
     auto shader_version = GetValidShaderVersion();
 
     if (handle == -1 || vertex_shder_handle == -1 ||
@@ -60,9 +60,9 @@ int CALLBACK WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance,
         return -1;
     }
 
-    // VF[_[Lɂf`
+    // シェーダーを有効にしたモデル描画
     MV1SetUseOrigShader(TRUE);
-    // VF[_[K
+    // シェーダーを適応
     SetUseVertexShader(vertex_shder_handle);
     SetUsePixelShader(pixel_shader_handle);
 
@@ -80,7 +80,7 @@ int CALLBACK WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance,
             break;
         }
 
-        // Xy[XL[ _VF[_[؂ւ
+        // スペースキーで 頂点シェーダーを切り替え
         auto input_space = CheckHitKey(KEY_INPUT_SPACE);
 
         if (1 == input_space && 0 == last_input_space) {
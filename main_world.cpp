@@ -1,18 +1,28 @@
 //!
 //! @file main_world.cpp
 //!
-//! @brief 3D fǂݍ݁Av~eBu̍쐬ƕ`Ae̓蔻sTv
+//! @brief 3D モデルを読み込み、プリミティブの作成と描画、各種の当たり判定を行うサンプル
 //!
 #include "DxLib.h"
 #include "world_logic.h"
 #include "world_base.h"
 #include "fade.h"
+#include "mesh_cache.h"
+#include "mesh_renderer.h"
 
 namespace {
     constexpr auto WINDOW_TITLE = _T("Basic 3D");
     constexpr auto SCREEN_WIDTH = 1280;
     constexpr auto SCREEN_HEIGHT = 720;
     constexpr auto SCREEN_DEPTH = 32;
+
+    // 共有しているメッシュと既定の描画が持つ GPU のバッファは DX ライブラリを終了する前に解放する
+    void end_dxlib() {
+        primitive::mesh_cache::clear();
+        primitive::set_default_renderer(nullptr);
+
+        DxLib_End();
+    }
 }
 
 int CALLBACK WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance, _In_ LPSTR lpCmdLine, _In_ int nCmdShow) {
@@ -39,15 +49,16 @@ int CALLBACK WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance,
     auto world = world_initialize(SCREEN_WIDTH, SCREEN_HEIGHT);
 
     if (world == nullptr) {
-        DxLib_End();
+        end_dxlib();
         return -1;
     }
 
-    // Shader gptF[h
+    // Shader を使用したフェード
     std::unique_ptr<mv1::fade> fade(new mv1::fade());
 
     if (!fade->initialize(SCREEN_WIDTH, SCREEN_HEIGHT)) {
-        DxLib_End();
+        world.reset();
+        end_dxlib();
         return -1;
     }
 
@@ -90,7 +101,9 @@ int CALLBACK WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance,
 
     DeleteLightHandle(light_handle);
 
-    DxLib_End();
+    // プリミティブが持つ GPU のバッファを先に解放する
+    world.reset();
+    end_dxlib();
 
     return 0;
 }
@@ -0,0 +1,172 @@
+#include <algorithm>
+#include <limits>
+#include "batch.h"
+#include "frustum.h"
+#include "matrix44.h"
+#include "vector4.h"
+#include "simd.h"
+
+namespace math {
+
+    namespace {
+        template <typename T>
+        bool transform(const basic_matrix44<T>& matrix, const basic_soa_span<const std::type_identity_t<T>>& source, const basic_soa_span<T>& result, const bool point) {
+            if (!source.valid() || !result.valid() || source.size() != result.size()) {
+                return false;
+            }
+
+            simd::transform_soa(matrix.data(), source.x.data(), source.y.data(), source.z.data(),
+                                result.x.data(), result.y.data(), result.z.data(), source.size(), point);
+
+            return true;
+        }
+
+        template <typename T>
+        bool same_size(const basic_soa_span<const T>& base, const basic_soa_span<const T>& other) {
+            return other.valid() && other.size() == base.size();
+        }
+
+        // 三角形の頂点列を simd::intersect_segment_triangle の 9 本の座標列にして判定する
+        template <typename T>
+        std::size_t intersect(const basic_vector4<T>& start, const basic_vector4<T>& end, const basic_soa_span<const T>& point0,
+                              const basic_soa_span<const T>& point1, const basic_soa_span<const T>& point2, T& ratio) {
+            const T* const triangle[] = {
+                point0.x.data(), point0.y.data(), point0.z.data(),
+                point1.x.data(), point1.y.data(), point1.z.data(),
+                point2.x.data(), point2.y.data(), point2.z.data()
+            };
+
+            return simd::intersect_segment_triangle(start.data(), end.data(), triangle, point0.size(), ratio);
+        }
+    }
+
+    template <typename T>
+    bool batch::transform_point(const basic_matrix44<T>& matrix, const basic_soa_span<const std::type_identity_t<T>>& source, const basic_soa_span<T>& result) {
+        return transform(matrix, source, result, true);
+    }
+
+    template <typename T>
+    bool batch::transform_point(const basic_matrix44<T>& matrix, const basic_soa_span<T>& values) {
+        return transform(matrix, values, values, true);
+    }
+
+    template <typename T>
+    bool batch::transform_normal(const basic_matrix44<T>& matrix, const basic_soa_span<const std::type_identity_t<T>>& source, const basic_soa_span<T>& result) {
+        return transform(matrix, source, result, false);
+    }
+
+    template <typename T>
+    bool batch::transform_normal(const basic_matrix44<T>& matrix, const basic_soa_span<T>& values) {
+        return transform(matrix, values, values, false);
+    }
+
+    template <typename T>
+    basic_segment_hit<T> batch::intersect_segment_triangle(const basic_vector4<T>& start, const basic_vector4<T>& end,
+                                                           const basic_soa_span<const std::type_identity_t<T>>& point0,
+                                                           const basic_soa_span<const std::type_identity_t<T>>& point1,
+                                                           const basic_soa_span<const std::type_identity_t<T>>& point2) {
+        if (!point0.valid() || !same_size(point0, point1) || !same_size(point0, point2)) {
+            return { false, 0, 0 };
+        }
+
+        auto ratio = std::numeric_limits<T>::max();
+        const auto index = intersect(start, end, point0, point1, point2, ratio);
+
+        if (index == point0.size()) {
+            return { false, 0, 0 };
+        }
+
+        return { true, index, ratio };
+    }
+
+    template <typename T>
+    basic_segment_hit<T> batch::intersect_segment_quad(const basic_vector4<T>& start, const basic_vector4<T>& end,
+                                                       const basic_soa_span<const std::type_identity_t<T>>& point0,
+                                                       const basic_soa_span<const std::type_identity_t<T>>& point1,
+                                                       const basic_soa_span<const std::type_identity_t<T>>& point2,
+                                                       const basic_soa_span<const std::type_identity_t<T>>& point3) {
+        if (!point0.valid() || !same_size(point0, point1) || !same_size(point0, point2) || !same_size(point0, point3)) {
+            return { false, 0, 0 };
+        }
+
+        // 2 回目は 1 回目より近い交点だけを採用する
+        const auto count = point0.size();
+        auto ratio = std::numeric_limits<T>::max();
+        const auto first = intersect(start, end, point0, point1, point2, ratio);
+        const auto second = intersect(start, end, point1, point3, point2, ratio);
+        const auto index = (second != count) ? second : first;
+
+        if (index == count) {
+            return { false, 0, 0 };
+        }
+
+        return { true, index, ratio };
+    }
+
+    template <typename T>
+    bool batch::inside_triangle_point(const basic_vector4<T>& point0, const basic_vector4<T>& point1, const basic_vector4<T>& point2,
+                                      const basic_soa_span<const std::type_identity_t<T>>& points, const std::span<bool> result) {
+        if (!points.valid() || points.size() != result.size()) {
+            return false;
+        }
+
+        const T triangle[] = {
+            point0.get_x(), point0.get_y(), point0.get_z(),
+            point1.get_x(), point1.get_y(), point1.get_z(),
+            point2.get_x(), point2.get_y(), point2.get_z()
+        };
+
+        simd::inside_triangle(triangle, points.x.data(), points.y.data(), points.z.data(), result.data(), points.size(), inside_tolerance<T>);
+
+        return true;
+    }
+
+    template <typename T>
+    std::size_t batch::cull(const basic_frustum<T>& frustum, const basic_soa_span<const std::type_identity_t<T>>& center,
+                            const basic_soa_span<const std::type_identity_t<T>>& extent, const std::span<const std::type_identity_t<T>> radius,
+                            const std::span<bool> visible) {
+        const auto count = center.size();
+
+        if (!center.valid() || !extent.valid() || extent.size() != count || radius.size() != count || visible.size() != count) {
+            return 0;
+        }
+
+        const T* bounds[] = {
+            center.x.data(), center.y.data(), center.z.data(),
+            extent.x.data(), extent.y.data(), extent.z.data(),
+            radius.data()
+        };
+
+        simd::cull_bounds(frustum.data(), bounds, visible.data(), count);
+
+        return static_cast<std::size_t>(std::count(visible.begin(), visible.end(), true));
+    }
+
+    template bool batch::transform_point<double>(const matrix44&, const basic_soa_span<const double>&, const basic_soa_span<double>&);
+    template bool batch::transform_point<double>(const matrix44&, const basic_soa_span<double>&);
+    template bool batch::transform_normal<double>(const matrix44&, const basic_soa_span<const double>&, const basic_soa_span<double>&);
+    template bool batch::transform_normal<double>(const matrix44&, const basic_soa_span<double>&);
+
+    template bool batch::transform_point<float>(const matrix44f&, const basic_soa_span<const float>&, const basic_soa_span<float>&);
+    template bool batch::transform_point<float>(const matrix44f&, const basic_soa_span<float>&);
+    template bool batch::transform_normal<float>(const matrix44f&, const basic_soa_span<const float>&, const basic_soa_span<float>&);
+    template bool batch::transform_normal<float>(const matrix44f&, const basic_soa_span<float>&);
+
+    template basic_segment_hit<double> batch::intersect_segment_triangle<double>(const vector4&, const vector4&, const basic_soa_span<const double>&,
+                                                                                const basic_soa_span<const double>&, const basic_soa_span<const double>&);
+    template basic_segment_hit<double> batch::intersect_segment_quad<double>(const vector4&, const vector4&, const basic_soa_span<const double>&,
+                                                                            const basic_soa_span<const double>&, const basic_soa_span<const double>&,
+                                                                            const basic_soa_span<const double>&);
+
+    template basic_segment_hit<float> batch::intersect_segment_triangle<float>(const vector4f&, const vector4f&, const basic_soa_span<const float>&,
+                                                                              const basic_soa_span<const float>&, const basic_soa_span<const float>&);
+    template basic_segment_hit<float> batch::intersect_segment_quad<float>(const vector4f&, const vector4f&, const basic_soa_span<const float>&,
+                                                                          const basic_soa_span<const float>&, const basic_soa_span<const float>&,
+                                                                          const basic_soa_span<const float>&);
+
+    template bool batch::inside_triangle_point<double>(const vector4&, const vector4&, const vector4&, const basic_soa_span<const double>&, const std::span<bool>);
+    template bool batch::inside_triangle_point<float>(const vector4f&, const vector4f&, const vector4f&, const basic_soa_span<const float>&, const std::span<bool>);
+
+    template std::size_t batch::cull<double>(const frustum&, const basic_soa_span<const double>&, const basic_soa_span<const double>&, const std::span<const double>, const std::span<bool>);
+    template std::size_t batch::cull<float>(const frustumf&, const basic_soa_span<const float>&, const basic_soa_span<const float>&, const std::span<const float>, const std::span<bool>);
+}
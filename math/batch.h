@@ -0,0 +1,150 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+#include "math_fwd.h"
+
+namespace math {
+
+    // 座標列を x[] / y[] / z[] に分けて持つ (structure of arrays)
+    template <typename T>
+    struct basic_soa_span {
+        std::span<T> x;
+        std::span<T> y;
+        std::span<T> z;
+
+        std::size_t size() const { return x.size(); }
+        bool valid() const { return x.size() == y.size() && x.size() == z.size(); }
+
+        // 読み取り専用として渡す
+        operator basic_soa_span<const T>() const requires (!std::is_const_v<T>) { return { x, y, z }; }
+    };
+
+    // 連続した x, y, z 領域をまとめて確保する作業用バッファ
+    template <typename T>
+    class basic_soa_buffer {
+    public:
+        void resize(const std::size_t size) {
+            count = size;
+            values.resize(size * 3);
+        }
+
+        std::size_t size() const { return count; }
+
+        basic_soa_span<T> span() {
+            return { { values.data(), count }, { values.data() + count, count }, { values.data() + count * 2, count } };
+        }
+
+        basic_soa_span<const T> span() const {
+            return { { values.data(), count }, { values.data() + count, count }, { values.data() + count * 2, count } };
+        }
+
+    private:
+        std::vector<T> values;
+        std::size_t count = 0;
+    };
+
+    // 判定結果を書き込む作業用バッファ (std::vector<bool> はビット単位に詰めるので std::span<bool> として渡せない)
+    // 小さくする時は確保し直さない。コピーすると領域も複製する
+    class flag_buffer {
+    public:
+        flag_buffer() = default;
+        flag_buffer(const flag_buffer& other) { *this = other; } // コピー
+        flag_buffer(flag_buffer&&) = default; // ムーブ
+
+        flag_buffer& operator=(const flag_buffer& other) {
+            if (this != &other) {
+                resize(other.count);
+                std::copy_n(other.values.get(), other.count, values.get());
+            }
+
+            return *this;
+        }
+
+        flag_buffer& operator=(flag_buffer&&) = default;
+
+        void resize(const std::size_t size) {
+            if (capacity < size) {
+                values = std::make_unique<bool[]>(size);
+                capacity = size;
+            }
+
+            count = size;
+        }
+
+        std::size_t size() const { return count; }
+
+        std::span<bool> span() { return { values.get(), count }; }
+        std::span<const bool> span() const { return { values.get(), count }; }
+
+    private:
+        std::unique_ptr<bool[]> values;
+        std::size_t count = 0;
+        std::size_t capacity = 0;
+    };
+
+    // 線分と三角形 / 四角形の交差判定の結果 (交差したか, 番号, start からの線分上の位置 0 ～ 1)
+    template <typename T>
+    using basic_segment_hit = std::tuple<bool, std::size_t, T>;
+
+    // 1 つの行列で N 個の座標をまとめて変換する
+    // 要素毎の vector4 を生成しないので頂点数の多いメッシュ向け
+    // source と result の要素数が違う場合は何もせずに false を返す
+    class batch {
+    public:
+        // 内外判定で辺上とみなす幅(重心座標に対する幅なので三角形の大きさに依らない)
+        template <typename T>
+        static constexpr T inside_tolerance = std::numeric_limits<T>::epsilon() * 64;
+
+        // 点として変換する(w = 1 で平行移動を含む)
+        template <typename T>
+        static bool transform_point(const basic_matrix44<T>& matrix, const basic_soa_span<const std::type_identity_t<T>>& source, const basic_soa_span<T>& result);
+        template <typename T>
+        static bool transform_point(const basic_matrix44<T>& matrix, const basic_soa_span<T>& values);
+
+        // 方向として変換する(w = 0 で平行移動を含まない)
+        // 法線には回転行列を渡す事(拡大縮小を含む場合は正規化されない)
+        template <typename T>
+        static bool transform_normal(const basic_matrix44<T>& matrix, const basic_soa_span<const std::type_identity_t<T>>& source, const basic_soa_span<T>& result);
+        template <typename T>
+        static bool transform_normal(const basic_matrix44<T>& matrix, const basic_soa_span<T>& values);
+
+        // 線分 start -> end と N 個の三角形の交差判定 (i 番目の三角形の頂点は point0 / point1 / point2 の i 番目)
+        // 交差した中で start に最も近い三角形を返す。要素数が揃っていない場合は交差しない扱い
+        template <typename T>
+        static basic_segment_hit<T> intersect_segment_triangle(const basic_vector4<T>& start, const basic_vector4<T>& end,
+                                                               const basic_soa_span<const std::type_identity_t<T>>& point0,
+                                                               const basic_soa_span<const std::type_identity_t<T>>& point1,
+                                                               const basic_soa_span<const std::type_identity_t<T>>& point2);
+
+        // 四角形は utility::collision_polygon_line と同じく (0, 1, 2) と (1, 3, 2) の三角形に分けて判定する
+        template <typename T>
+        static basic_segment_hit<T> intersect_segment_quad(const basic_vector4<T>& start, const basic_vector4<T>& end,
+                                                           const basic_soa_span<const std::type_identity_t<T>>& point0,
+                                                           const basic_soa_span<const std::type_identity_t<T>>& point1,
+                                                           const basic_soa_span<const std::type_identity_t<T>>& point2,
+                                                           const basic_soa_span<const std::type_identity_t<T>>& point3);
+
+        // N 個の点が 1 つの三角形の内側か判定して result に書き込む(点は三角形と同平面である事)
+        // 辺上の点は内側とする。要素数が揃っていない場合は何もせずに false を返す
+        template <typename T>
+        static bool inside_triangle_point(const basic_vector4<T>& point0, const basic_vector4<T>& point1, const basic_vector4<T>& point2,
+                                          const basic_soa_span<const std::type_identity_t<T>>& points, const std::span<bool> result);
+
+        // N 個の境界が視錐台と重なるか判定して visible に書き込み、見える数を返す
+        // 境界は 中心 center、軸平行境界箱の半分の大きさ extent、球の半径 radius (どちらかが外側なら見えない)
+        // 要素数が揃っていない場合は何もせずに 0 を返す
+        template <typename T>
+        static std::size_t cull(const basic_frustum<T>& frustum, const basic_soa_span<const std::type_identity_t<T>>& center,
+                                const basic_soa_span<const std::type_identity_t<T>>& extent, const std::span<const std::type_identity_t<T>> radius,
+                                const std::span<bool> visible);
+
+    private:
+        batch() = default;
+    };
+}
@@ -0,0 +1,86 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <tuple>
+
+namespace math {
+
+    // コンパイル時に評価できる計算
+    // 定数の行列や三角関数表を constexpr で作る為のもので、実行時は fast_math / 標準ライブラリを使う
+    class constexpr_math {
+    public:
+        static constexpr double PI = 3.14159265358979323846;
+
+        // sin と cos をまとめて求める(|radian| が大きいと区間の縮小で誤差が増える)
+        static constexpr std::tuple<double, double> sin_cos(const double radian) {
+            // radian = quadrant * (PI / 2) + r (|r| <= PI / 4) に分ける
+            const auto scaled = radian * (2.0 / PI);
+            const auto quadrant = static_cast<long long>(scaled >= 0.0 ? scaled + 0.5 : scaled - 0.5);
+            const auto r = radian - static_cast<double>(quadrant) * (PI / 2.0);
+
+            const auto sin_r = sin_series(r);
+            const auto cos_r = cos_series(r);
+
+            switch (quadrant & 3) {
+            case 1:
+                return { cos_r, -sin_r };
+
+            case 2:
+                return { -sin_r, -cos_r };
+
+            case 3:
+                return { -cos_r, sin_r };
+
+            case 0:
+            default:
+                return { sin_r, cos_r };
+            }
+        }
+
+        // 0 度から 360 度を N 等分した角度の (sin, cos) の表
+        template <typename T, std::size_t N>
+        static constexpr std::array<std::tuple<T, T>, N> make_sin_cos_table() {
+            std::array<std::tuple<T, T>, N> table{};
+
+            for (std::size_t i = 0; i < N; ++i) {
+                const auto [sin, cos] = sin_cos(2.0 * PI * static_cast<double>(i) / static_cast<double>(N));
+
+                table[i] = { static_cast<T>(sin), static_cast<T>(cos) };
+            }
+
+            return table;
+        }
+
+    private:
+        constexpr_math() = default;
+
+        // |x| <= PI / 4 で double の精度になるまで Taylor 展開する
+        static constexpr double sin_series(const double x) {
+            const auto x2 = x * x;
+            auto term = x;
+            auto sum = x;
+
+            for (auto i = 2; i <= 16; i += 2) {
+                term *= -x2 / (i * (i + 1));
+                sum += term;
+            }
+
+            return sum;
+        }
+
+        static constexpr double cos_series(const double x) {
+            const auto x2 = x * x;
+            auto term = 1.0;
+            auto sum = 1.0;
+
+            for (auto i = 1; i <= 15; i += 2) {
+                term *= -x2 / (i * (i + 1));
+                sum += term;
+            }
+
+            return sum;
+        }
+    };
+
+    static_assert(std::get<0>(constexpr_math::sin_cos(0.0)) == 0.0 && std::get<1>(constexpr_math::sin_cos(0.0)) == 1.0);
+}
@@ -0,0 +1,107 @@
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include "constexpr_math.h"
+#include "fast_math.h"
+
+namespace {
+    // 全スレッドで共有する(他のデータとの順序は保証しなくてよいので relaxed で読み書きする)
+    std::atomic<math::math_mode>& current_mode() {
+        static std::atomic<math::math_mode> mode(math::math_mode::precise);
+
+        return mode;
+    }
+
+#if defined(MATH_DETERMINISTIC)
+    // |x| <= tan(π/16) の atan の級数(28 乗の項で double の精度になる)
+    double atan_series(const double x) {
+        const auto x2 = x * x;
+        auto power = x;
+        auto sum = x;
+
+        for (auto i = 3; i <= 29; i += 2) {
+            power *= -x2;
+            sum += power / i;
+        }
+
+        return sum;
+    }
+
+    // x >= 0 の atan (四則演算と sqrt だけで求める)
+    double deterministic_atan(double x) {
+        const auto invert = x > 1.0;
+
+        if (invert) {
+            x = 1.0 / x;
+        }
+
+        // 半角の公式 atan(x) = 2 * atan(x / (1 + sqrt(1 + x^2))) を 2 回使って |x| <= tan(π/16) にする
+        x = x / (1.0 + std::sqrt(1.0 + x * x));
+        x = x / (1.0 + std::sqrt(1.0 + x * x));
+
+        const auto result = 4.0 * atan_series(x);
+
+        return invert ? math::constexpr_math::PI / 2.0 - result : result;
+    }
+#endif
+}
+
+namespace math {
+
+    math_mode fast_math::get_mode() {
+        return current_mode().load(std::memory_order_relaxed);
+    }
+
+    void fast_math::set_mode(const math_mode mode) {
+        current_mode().store(mode, std::memory_order_relaxed);
+    }
+
+    template <typename T>
+    std::tuple<T, T> fast_math::sin_cos_precise(const T radian) {
+#if defined(MATH_DETERMINISTIC)
+        const auto [sin, cos] = constexpr_math::sin_cos(static_cast<double>(radian));
+
+        return std::make_tuple(static_cast<T>(sin), static_cast<T>(cos));
+#else
+        return std::make_tuple(std::sin(radian), std::cos(radian));
+#endif
+    }
+
+    template <typename T>
+    T fast_math::tan(const T radian) {
+#if defined(MATH_DETERMINISTIC)
+        const auto [sin, cos] = constexpr_math::sin_cos(static_cast<double>(radian));
+
+        return static_cast<T>(sin / cos);
+#else
+        return std::tan(radian);
+#endif
+    }
+
+    template <typename T>
+    T fast_math::acos(const T value) {
+#if defined(MATH_DETERMINISTIC)
+        // acos(v) = 2 * atan(sqrt((1 - v) / (1 + v)))
+        const auto v = static_cast<double>(value);
+
+        if (v <= -1.0) {
+            return static_cast<T>(constexpr_math::PI);
+        }
+
+        if (v >= 1.0) {
+            return 0;
+        }
+
+        return static_cast<T>(2.0 * deterministic_atan(std::sqrt((1.0 - v) / (1.0 + v))));
+#else
+        return std::acos(value);
+#endif
+    }
+
+    template std::tuple<double, double> fast_math::sin_cos_precise<double>(const double);
+    template std::tuple<float, float> fast_math::sin_cos_precise<float>(const float);
+    template double fast_math::tan<double>(const double);
+    template float fast_math::tan<float>(const float);
+    template double fast_math::acos<double>(const double);
+    template float fast_math::acos<float>(const float);
+}
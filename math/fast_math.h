@@ -0,0 +1,174 @@
+#pragma once
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <tuple>
+
+// MATH_DETERMINISTIC を定義すると、同じ入力からはコンパイラや CPU によらず同じビット列の結果になる(リプレイの再現用)
+//   ・precise の三角関数は標準ライブラリを使わずに四則演算と sqrt で求める(libm の実装差を避ける)
+//   ・rsqrt の近似値は CPU 命令 (rsqrtss) を使わずに整数演算で求める(CPU による近似値の差を避ける)
+//   ・simd class は scalar に固定する(FMA の有無で丸めが変わるのを避ける)
+// 積和を FMA にまとめない設定 (-ffp-contract=off / /fp:precise、GCC は -fno-tree-slp-vectorize も) と
+// SSE2 の浮動小数点演算 (x87 以外) でビルドすること
+#if defined(MATH_DETERMINISTIC)
+#if defined(__FAST_MATH__)
+#error "MATH_DETERMINISTIC は -ffast-math と併用できない"
+#endif
+#if (defined(__i386__) && !defined(__SSE2_MATH__)) || (defined(_M_IX86_FP) && _M_IX86_FP < 2)
+#error "MATH_DETERMINISTIC は x87 の浮動小数点演算では使えない"
+#endif
+#endif
+
+#if (defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)) && !defined(MATH_DETERMINISTIC)
+#include <xmmintrin.h>
+#define MATH_FAST_RSQRT_SSE
+#endif
+
+namespace math {
+
+    // 三角関数と正規化の計算方法
+    enum class math_mode {
+        precise, // 標準ライブラリ (std::sin / std::cos / std::sqrt)、MATH_DETERMINISTIC では級数展開
+        fast     // 多項式近似 と 逆数平方根の近似 (float の rsqrt のみ)
+    };
+
+    // 速度優先の近似計算
+    // fast の誤差 (|radian| <= 10000 で benchmark_fast_math により計測、MATH_DETERMINISTIC でビルドしても同じ範囲)
+    //   sin_cos : 絶対誤差 float 1e-7 以下 / double 3e-9 以下 (係数は float 向けの minimax)
+    //   rsqrt   : 相対誤差 float 3e-7 以下
+    // 近似が precise より速くならないものは fast でも precise と同じ計算をする (benchmark_fast_math で計測)
+    //   double の rsqrt : sqrt と除算が float の近似 + Newton 法 2 回と変わらない
+    //   正規化 (vector4::normalize) : sqrt と 3 回の除算より、rsqrt の近似 + Newton 法 + 3 回の乗算の方が遅い
+    class fast_math {
+    public:
+        // 呼び出し側で指定しない場合の計算方法(初期値は precise、プロセス全体で共有し、どのスレッドから呼んでもよい)
+        static math_mode get_mode();
+        static void set_mode(const math_mode mode);
+
+        // sin と cos をまとめて求める
+        template <typename T>
+        static std::tuple<T, T> sin_cos(const T radian) { return sin_cos(radian, get_mode()); }
+        // fast は呼び出し側で展開される様にヘッダーで定義する(関数呼び出しだと float は標準ライブラリと差が付かない)
+        template <typename T>
+        static std::tuple<T, T> sin_cos(const T radian, const math_mode mode) {
+            return (mode == math_mode::fast) ? sin_cos_polynomial(radian) : sin_cos_precise(radian);
+        }
+
+        // tan / acos (precise のみ。MATH_DETERMINISTIC で結果が変わらない様に三角関数はここを通す)
+        template <typename T>
+        static T tan(const T radian);
+        template <typename T>
+        static T acos(const T value);
+
+        // MATH_DETERMINISTIC でビルドしているか
+        static constexpr bool is_deterministic() {
+#if defined(MATH_DETERMINISTIC)
+            return true;
+#else
+            return false;
+#endif
+        }
+
+        // 1 / sqrt(value)
+        // 呼び出し側で展開される様にヘッダーで定義する
+        template <typename T>
+        static T rsqrt(const T value) { return rsqrt(value, get_mode()); }
+        template <typename T>
+        static T rsqrt(const T value, const math_mode mode) {
+            if constexpr (sizeof(T) > sizeof(float)) {
+                return 1 / std::sqrt(value);
+            }
+            else {
+                if (mode != math_mode::fast) {
+                    return 1 / std::sqrt(value);
+                }
+
+                // 12bit -> 24bit 相当まで精度を上げる
+                return newton_rsqrt(value, estimate_rsqrt(value));
+            }
+        }
+
+    private:
+        fast_math() = default;
+
+        template <typename T>
+        static std::tuple<T, T> sin_cos_precise(const T radian);
+
+        // 最も近い π / 2 の倍数を引いて [-π/4, π/4] に縮約し、minimax 多項式で求める
+        template <typename T>
+        static std::tuple<T, T> sin_cos_polynomial(const T radian) {
+            // 象限の判定と縮約用の π / 2 (Cody-Waite : 3 つに分けて上位 2 つは象限との積が誤差なしで求まる)
+            constexpr auto two_over_pi = static_cast<T>(0.636619772367581343);
+            constexpr auto half_pi_1 = static_cast<T>(1.5703125);
+            constexpr auto half_pi_2 = static_cast<T>(4.837512969970703125e-4);
+            constexpr auto half_pi_3 = static_cast<T>(7.54978995489188216e-8);
+
+            // [-π/4, π/4] での minimax 多項式の係数
+            constexpr auto sin_1 = static_cast<T>(-1.6666654611e-1);
+            constexpr auto sin_2 = static_cast<T>(8.3321608736e-3);
+            constexpr auto sin_3 = static_cast<T>(-1.9515295891e-4);
+            constexpr auto cos_1 = static_cast<T>(4.166664568298827e-2);
+            constexpr auto cos_2 = static_cast<T>(-1.388731625493765e-3);
+            constexpr auto cos_3 = static_cast<T>(2.443315711809948e-5);
+
+            // 1.5 * 2^(仮数のビット数) を足して最も近い整数に丸める(整数への変換と戻しを待たない)
+            // 丸めた値の仮数の下位ビットが象限になる (-ffast-math / /fp:fast では足して引く処理が消えるので使えない)
+            using bits_type = std::conditional_t<sizeof(T) == sizeof(std::uint32_t), std::uint32_t, std::uint64_t>;
+            constexpr auto round_shift = static_cast<T>(1.5) * static_cast<T>(bits_type(1) << (std::numeric_limits<T>::digits - 1));
+
+            const auto shifted = radian * two_over_pi + round_shift;
+            const auto q = shifted - round_shift;
+            bits_type bits;
+
+            std::memcpy(&bits, &shifted, sizeof(bits));
+
+            const auto quadrant = static_cast<std::int32_t>(bits & 3);
+            const auto x = ((radian - q * half_pi_1) - q * half_pi_2) - q * half_pi_3;
+            const auto x2 = x * x;
+            const auto x4 = x2 * x2;
+
+            // 依存の連鎖が短くなる様に x2 と x4 の項を並べて求める
+            const auto sin = x + x * x2 * ((sin_1 + x2 * sin_2) + x4 * sin_3);
+            const auto cos = (1 - x2 / 2) + x4 * ((cos_1 + x2 * cos_2) + x4 * cos_3);
+
+            // 象限毎に sin / cos の入れ替えと符号反転を選ぶ(ループの中ではマスクの演算にベクトル化される)
+            const auto swap = (quadrant & 1) != 0;
+            const auto s = swap ? cos : sin;
+            const auto c = swap ? sin : cos;
+
+            return std::make_tuple((quadrant & 2) ? -s : s, ((quadrant + 1) & 2) ? -c : c);
+        }
+
+        // 近似値に Newton 法を 1 回かけて精度を倍にする
+        template <typename T>
+        static T newton_rsqrt(const T value, const T estimate) {
+            return estimate * (static_cast<T>(1.5) - static_cast<T>(0.5) * value * estimate * estimate);
+        }
+
+        // 相対誤差 1.5 * 2^-12 以下の近似値
+        // 整数演算の初期値は相対誤差 1.75e-3 程度なので、Newton 法を 2 回かけて 5e-6 程度にする
+        static float estimate_rsqrt(const float value) {
+#if defined(MATH_FAST_RSQRT_SSE)
+            return _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(value)));
+#else
+            std::uint32_t bits;
+            float estimate;
+
+            std::memcpy(&bits, &value, sizeof(bits));
+            bits = 0x5f375a86u - (bits >> 1);
+            std::memcpy(&estimate, &bits, sizeof(estimate));
+
+            return newton_rsqrt(value, newton_rsqrt(value, estimate));
+#endif
+        }
+    };
+
+    extern template std::tuple<double, double> fast_math::sin_cos_precise<double>(const double);
+    extern template std::tuple<float, float> fast_math::sin_cos_precise<float>(const float);
+    extern template double fast_math::tan<double>(const double);
+    extern template float fast_math::tan<float>(const float);
+    extern template double fast_math::acos<double>(const double);
+    extern template float fast_math::acos<float>(const float);
+}
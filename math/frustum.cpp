@@ -0,0 +1,98 @@
+#include <cmath>
+#include "frustum.h"
+#include "matrix44.h"
+
+namespace {
+    // 射影後の座標 (x, y, z, w) = v * M の列から平面を作る (Gribb-Hartmann)
+    // 列 j の係数を sign 倍して w の列に加える。sign が 0 なら列 j そのもの
+    constexpr struct {
+        int column;
+        int sign;
+    } plane_list[] = {
+        { 0, 1 },  // 左   : w + x >= 0
+        { 0, -1 }, // 右   : w - x >= 0
+        { 1, 1 },  // 下   : w + y >= 0
+        { 1, -1 }, // 上   : w - y >= 0
+        { 2, 0 },  // 近   : z >= 0
+        { 2, -1 }  // 遠   : w - z >= 0
+    };
+}
+
+namespace math {
+
+    template <typename T>
+    basic_frustum<T>::basic_frustum() {
+        planes.fill(0);
+
+        for (auto i = 0; i < plane_num; ++i) {
+            planes[i * 4 + 3] = 1;
+        }
+    }
+
+    template <typename T>
+    basic_frustum<T>::basic_frustum(const basic_matrix44<T>& view_projection) {
+        set(view_projection);
+    }
+
+    template <typename T>
+    void basic_frustum<T>::set(const basic_matrix44<T>& view_projection) {
+        for (auto i = 0; i < plane_num; ++i) {
+            const auto [column, sign] = plane_list[i];
+            auto* plane = planes.data() + i * 4;
+
+            for (auto row = 0; row < row_max; ++row) {
+                const auto value = view_projection.get_value(row, column);
+
+                plane[row] = (sign == 0) ? value : view_projection.get_value(row, 3) + sign * value;
+            }
+
+            const auto length = std::sqrt(plane[0] * plane[0] + plane[1] * plane[1] + plane[2] * plane[2]);
+
+            if (length > 0) {
+                for (auto row = 0; row < row_max; ++row) {
+                    plane[row] /= length;
+                }
+            }
+        }
+    }
+
+    template <typename T>
+    basic_vector4<T> basic_frustum<T>::get_plane(const int index) const {
+        const auto* plane = planes.data() + index * 4;
+
+        return basic_vector4<T>(plane[0], plane[1], plane[2], plane[3]);
+    }
+
+    template <typename T>
+    bool basic_frustum<T>::intersect_sphere(const basic_vector4<T>& center, const T radius) const {
+        for (auto i = 0; i < plane_num; ++i) {
+            const auto* plane = planes.data() + i * 4;
+
+            if (plane[0] * center.get_x() + plane[1] * center.get_y() + plane[2] * center.get_z() + plane[3] < -radius) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    template <typename T>
+    bool basic_frustum<T>::intersect_aabb(const basic_vector4<T>& min, const basic_vector4<T>& max) const {
+        // 平面の法線方向に最も進んだ頂点が外側なら全体が外側
+        for (auto i = 0; i < plane_num; ++i) {
+            const auto* plane = planes.data() + i * 4;
+            const auto x = (plane[0] >= 0) ? max.get_x() : min.get_x();
+            const auto y = (plane[1] >= 0) ? max.get_y() : min.get_y();
+            const auto z = (plane[2] >= 0) ? max.get_z() : min.get_z();
+
+            if (plane[0] * x + plane[1] * y + plane[2] * z + plane[3] < 0) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    template class basic_frustum<double>;
+    template class basic_frustum<float>;
+}
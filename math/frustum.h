@@ -0,0 +1,39 @@
+#pragma once
+#include <array>
+#include "math_fwd.h"
+#include "vector4.h"
+
+namespace math {
+
+    // 視錐台の 6 平面 (左 / 右 / 下 / 上 / 近 / 遠)
+    // 平面は (a, b, c, d) で a * x + b * y + c * z + d >= 0 が内側、(a, b, c) は単位ベクトル
+    template <typename T>
+    class basic_frustum {
+    public:
+        static constexpr auto plane_num = 6;
+
+        // コンストラクタ(平面を設定するまでは全て内側になる)
+        basic_frustum();
+        // ビュー x 射影の行列から平面を取り出す
+        explicit basic_frustum(const basic_matrix44<T>& view_projection);
+        basic_frustum(const basic_frustum&) = default; // コピー
+        basic_frustum(basic_frustum&&) = default; // ムーブ
+
+        basic_frustum& operator =(const basic_frustum&) = default; // コピー
+        basic_frustum& operator =(basic_frustum&&) = default; // ムーブ
+
+        // 射影後の x, y は -w ～ w、z は 0 ～ w (DX ライブラリと同じ左手系)
+        void set(const basic_matrix44<T>& view_projection);
+
+        basic_vector4<T> get_plane(const int index) const;
+        // simd class へ渡す T[24] (平面毎に a, b, c, d)
+        const T* data() const { return planes.data(); }
+
+        // 球 / 軸平行境界箱が視錐台と重なるか(境界付近は重なる扱いになる)
+        bool intersect_sphere(const basic_vector4<T>& center, const T radius) const;
+        bool intersect_aabb(const basic_vector4<T>& min, const basic_vector4<T>& max) const;
+
+    private:
+        std::array<T, plane_num * 4> planes;
+    };
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+namespace math {
+    template <typename T> class basic_vector4;
+    template <typename T> class basic_matrix44;
+    template <typename T> class basic_quaternion;
+    template <typename T> class basic_frustum;
+
+    // 精度が必要な処理は double 版を使用する
+    using vector4 = basic_vector4<double>;
+    using matrix44 = basic_matrix44<double>;
+    using quaternion = basic_quaternion<double>;
+    using frustum = basic_frustum<double>;
+
+    // float 版は DX ライブラリの VECTOR / MATRIX と同じメモリ配置になる
+    using vector4f = basic_vector4<float>;
+    using matrix44f = basic_matrix44<float>;
+    using quaternionf = basic_quaternion<float>;
+    using frustumf = basic_frustum<float>;
+}
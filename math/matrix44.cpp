@@ -2,90 +2,90 @@
 #include "utility.h"
 #include "matrix44.h"
 #include "vector4.h"
+#include "simd.h"
+#include "fast_math.h"
 
 namespace math {
 
-    matrix44::matrix44() {
-        unit();
-    }
+    template <typename T>
+    T basic_matrix44<T>::determinant() const {
+        // 上 2 行と下 2 行の 2x2 小行列式の積和で求める(除算しないので対角成分が 0 でも破綻しない)
+        const auto* m = data();
 
-    matrix44::matrix44(const matrix_array values) {
-        this->row_column = values;
-    }
+        const auto s0 = m[0] * m[5] - m[4] * m[1];
+        const auto s1 = m[0] * m[6] - m[4] * m[2];
+        const auto s2 = m[0] * m[7] - m[4] * m[3];
+        const auto s3 = m[1] * m[6] - m[5] * m[2];
+        const auto s4 = m[1] * m[7] - m[5] * m[3];
+        const auto s5 = m[2] * m[7] - m[6] * m[3];
 
-    void matrix44::zero(matrix_array& target) const {
-        for (auto i = 0; i < column_max; ++i) {
-            target[i].fill(0.0);
-        }
-    }
-
-    void matrix44::unit() {
-        zero(row_column);
+        const auto c0 = m[8] * m[13] - m[12] * m[9];
+        const auto c1 = m[8] * m[14] - m[12] * m[10];
+        const auto c2 = m[8] * m[15] - m[12] * m[11];
+        const auto c3 = m[9] * m[14] - m[13] * m[10];
+        const auto c4 = m[9] * m[15] - m[13] * m[11];
+        const auto c5 = m[10] * m[15] - m[14] * m[11];
 
-        for (auto i = 0; i < column_max; ++i) {
-            row_column[i][i] = 1.0;
-        }
+        return s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
     }
 
-    double matrix44::determinant() const {
-        // Ops쐬čs񎮂߂
-        matrix_array upper_triangular = row_column;
+    template <typename T>
+    basic_matrix44<T> basic_matrix44<T>::get_inverse() const {
+        basic_matrix44 inverse;
 
-        for (auto i = 0; i < column_max; ++i) {
-            for (auto j = 0; j < row_max; ++j) {
-                if (i >= j) {
-                    continue;
-                }
+        if (!try_get_inverse(inverse)) {
+            // 逆行列がない場合は従来の掃き出し法に任せる
+            return get_inverse_gauss_jordan();
+        }
 
-                auto coefficient = upper_triangular[j][i] / upper_triangular[i][i];
+        return inverse;
+    }
 
-                for (auto k = 0; k < row_max; ++k) {
-                    upper_triangular[j][k] -= upper_triangular[i][k] * coefficient;
-                }
-            }
-        }
+    template <typename T>
+    bool basic_matrix44<T>::try_get_inverse(basic_matrix44& result) const {
+        return simd::inverse_cofactor(data(), result.data()) != 0;
+    }
 
-        auto determinant = 1.0;
+    template <typename T>
+    basic_matrix44<T> basic_matrix44<T>::get_inverse_gauss_jordan() const {
+        basic_matrix_array<T> inverse;
 
-        for (auto i = 0; i < column_max; ++i) {
-            determinant *= upper_triangular[i][i];
-        }
+        simd::inverse(data(), inverse[0].data());
 
-        return determinant;
+        return basic_matrix44(inverse);
     }
 
-    matrix44 matrix44::get_inverse() const {
-        // |o@ɂtšvZ
-        matrix_array inverse{ {{1, 0, 0, 0}, {0, 1, 0, 0}, {0, 0, 1, 0}, {0, 0, 0, 1}} };
-        matrix_array temporary = row_column;
+    template <typename T>
+    basic_matrix44<T> basic_matrix44<T>::affine_inverse() const {
+        basic_matrix_array<T> inverse;
 
-        for (auto i = 0; i < column_max; ++i) {
-            auto coefficient = 1.0 / temporary[i][i];
+        // 拡大縮小 x 回転 の各行は直交しているので、行の長さの 2 乗で割った転置が逆行列になる
+        for (auto i = 0; i < 3; ++i) {
+            const auto& row = row_column[i];
+            const auto reciprocal = 1 / (row[0] * row[0] + row[1] * row[1] + row[2] * row[2]);
 
-            for (auto j = 0; j < row_max; ++j) {
-                temporary[i][j] *= coefficient;
-                inverse[i][j] *= coefficient;
+            for (auto j = 0; j < 3; ++j) {
+                inverse[j][i] = row[j] * reciprocal;
             }
 
-            for (auto j = 0; j < row_max; ++j) {
-                if (i == j) {
-                    continue;
-                }
+            inverse[i][3] = 0;
+        }
 
-                coefficient = temporary[j][i];
+        // 平行移動は -t * (拡大縮小 x 回転)^-1
+        const auto& translate = row_column[3];
 
-                for (auto k = 0; k < row_max; ++k) {
-                    temporary[j][k] -= temporary[i][k] * coefficient;
-                    inverse[j][k] -= inverse[i][k] * coefficient;
-                }
-            }
+        for (auto j = 0; j < 3; ++j) {
+            inverse[3][j] = -(translate[0] * inverse[0][j] + translate[1] * inverse[1][j] + translate[2] * inverse[2][j]);
         }
 
-        return matrix44(inverse);
+        inverse[3][3] = 1;
+
+        return basic_matrix44(inverse);
     }
 
-    // {̓Jɑ鏈֋X
-    void matrix44::look_at(const vector4& position, const vector4& target, const vector4& up) {
+    // 本来はカメラに属する処理だが便宜上実装する
+    template <typename T>
+    void basic_matrix44<T>::look_at(const basic_vector4<T>& position, const basic_vector4<T>& target, const basic_vector4<T>& up) {
         auto axis_z = target - position;
         axis_z.normalized();
         auto axis_x = up.cross(axis_z);
@@ -96,26 +96,27 @@ namespace math {
         row_column[0][0] = axis_x.get_x();
         row_column[0][1] = axis_y.get_x();
         row_column[0][2] = axis_z.get_x();
-        row_column[0][3] = 0.0;
+        row_column[0][3] = 0;
 
         row_column[1][0] = axis_x.get_y();
         row_column[1][1] = axis_y.get_y();
         row_column[1][2] = axis_z.get_y();
-        row_column[1][3] = 0.0;
+        row_column[1][3] = 0;
 
         row_column[2][0] = axis_x.get_z();
         row_column[2][1] = axis_y.get_z();
         row_column[2][2] = axis_z.get_z();
-        row_column[2][3] = 0.0;
+        row_column[2][3] = 0;
 
         row_column[3][0] = -axis_x.dot(position);
         row_column[3][1] = -axis_y.dot(position);
         row_column[3][2] = -axis_z.dot(position);
-        row_column[3][3] = 1.0;
+        row_column[3][3] = 1;
     }
 
-    void matrix44::perspective(const double fov_y, const double aspect, const double near_z, const double far_z) {
-        const auto cot = 1.0 / tan(fov_y * 0.5);
+    template <typename T>
+    void basic_matrix44<T>::perspective(const T fov_y, const T aspect, const T near_z, const T far_z) {
+        const auto cot = 1 / fast_math::tan(fov_y / 2);
         const auto range = far_z - near_z;
         const auto temp = far_z / range;
 
@@ -124,13 +125,14 @@ namespace math {
         row_column[0][0] = cot / aspect;
         row_column[1][1] = cot;
         row_column[2][2] = temp;
-        row_column[2][3] = 1.0;
+        row_column[2][3] = 1;
         row_column[3][2] = -near_z * temp;
     }
 
-    void matrix44::viewport(const double width, const double height) {
-        const auto w = width  * 0.5;
-        const auto h = height * 0.5;
+    template <typename T>
+    void basic_matrix44<T>::viewport(const T width, const T height) {
+        const auto w = width  / 2;
+        const auto h = height / 2;
 
         unit();
 
@@ -140,131 +142,26 @@ namespace math {
         row_column[3][1] =  h;
     }
 
-    matrix44 matrix44::operator *(const matrix44 rhs) const {
-        matrix_array result{ {{0, 0, 0, 0}, {0, 0, 0, 0}, {0, 0, 0, 0}, {0, 0, 0, 0}} };
-
-        for (auto i = 0; i < column_max; ++i) {
-            for (auto j = 0; j < row_max; ++j) {
-                auto m = 0.0;
+    template <typename T>
+    basic_matrix44<T> basic_matrix44<T>::compose(const basic_vector4<T>& scale, const basic_matrix44& rotate, const basic_vector4<T>& transfer) {
+        // 行ベクトル形式なので 回転の各行に拡大率を掛けて、平行移動はそのまま 4 行目になる
+        const std::array<T, 3> factor = { scale.get_x(), scale.get_y(), scale.get_z() };
+        basic_matrix_array<T> result;
 
-                for (auto k = 0; k < 4; ++k) {
-                    m += row_column[i][k] * rhs.get_value(k, j);
-                }
-
-                result[i][j] = m;
+        for (auto i = 0; i < 3; ++i) {
+            for (auto j = 0; j < 3; ++j) {
+                result[i][j] = rotate.row_column[i][j] * factor[i];
             }
-        }
-
-        return matrix44(result);
-    }
-
-    matrix44 matrix44::operator +(const vector4 rhs) const {
-        matrix_array result = row_column;
-
-        result[3][0] += rhs.get_x();
-        result[3][1] += rhs.get_y();
-        result[3][2] += rhs.get_z();
-
-        return matrix44(result);
-    }
-
-    void matrix44::transfer(const double x, const double y, const double z, const bool make) {
-        if (make) {
-            unit();
-        }
 
-        row_column[3][0] += x;
-        row_column[3][1] += y;
-        row_column[3][2] += z;
-    }
-
-    void matrix44::scale(const double x, const double y, const double z, const bool make) {
-        if (make) {
-            unit();
-        }
-
-        row_column[0][0] *= x;
-        row_column[1][1] *= y;
-        row_column[2][2] *= z;
-    }
-
-    void matrix44::rotate_x(const double degree, const bool make) {
-        const auto sin_cos = get_sin_cos(degree);
-        const auto sin = std::get<0>(sin_cos);
-        const auto cos = std::get<1>(sin_cos);
-
-        if (make) {
-            unit();
-
-            row_column[1][1] =  cos;
-            row_column[1][2] =  sin;
-            row_column[2][1] = -sin;
-            row_column[2][2] =  cos;
-        }
-        else {
-            matrix_array array{ {{1, 0, 0, 0}, {0, cos, sin, 0}, {0, -sin, cos, 0}, {0, 0, 0, 1}} };
-            matrix44 rot_x(array);
-
-            *this = *this * rot_x;
-        }
-    }
-
-    void matrix44::rotate_y(const double degree, const bool make) {
-        const auto sin_cos = get_sin_cos(degree);
-        const auto sin = std::get<0>(sin_cos);
-        const auto cos = std::get<1>(sin_cos);
-
-        if (make) {
-            unit();
-
-            row_column[0][0] =  cos;
-            row_column[0][2] = -sin;
-            row_column[2][0] =  sin;
-            row_column[2][2] =  cos;
-        }
-        else {
-            matrix_array array{ {{cos, 0, -sin, 0}, {0, 1, 0, 0}, {sin, 0, cos, 0}, {0, 0, 0, 1}} };
-            matrix44 rot_y(array);
-
-            *this = *this * rot_y;
-        }
-    }
-
-    void matrix44::rotate_z(const double degree, const bool make) {
-        const auto sin_cos = get_sin_cos(degree);
-        const auto sin = std::get<0>(sin_cos);
-        const auto cos = std::get<1>(sin_cos);
-
-        if (make) {
-            unit();
-
-            row_column[0][0] =  cos;
-            row_column[0][1] =  sin;
-            row_column[1][0] = -sin;
-            row_column[1][1] =  cos;
-        }
-        else {
-            matrix_array array{ {{cos, sin, 0, 0}, {-sin, cos, 0, 0}, {0, 0, 1, 0}, {0, 0, 0, 1}} };
-            matrix44 rot_z(array);
-
-            *this = *this * rot_z;
+            result[i][3] = 0;
         }
-    }
 
-    matrix44 matrix44::get_rotate() const {
-        matrix_array none_transfer = row_column;
+        result[3] = { transfer.get_x(), transfer.get_y(), transfer.get_z(), 1 };
 
-        none_transfer[3][0] = 0.0;
-        none_transfer[3][1] = 0.0;
-        none_transfer[3][2] = 0.0;
-
-        return matrix44(none_transfer);
+        return basic_matrix44(result);
     }
 
-    std::tuple<double, double> matrix44::get_sin_cos(const double degree) const {
-        const auto radian = utility::degree_to_radian(degree);
-
-        return std::make_tuple(std::sin(radian), std::cos(radian));
-    }
+    template class basic_matrix44<double>;
+    template class basic_matrix44<float>;
 
 }
@@ -2,57 +2,256 @@
 
 #include <array>
 #include <tuple>
+#include <type_traits>
+#include "math_fwd.h"
+#include "simd.h"
+#include "vector4.h"
+#include "utility.h"
+#include "fast_math.h"
+#include "constexpr_math.h"
 
 namespace math {
-    class vector4;
-
     constexpr auto row_max = 4;
     constexpr auto column_max = 4;
 
-    using matrix_array = std::array<std::array<double, row_max>, column_max>;
+    template <typename T>
+    using basic_matrix_array = std::array<std::array<T, row_max>, column_max>;
+
+    using matrix_array = basic_matrix_array<double>;
+
+    // simd class へ連続した T[16] として渡す
+    static_assert(sizeof(basic_matrix_array<double>) == sizeof(double) * row_max * column_max);
+    static_assert(sizeof(basic_matrix_array<float>) == sizeof(float) * row_max * column_max);
 
-    class matrix44 {
+    // 仮想関数を持たない値型 (double は 32 byte、float は 16 byte 境界に配置する)
+    template <typename T>
+    class alignas(sizeof(T) * 4) basic_matrix44 {
     public:
-        // RXgN^
-        matrix44();
-        matrix44(const matrix_array values);
-        matrix44(const matrix44&) = default; // Rs[
-        matrix44(matrix44&&) = default; // [u
+        using value_type = T;
+
+        // コンストラクタ
+        // 生成と回転 / 拡大縮小 / 平行移動、乗算は constexpr なので定数の行列はコンパイル時に作れる
+        constexpr basic_matrix44() : row_column{} { unit(); }
+        constexpr basic_matrix44(const basic_matrix_array<T> values) : row_column(values) {}
+        basic_matrix44(const basic_matrix44&) = default; // コピー
+        basic_matrix44(basic_matrix44&&) = default; // ムーブ
+
+        // 精度の違う型からの変換
+        template <typename U>
+        constexpr explicit basic_matrix44(const basic_matrix44<U>& matrix) : row_column{} {
+            for (auto i = 0; i < row_max; ++i) {
+                for (auto j = 0; j < column_max; ++j) {
+                    row_column[i][j] = static_cast<T>(matrix.get_value(i, j));
+                }
+            }
+        }
+
+        basic_matrix44& operator =(const basic_matrix44&) = default; // コピー
+        basic_matrix44& operator =(basic_matrix44&&) = default; // ムーブ
+
+        constexpr basic_matrix44 operator *(const basic_matrix44& rhs) const {
+            basic_matrix_array<T> result;
+
+            if (std::is_constant_evaluated()) {
+                // コンパイル時は SIMD の関数を呼べないので素直に計算する
+                for (auto i = 0; i < row_max; ++i) {
+                    for (auto j = 0; j < column_max; ++j) {
+                        result[i][j] = row_column[i][0] * rhs.row_column[0][j] + row_column[i][1] * rhs.row_column[1][j]
+                                     + row_column[i][2] * rhs.row_column[2][j] + row_column[i][3] * rhs.row_column[3][j];
+                    }
+                }
+            }
+            else {
+                simd::multiply(data(), rhs.data(), result[0].data());
+            }
+
+            return basic_matrix44(result);
+        }
+
+        constexpr basic_matrix44 operator +(const basic_vector4<T>& rhs) const {
+            basic_matrix_array<T> result = row_column;
+
+            result[3][0] += rhs.get_x();
+            result[3][1] += rhs.get_y();
+            result[3][2] += rhs.get_z();
+
+            return basic_matrix44(result);
+        }
+
+        // m0 * m1 * ... を途中の basic_matrix44 を作らずに 1 つの作業領域で計算する
+        template <typename... Rest>
+        static basic_matrix44 multiply(const basic_matrix44& lhs, const basic_matrix44& rhs, const Rest&... rest) {
+            basic_matrix_array<T> result;
+            auto* values = result[0].data();
+
+            simd::multiply(lhs.data(), rhs.data(), values);
+            (simd::multiply(values, rest.data(), values), ...);
+
+            return basic_matrix44(result);
+        }
+
+        // 拡大縮小 x 回転 x 平行移動 を乗算せずに組み立てる(rotate は平行移動を含まない回転行列)
+        static basic_matrix44 compose(const basic_vector4<T>& scale, const basic_matrix44& rotate, const basic_vector4<T>& transfer);
+
+        constexpr T get_value(const int row, const int column) const { return row_column[row][column]; }
+        constexpr void set_value(const int row, const int column, const T value) { row_column[row][column] = value; }
+
+        // 行優先で連続した T[16]
+        const T* data() const { return row_column[0].data(); }
+        T* data() { return row_column[0].data(); }
+
+        constexpr void zero(basic_matrix_array<T>& target) const {
+            for (auto i = 0; i < column_max; ++i) {
+                target[i].fill(0);
+            }
+        }
+
+        constexpr void unit() {
+            zero(row_column);
+
+            for (auto i = 0; i < column_max; ++i) {
+                row_column[i][i] = 1;
+            }
+        }
 
-        // fXgN^
-        virtual ~matrix44() = default;
+        T determinant() const;
+        // 余因子による逆行列
+        // 行列式が 0 (逆行列がない) 場合は掃き出し法と同じ結果(inf / NaN を含む)を返す
+        // double は avx2 でのみ SIMD 版になる (sse2 では scalar 版の方が速いため)
+        basic_matrix44 get_inverse() const;
+        // 余因子による逆行列(行列式が 0 なら false を返し、result は書き換えない)
+        bool try_get_inverse(basic_matrix44& result) const;
+        // 部分軸選択付きの掃き出し法による逆行列
+        basic_matrix44 get_inverse_gauss_jordan() const;
+        // 拡大縮小 x 回転 x 平行移動 の順で合成した行列専用の逆行列(ビュー行列や姿勢行列向け)
+        basic_matrix44 affine_inverse() const;
 
-        matrix44& operator =(const matrix44&) = default; // Rs[
-        matrix44& operator =(matrix44&&) = default; // [u
+        void look_at(const basic_vector4<T>& position, const basic_vector4<T>& target, const basic_vector4<T>& up);
+        void perspective(const T fov_y, const T aspect, const T near_z, const T far_z);
+        void viewport(const T width, const T height);
 
-        matrix44 operator *(const matrix44 rhs) const;
-        matrix44 operator +(const vector4 rhs) const;
+        constexpr void transfer(const T x, const T y, const T z, const bool make) {
+            if (make) {
+                unit();
+            }
 
-        double get_value(const int row, const int column) const { return row_column[row][column]; }
-        void set_value(const int row, const int column, const double value) { row_column[row][column] = value; }
+            row_column[3][0] += x;
+            row_column[3][1] += y;
+            row_column[3][2] += z;
+        }
 
-        void zero(matrix_array& target) const;
-        void unit();
+        constexpr void scale(const T x, const T y, const T z, const bool make) {
+            if (make) {
+                unit();
+            }
 
-        double determinant() const;
-        matrix44 get_inverse() const;
+            row_column[0][0] *= x;
+            row_column[1][1] *= y;
+            row_column[2][2] *= z;
+        }
 
-        void look_at(const vector4& position, const vector4& target, const vector4& up);
-        void perspective(const double fov_y, const double aspect, const double near_z, const double far_z);
-        void viewport(const double width, const double height);
+        constexpr void rotate_x(const T degree, const bool make) {
+            const auto [sin, cos] = get_sin_cos(degree);
 
-        void transfer(const double x, const double y, const double z, const bool make);
-        void scale(const double x, const double y, const double z, const bool make);
-        void rotate_x(const double degree, const bool make);
-        void rotate_y(const double degree, const bool make);
-        void rotate_z(const double degree, const bool make);
+            if (make) {
+                unit();
 
-        matrix44 get_rotate() const;
+                row_column[1][1] =  cos;
+                row_column[1][2] =  sin;
+                row_column[2][1] = -sin;
+                row_column[2][2] =  cos;
+            }
+            else {
+                basic_matrix_array<T> array{ {{1, 0, 0, 0}, {0, cos, sin, 0}, {0, -sin, cos, 0}, {0, 0, 0, 1}} };
+                basic_matrix44 rot_x(array);
+
+                *this = *this * rot_x;
+            }
+        }
+
+        constexpr void rotate_y(const T degree, const bool make) {
+            const auto [sin, cos] = get_sin_cos(degree);
+
+            if (make) {
+                unit();
+
+                row_column[0][0] =  cos;
+                row_column[0][2] = -sin;
+                row_column[2][0] =  sin;
+                row_column[2][2] =  cos;
+            }
+            else {
+                basic_matrix_array<T> array{ {{cos, 0, -sin, 0}, {0, 1, 0, 0}, {sin, 0, cos, 0}, {0, 0, 0, 1}} };
+                basic_matrix44 rot_y(array);
+
+                *this = *this * rot_y;
+            }
+        }
+
+        constexpr void rotate_z(const T degree, const bool make) {
+            const auto [sin, cos] = get_sin_cos(degree);
+
+            if (make) {
+                unit();
+
+                row_column[0][0] =  cos;
+                row_column[0][1] =  sin;
+                row_column[1][0] = -sin;
+                row_column[1][1] =  cos;
+            }
+            else {
+                basic_matrix_array<T> array{ {{cos, sin, 0, 0}, {-sin, cos, 0, 0}, {0, 0, 1, 0}, {0, 0, 0, 1}} };
+                basic_matrix44 rot_z(array);
+
+                *this = *this * rot_z;
+            }
+        }
+
+        constexpr basic_matrix44 get_rotate() const {
+            basic_matrix_array<T> none_transfer = row_column;
+
+            none_transfer[3][0] = 0;
+            none_transfer[3][1] = 0;
+            none_transfer[3][2] = 0;
+
+            return basic_matrix44(none_transfer);
+        }
+
+        constexpr basic_matrix44 get_transpose() const {
+            basic_matrix_array<T> transpose{};
+
+            for (auto i = 0; i < row_max; ++i) {
+                for (auto j = 0; j < column_max; ++j) {
+                    transpose[j][i] = row_column[i][j];
+                }
+            }
+
+            return basic_matrix44(transpose);
+        }
 
     private:
-        std::tuple<double, double> get_sin_cos(const double degree) const;
+        constexpr std::tuple<T, T> get_sin_cos(const T degree) const {
+            const auto radian = utility::degree_to_radian(degree);
 
-        matrix_array row_column;
+            if (std::is_constant_evaluated()) {
+                const auto [sin, cos] = constexpr_math::sin_cos(radian);
+
+                return { static_cast<T>(sin), static_cast<T>(cos) };
+            }
+
+            return fast_math::sin_cos(static_cast<T>(radian));
+        }
+
+        basic_matrix_array<T> row_column;
     };
 
+    extern template class basic_matrix44<double>;
+    extern template class basic_matrix44<float>;
+
+    // 各行を SIMD のアラインメント付きロードで扱え、配列は memcpy でまとめてコピーできる事
+    static_assert(sizeof(matrix44) == sizeof(double) * row_max * column_max && alignof(matrix44) == 32);
+    static_assert(sizeof(matrix44f) == sizeof(float) * row_max * column_max && alignof(matrix44f) == 16);
+    static_assert(std::is_trivially_copyable_v<matrix44> && std::is_standard_layout_v<matrix44>);
+    static_assert(std::is_trivially_copyable_v<matrix44f> && std::is_standard_layout_v<matrix44f>);
+
 }
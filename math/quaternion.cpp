@@ -0,0 +1,171 @@
+#include <cmath>
+#include <limits>
+#include "utility.h"
+#include "fast_math.h"
+#include "quaternion.h"
+#include "matrix44.h"
+#include "vector4.h"
+
+namespace {
+    // これ以上近い場合は slerp を lerp で代用する
+    constexpr auto slerp_threshold = 0.9995;
+    // from_to で真逆とみなす 1 + dot の大きさ (型の精度の倍数)
+    constexpr auto antiparallel_scale = 16;
+}
+
+namespace math {
+
+    template <typename T>
+    basic_quaternion<T> basic_quaternion<T>::operator *(const basic_quaternion& rhs) const {
+        // rhs * lhs のハミルトン積
+        return basic_quaternion(rhs.w * x + rhs.x * w + rhs.y * z - rhs.z * y,
+                                rhs.w * y - rhs.x * z + rhs.y * w + rhs.z * x,
+                                rhs.w * z + rhs.x * y - rhs.y * x + rhs.z * w,
+                                rhs.w * w - rhs.x * x - rhs.y * y - rhs.z * z);
+    }
+
+    template <typename T>
+    basic_quaternion<T> basic_quaternion<T>::from_euler(const T x, const T y, const T z) {
+        // 3 軸の回転を合成した式を展開して行列の乗算をしない
+        const auto half_x = static_cast<T>(utility::degree_to_radian(x)) / 2;
+        const auto half_y = static_cast<T>(utility::degree_to_radian(y)) / 2;
+        const auto half_z = static_cast<T>(utility::degree_to_radian(z)) / 2;
+        const auto [sx, cx] = fast_math::sin_cos(half_x);
+        const auto [sy, cy] = fast_math::sin_cos(half_y);
+        const auto [sz, cz] = fast_math::sin_cos(half_z);
+
+        return basic_quaternion(sx * cy * cz - cx * sy * sz,
+                                cx * sy * cz + sx * cy * sz,
+                                cx * cy * sz - sx * sy * cz,
+                                cx * cy * cz + sx * sy * sz);
+    }
+
+    template <typename T>
+    basic_quaternion<T> basic_quaternion<T>::from_axis_angle(const basic_vector4<T>& axis, const T degree) {
+        const auto unit = axis.normalize();
+        const auto half = static_cast<T>(utility::degree_to_radian(degree)) / 2;
+        const auto [sin, cos] = fast_math::sin_cos(half);
+
+        return basic_quaternion(unit.get_x() * sin, unit.get_y() * sin, unit.get_z() * sin, cos);
+    }
+
+    template <typename T>
+    basic_quaternion<T> basic_quaternion<T>::from_to(const basic_vector4<T>& from, const basic_vector4<T>& to) {
+        const auto d = from.dot(to);
+
+        // 真逆 (d が -1 に近い) の場合は from に直交する任意の軸で 180 度回転する
+        // それ以外は 180 度近くでも半分の角度の式で求まるので、閾値は型の精度で決める
+        if (d < std::numeric_limits<T>::epsilon() * antiparallel_scale - 1) {
+            auto axis = basic_vector4<T>(1, 0, 0).cross(from);
+
+            if (axis.length() < static_cast<T>(1.0 - slerp_threshold)) {
+                axis = basic_vector4<T>(0, 1, 0).cross(from);
+            }
+
+            return from_axis_angle(axis, static_cast<T>(utility::DEGREES_180));
+        }
+
+        const auto axis = from.cross(to);
+
+        return basic_quaternion(axis.get_x(), axis.get_y(), axis.get_z(), 1 + d).normalize();
+    }
+
+    template <typename T>
+    basic_quaternion<T> basic_quaternion<T>::lerp(const basic_quaternion& from, const basic_quaternion& to, const T t) {
+        // q と -q は同じ回転なので近い方へ補間する
+        const T sign = from.dot(to) < 0 ? -1 : 1;
+        const auto s = 1 - t;
+        const auto u = t * sign;
+
+        return basic_quaternion(from.x * s + to.x * u, from.y * s + to.y * u,
+                                from.z * s + to.z * u, from.w * s + to.w * u).normalize();
+    }
+
+    template <typename T>
+    basic_quaternion<T> basic_quaternion<T>::slerp(const basic_quaternion& from, const basic_quaternion& to, const T t) {
+        auto cos = from.dot(to);
+        T sign = 1;
+
+        if (cos < 0) {
+            cos = -cos;
+            sign = -1;
+        }
+
+        if (cos > static_cast<T>(slerp_threshold)) {
+            return lerp(from, to, t);
+        }
+
+        const auto theta = fast_math::acos(cos);
+        const auto sin = std::get<0>(fast_math::sin_cos(theta, math_mode::precise));
+        const auto s = std::get<0>(fast_math::sin_cos((1 - t) * theta, math_mode::precise)) / sin;
+        const auto u = std::get<0>(fast_math::sin_cos(t * theta, math_mode::precise)) / sin * sign;
+
+        return basic_quaternion(from.x * s + to.x * u, from.y * s + to.y * u,
+                                from.z * s + to.z * u, from.w * s + to.w * u);
+    }
+
+    template <typename T>
+    T basic_quaternion<T>::length() const {
+        return std::sqrt(dot(*this));
+    }
+
+    template <typename T>
+    void basic_quaternion<T>::normalized() {
+        const auto len = length();
+
+        if (len > 0) {
+            x /= len;
+            y /= len;
+            z /= len;
+            w /= len;
+        }
+    }
+
+    template <typename T>
+    basic_quaternion<T> basic_quaternion<T>::normalize() const {
+        auto result = *this;
+
+        result.normalized();
+
+        return result;
+    }
+
+    template <typename T>
+    T basic_quaternion<T>::dot(const basic_quaternion& rhs) const {
+        return x * rhs.x + y * rhs.y + z * rhs.z + w * rhs.w;
+    }
+
+    template <typename T>
+    basic_matrix44<T> basic_quaternion<T>::to_matrix() const {
+        // 行ベクトル形式なので各行が回転後の x / y / z 軸になる
+        const auto xx = x * x * 2, yy = y * y * 2, zz = z * z * 2;
+        const auto xy = x * y * 2, xz = x * z * 2, yz = y * z * 2;
+        const auto wx = w * x * 2, wy = w * y * 2, wz = w * z * 2;
+
+        basic_matrix_array<T> array{ {
+            {1 - yy - zz, xy + wz, xz - wy, 0},
+            {xy - wz, 1 - xx - zz, yz + wx, 0},
+            {xz + wy, yz - wx, 1 - xx - yy, 0},
+            {0, 0, 0, 1}
+        } };
+
+        return basic_matrix44<T>(array);
+    }
+
+    template <typename T>
+    basic_vector4<T> basic_quaternion<T>::rotate(const basic_vector4<T>& vector) const {
+        // v' = v + w * t + q x t (t = 2 * q x v)
+        const auto vx = vector.get_x(), vy = vector.get_y(), vz = vector.get_z();
+        const auto tx = (y * vz - z * vy) * 2;
+        const auto ty = (z * vx - x * vz) * 2;
+        const auto tz = (x * vy - y * vx) * 2;
+
+        return basic_vector4<T>(vx + w * tx + (y * tz - z * ty),
+                                vy + w * ty + (z * tx - x * tz),
+                                vz + w * tz + (x * ty - y * tx), vector.get_w());
+    }
+
+    template class basic_quaternion<double>;
+    template class basic_quaternion<float>;
+
+}
@@ -0,0 +1,75 @@
+#pragma once
+#include <type_traits>
+#include "math_fwd.h"
+
+namespace math {
+
+    // 回転を表すクォータニオン (x, y, z がベクトル部、w がスカラー部)
+    // 角度は matrix44 と同じく度で指定する
+    template <typename T>
+    class alignas(sizeof(T) * 4) basic_quaternion {
+    public:
+        using value_type = T;
+
+        // コンストラクタ(回転なし)
+        basic_quaternion() : x(0), y(0), z(0), w(1) {}
+        basic_quaternion(const T x, const T y, const T z, const T w) : x(x), y(y), z(z), w(w) {}
+        basic_quaternion(const basic_quaternion&) = default; // コピー
+        basic_quaternion(basic_quaternion&&) = default; // ムーブ
+
+        // 精度の違う型からの変換
+        template <typename U>
+        explicit basic_quaternion(const basic_quaternion<U>& quaternion)
+            : x(static_cast<T>(quaternion.get_x())), y(static_cast<T>(quaternion.get_y())),
+              z(static_cast<T>(quaternion.get_z())), w(static_cast<T>(quaternion.get_w())) {}
+
+        basic_quaternion& operator =(const basic_quaternion&) = default; // コピー
+        basic_quaternion& operator =(basic_quaternion&&) = default; // ムーブ
+
+        // 行列と同じく lhs の回転の後に rhs の回転を行う
+        basic_quaternion operator *(const basic_quaternion& rhs) const;
+
+        // matrix44 の rotate_x(x, true) -> rotate_y(y, false) -> rotate_z(z, false) と同じ回転
+        static basic_quaternion from_euler(const T x, const T y, const T z);
+        static basic_quaternion from_axis_angle(const basic_vector4<T>& axis, const T degree);
+        // 単位ベクトル from を to へ向ける最短の回転
+        static basic_quaternion from_to(const basic_vector4<T>& from, const basic_vector4<T>& to);
+
+        // 線形補間して正規化する(回転の速度は一定ではないが軽い)
+        static basic_quaternion lerp(const basic_quaternion& from, const basic_quaternion& to, const T t);
+        // 球面線形補間
+        static basic_quaternion slerp(const basic_quaternion& from, const basic_quaternion& to, const T t);
+
+        T get_x() const { return x; }
+        T get_y() const { return y; }
+        T get_z() const { return z; }
+        T get_w() const { return w; }
+
+        T length() const;
+
+        void normalized();
+        basic_quaternion normalize() const;
+        basic_quaternion conjugate() const { return basic_quaternion(-x, -y, -z, w); }
+
+        T dot(const basic_quaternion& rhs) const;
+
+        // 回転行列へ展開する(平行移動は 0)
+        basic_matrix44<T> to_matrix() const;
+        // ベクトルを回転する(w はそのまま)
+        basic_vector4<T> rotate(const basic_vector4<T>& vector) const;
+
+    private:
+        T x;
+        T y;
+        T z;
+        T w;
+    };
+
+    extern template class basic_quaternion<double>;
+    extern template class basic_quaternion<float>;
+
+    static_assert(sizeof(quaternion) == sizeof(double) * 4 && alignof(quaternion) == 32);
+    static_assert(sizeof(quaternionf) == sizeof(float) * 4 && alignof(quaternionf) == 16);
+    static_assert(std::is_trivially_copyable_v<quaternion> && std::is_trivially_copyable_v<quaternionf>);
+
+} // math
@@ -0,0 +1,117 @@
+#include <atomic>
+#include <random>
+#include "random.h"
+
+namespace {
+    // xoshiro256 の 2^128 回分の jump 多項式
+    constexpr std::uint64_t jump_polynomial[] = {
+        0x180ec6d33cfd0abaull, 0xd5a61266f0c9392cull, 0xa9582618e03fc9aaull, 0x39abdc4529b1661cull
+    };
+
+    std::uint64_t make_random_seed() {
+        std::random_device device;
+
+        return (static_cast<std::uint64_t>(device()) << 32) ^ device();
+    }
+
+    // 関数内 static にして他の翻訳単位の静的初期化から呼ばれても初期化済みにする
+    std::atomic<std::uint64_t>& master_seed() {
+        static std::atomic<std::uint64_t> seed(make_random_seed());
+
+        return seed;
+    }
+
+    // set_seed する度に進めて、各スレッドの系列を作り直させる
+    std::atomic<std::uint32_t>& seed_generation() {
+        static std::atomic<std::uint32_t> generation(1);
+
+        return generation;
+    }
+
+    std::atomic<std::size_t>& next_stream() {
+        static std::atomic<std::size_t> stream(0);
+
+        return stream;
+    }
+
+    struct thread_stream {
+        math::random::engine engine;
+        std::uint32_t generation = 0; // 0 は未作成
+        std::size_t stream = 0;
+        bool fixed = false;           // set_stream で指定された
+    };
+
+    thread_stream& current() {
+        thread_local thread_stream stream;
+
+        return stream;
+    }
+}
+
+namespace math {
+
+    void xoshiro256::jump() {
+        std::uint64_t jumped[4] = { 0, 0, 0, 0 };
+
+        for (const auto polynomial : jump_polynomial) {
+            for (auto bit = 0; bit < 64; ++bit) {
+                if ((polynomial & (1ull << bit)) != 0) {
+                    for (auto i = 0; i < 4; ++i) {
+                        jumped[i] ^= state[i];
+                    }
+                }
+
+                (*this)();
+            }
+        }
+
+        for (auto i = 0; i < 4; ++i) {
+            state[i] = jumped[i];
+        }
+    }
+
+    void random::set_seed(const std::uint64_t seed) {
+        master_seed() = seed;
+        next_stream() = 0;
+        ++seed_generation();
+    }
+
+    std::uint64_t random::get_seed() {
+        return master_seed();
+    }
+
+    random::engine& random::get_engine() {
+        auto& local = current();
+        const auto generation = seed_generation().load();
+
+        if (local.generation != generation) {
+            if (!local.fixed) {
+                local.stream = next_stream()++;
+            }
+
+            local.engine = make_engine(local.stream);
+            local.generation = generation;
+        }
+
+        return local.engine;
+    }
+
+    void random::set_stream(const std::size_t stream) {
+        auto& local = current();
+
+        local.stream = stream;
+        local.fixed = true;
+        local.engine = make_engine(stream);
+        local.generation = seed_generation();
+    }
+
+    random::engine random::make_engine(const std::size_t stream) {
+        engine result(master_seed());
+
+        for (std::size_t i = 0; i < stream; ++i) {
+            result.jump();
+        }
+
+        return result;
+    }
+}
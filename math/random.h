@@ -0,0 +1,172 @@
+#pragma once
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include "batch.h"
+#include "fast_math.h"
+
+namespace math {
+
+    // xoshiro256** (周期 2^256 - 1、std::mt19937_64 より状態が小さく高速)
+    // UniformRandomBitGenerator なので std の分布にも渡せる
+    class xoshiro256 {
+    public:
+        using result_type = std::uint64_t;
+
+        explicit xoshiro256(const std::uint64_t seed = 0) { this->seed(seed); }
+
+        // 状態は splitmix64 で seed から作る(0 だけの状態にならない)
+        void seed(std::uint64_t seed) {
+            for (auto& value : state) {
+                value = split_mix(seed);
+            }
+        }
+
+        static constexpr result_type min() { return 0; }
+        static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+        result_type operator ()() {
+            const auto result = rotate_left(state[1] * 5, 7) * 9;
+            const auto t = state[1] << 17;
+
+            state[2] ^= state[0];
+            state[3] ^= state[1];
+            state[1] ^= state[2];
+            state[0] ^= state[3];
+            state[2] ^= t;
+            state[3] = rotate_left(state[3], 45);
+
+            return result;
+        }
+
+        // 2^128 回分進める(jump した系列同士は重ならないのでスレッド毎の系列に使う)
+        void jump();
+
+    private:
+        static constexpr std::uint64_t rotate_left(const std::uint64_t x, const int k) { return (x << k) | (x >> (64 - k)); }
+
+        static std::uint64_t split_mix(std::uint64_t& x) {
+            auto z = (x += 0x9e3779b97f4a7c15ull);
+
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+
+            return z ^ (z >> 31);
+        }
+
+        std::uint64_t state[4];
+    };
+
+    // スレッド毎の乱数の系列と一括生成
+    // 系列は 1 つのマスターシードから stream 番号分 jump して作るので、同じシードと番号なら同じ乱数列になる
+    class random {
+    public:
+        using engine = xoshiro256;
+
+        // マスターシード(初期値は std::random_device)。変更すると各スレッドは次の呼び出しで系列を作り直す
+        static void set_seed(const std::uint64_t seed);
+        static std::uint64_t get_seed();
+
+        // 呼び出したスレッドの生成器(set_stream していなければ最初に使った順に stream 番号を割り当てる)
+        static engine& get_engine();
+        // 呼び出したスレッドの系列を stream 番目にする(ワーカー番号を渡すと再現性がある)
+        static void set_stream(const std::size_t stream);
+        // マスターシードの stream 番目の系列の生成器
+        static engine make_engine(const std::size_t stream);
+
+        // [min, max] の整数 / [min, max) の実数
+        static int get_int(const int min, const int max) { return get_int(get_engine(), min, max); }
+        static double get_real(const double min, const double max) { return get_real(get_engine(), min, max); }
+
+        template <typename Engine>
+        static int get_int(Engine& engine, const int min, const int max) {
+            const auto range = static_cast<std::uint32_t>(static_cast<std::int64_t>(max) - min) + 1;
+
+            // 0 ならば int の全範囲
+            if (range == 0) {
+                return static_cast<int>(static_cast<std::uint32_t>(engine() >> 32));
+            }
+
+            return static_cast<int>(static_cast<std::int64_t>(min) + bounded(engine, range));
+        }
+
+        template <typename T, typename Engine>
+        static T get_real(Engine& engine, const T min, const T max) {
+            return min + (max - min) * unit_real<T>(engine());
+        }
+
+        // 一括生成(分布のオブジェクトを作らずにループ内で変換する)
+        template <typename Engine>
+        static void fill(Engine& engine, const std::span<int> values, const int min, const int max) {
+            for (auto& value : values) {
+                value = get_int(engine, min, max);
+            }
+        }
+
+        template <typename T, typename Engine>
+        static void fill(Engine& engine, const std::span<T> values, const T min, const T max) {
+            const auto width = max - min;
+
+            for (auto& value : values) {
+                value = min + width * unit_real<T>(engine());
+            }
+        }
+
+        // 球面上に一様な単位ベクトル
+        template <typename T, typename Engine>
+        static void fill_unit_vector(Engine& engine, const basic_soa_span<T>& vectors) {
+            constexpr auto two_pi = static_cast<T>(6.28318530717958647692);
+
+            for (std::size_t i = 0; i < vectors.size(); ++i) {
+                const auto z = 2 * unit_real<T>(engine()) - 1;
+                const auto [sin, cos] = fast_math::sin_cos(two_pi * unit_real<T>(engine()));
+                const auto radius = std::sqrt(1 - z * z);
+
+                vectors.x[i] = radius * cos;
+                vectors.y[i] = radius * sin;
+                vectors.z[i] = z;
+            }
+        }
+
+        // 呼び出したスレッドの生成器を使う
+        static void fill(const std::span<int> values, const int min, const int max) { fill(get_engine(), values, min, max); }
+        static void fill(const std::span<float> values, const float min, const float max) { fill(get_engine(), values, min, max); }
+        static void fill(const std::span<double> values, const double min, const double max) { fill(get_engine(), values, min, max); }
+        template <typename T>
+        static void fill_unit_vector(const basic_soa_span<T>& vectors) { fill_unit_vector(get_engine(), vectors); }
+
+    private:
+        random() = default;
+
+        // [0, range) の整数(上位 32bit の乗算で剰余を使わず、偏りが出る範囲だけ引き直す)
+        template <typename Engine>
+        static std::uint32_t bounded(Engine& engine, const std::uint32_t range) {
+            auto product = static_cast<std::uint64_t>(static_cast<std::uint32_t>(engine() >> 32)) * range;
+            auto low = static_cast<std::uint32_t>(product);
+
+            if (low < range) {
+                const auto threshold = static_cast<std::uint32_t>(0u - range) % range;
+
+                while (low < threshold) {
+                    product = static_cast<std::uint64_t>(static_cast<std::uint32_t>(engine() >> 32)) * range;
+                    low = static_cast<std::uint32_t>(product);
+                }
+            }
+
+            return static_cast<std::uint32_t>(product >> 32);
+        }
+
+        // 上位ビットから [0, 1) の実数を作る(double は 53bit、float は 24bit)
+        template <typename T>
+        static T unit_real(const std::uint64_t bits) {
+            if constexpr (sizeof(T) > sizeof(float)) {
+                return static_cast<T>(bits >> 11) * static_cast<T>(1.0 / 9007199254740992.0);
+            }
+            else {
+                return static_cast<T>(bits >> 40) * static_cast<T>(1.0 / 16777216.0);
+            }
+        }
+    };
+}
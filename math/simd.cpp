@@ -0,0 +1,1416 @@
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <utility>
+#include "simd.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define MATH_SIMD_X86
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+// MSVC は /arch 指定なしでも AVX2 の組み込み関数を使用できる
+#define MATH_TARGET_AVX2
+#else
+#define MATH_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#endif
+#endif
+
+namespace {
+    constexpr auto element_num = 16;
+
+    template <typename T>
+    using multiply_function = void(*)(const T*, const T*, T*);
+    template <typename T>
+    using inverse_function = void(*)(const T*, T*);
+    template <typename T>
+    using inverse_cofactor_function = T(*)(const T*, T*);
+    template <typename T>
+    using transform_soa_function = void(*)(const T*, const T*, const T*, const T*, T*, T*, T*, const std::size_t, const bool);
+    template <typename T>
+    using intersect_function = std::size_t(*)(const T*, const T*, const T* const*, const std::size_t, const std::size_t, T&);
+    template <typename T>
+    using inside_triangle_function = void(*)(const T*, const T*, const T*, const T*, bool*, const std::size_t);
+    template <typename T>
+    using cull_bounds_function = void(*)(const T*, const T* const*, bool*, const std::size_t, const std::size_t);
+
+    struct kernel_table {
+        math::simd_level level;
+        multiply_function<double> multiply;
+        inverse_function<double> inverse;
+        multiply_function<float> multiply_f;
+        inverse_function<float> inverse_f;
+        transform_soa_function<double> transform_soa;
+        transform_soa_function<float> transform_soa_f;
+        inverse_cofactor_function<double> inverse_cofactor;
+        inverse_cofactor_function<float> inverse_cofactor_f;
+        intersect_function<double> intersect_segment_triangle;
+        intersect_function<float> intersect_segment_triangle_f;
+        inside_triangle_function<double> inside_triangle;
+        inside_triangle_function<float> inside_triangle_f;
+        cull_bounds_function<double> cull_bounds;
+        cull_bounds_function<float> cull_bounds_f;
+    };
+
+    // ========================================================================================================
+    // scalar
+
+    // 部分軸選択 : column 列で絶対値が最大の行を column 行目以降から探す
+    // 対角成分が 0 になる行列(90 度回転など)でも破綻しない様にする
+    template <typename T>
+    int find_pivot(const T* matrix, const int column) {
+        auto pivot_row = column;
+
+        for (auto j = column + 1; j < 4; ++j) {
+            if (std::abs(matrix[j * 4 + column]) > std::abs(matrix[pivot_row * 4 + column])) {
+                pivot_row = j;
+            }
+        }
+
+        return pivot_row;
+    }
+
+    template <typename T>
+    void inverse_scalar(const T* matrix, T* result) {
+        T inverse[element_num] = { 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1 };
+        T temporary[element_num];
+
+        std::memcpy(temporary, matrix, sizeof(temporary));
+
+        for (auto i = 0; i < 4; ++i) {
+            const auto pivot_row = find_pivot(temporary, i);
+
+            if (pivot_row != i) {
+                for (auto k = 0; k < 4; ++k) {
+                    std::swap(temporary[i * 4 + k], temporary[pivot_row * 4 + k]);
+                    std::swap(inverse[i * 4 + k], inverse[pivot_row * 4 + k]);
+                }
+            }
+
+            T coefficient = 1 / temporary[i * 4 + i];
+
+            for (auto j = 0; j < 4; ++j) {
+                temporary[i * 4 + j] *= coefficient;
+                inverse[i * 4 + j] *= coefficient;
+            }
+
+            for (auto j = 0; j < 4; ++j) {
+                if (i == j) {
+                    continue;
+                }
+
+                coefficient = temporary[j * 4 + i];
+
+                for (auto k = 0; k < 4; ++k) {
+                    temporary[j * 4 + k] -= temporary[i * 4 + k] * coefficient;
+                    inverse[j * 4 + k] -= inverse[i * 4 + k] * coefficient;
+                }
+            }
+        }
+
+        std::memcpy(result, inverse, sizeof(inverse));
+    }
+
+    // 2x2 の小行列式から余因子行列を求める(除算は行列式の逆数の 1 回のみ)
+    // 行列式を返す。0 の場合は result を書き換えない
+    template <typename T>
+    T inverse_cofactor_scalar(const T* m, T* result) {
+        const auto s0 = m[0] * m[5] - m[4] * m[1];
+        const auto s1 = m[0] * m[6] - m[4] * m[2];
+        const auto s2 = m[0] * m[7] - m[4] * m[3];
+        const auto s3 = m[1] * m[6] - m[5] * m[2];
+        const auto s4 = m[1] * m[7] - m[5] * m[3];
+        const auto s5 = m[2] * m[7] - m[6] * m[3];
+
+        const auto c0 = m[8] * m[13] - m[12] * m[9];
+        const auto c1 = m[8] * m[14] - m[12] * m[10];
+        const auto c2 = m[8] * m[15] - m[12] * m[11];
+        const auto c3 = m[9] * m[14] - m[13] * m[10];
+        const auto c4 = m[9] * m[15] - m[13] * m[11];
+        const auto c5 = m[10] * m[15] - m[14] * m[11];
+
+        const auto determinant = s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+
+        if (determinant == 0) {
+            return determinant;
+        }
+
+        const auto r = 1 / determinant;
+
+        result[0] = (m[5] * c5 - m[6] * c4 + m[7] * c3) * r;
+        result[1] = (-m[1] * c5 + m[2] * c4 - m[3] * c3) * r;
+        result[2] = (m[13] * s5 - m[14] * s4 + m[15] * s3) * r;
+        result[3] = (-m[9] * s5 + m[10] * s4 - m[11] * s3) * r;
+
+        result[4] = (-m[4] * c5 + m[6] * c2 - m[7] * c1) * r;
+        result[5] = (m[0] * c5 - m[2] * c2 + m[3] * c1) * r;
+        result[6] = (-m[12] * s5 + m[14] * s2 - m[15] * s1) * r;
+        result[7] = (m[8] * s5 - m[10] * s2 + m[11] * s1) * r;
+
+        result[8] = (m[4] * c4 - m[5] * c2 + m[7] * c0) * r;
+        result[9] = (-m[0] * c4 + m[1] * c2 - m[3] * c0) * r;
+        result[10] = (m[12] * s4 - m[13] * s2 + m[15] * s0) * r;
+        result[11] = (-m[8] * s4 + m[9] * s2 - m[11] * s0) * r;
+
+        result[12] = (-m[4] * c3 + m[5] * c1 - m[6] * c0) * r;
+        result[13] = (m[0] * c3 - m[1] * c1 + m[2] * c0) * r;
+        result[14] = (-m[12] * s3 + m[13] * s1 - m[14] * s0) * r;
+        result[15] = (m[8] * s3 - m[9] * s1 + m[10] * s0) * r;
+
+        return determinant;
+    }
+
+    // 要素毎に先に読み込んでから書き込むので source と result が同じでも良い
+    template <typename T>
+    void transform_soa_scalar(const T* matrix, const T* x, const T* y, const T* z,
+                              T* result_x, T* result_y, T* result_z, const std::size_t count, const bool point) {
+        const T w = point ? 1 : 0;
+        const auto tx = matrix[12] * w;
+        const auto ty = matrix[13] * w;
+        const auto tz = matrix[14] * w;
+
+        for (std::size_t i = 0; i < count; ++i) {
+            const auto vx = x[i];
+            const auto vy = y[i];
+            const auto vz = z[i];
+
+            result_x[i] = vx * matrix[0] + vy * matrix[4] + vz * matrix[8] + tx;
+            result_y[i] = vx * matrix[1] + vy * matrix[5] + vz * matrix[9] + ty;
+            result_z[i] = vx * matrix[2] + vy * matrix[6] + vz * matrix[10] + tz;
+        }
+    }
+
+    // 線分と三角形 [first, count) の交差判定 (Moller-Trumbore 法)
+    // triangle は x0, y0, z0, x1, y1, z1, x2, y2, z2 の 9 本の座標列
+    // ratio より start に近い交点だけを採用して ratio を更新し、その三角形の番号を返す(無ければ count)
+    // 線分と平行な三角形(行列式が 0)は交差しない扱いにする。境界上の交点は交差に含める
+    template <typename T>
+    std::size_t intersect_segment_triangle_scalar(const T* start, const T* end, const T* const* triangle,
+                                                  const std::size_t first, const std::size_t count, T& ratio) {
+        const auto dx = end[0] - start[0];
+        const auto dy = end[1] - start[1];
+        const auto dz = end[2] - start[2];
+        auto nearest = count;
+
+        for (auto i = first; i < count; ++i) {
+            const auto x0 = triangle[0][i], y0 = triangle[1][i], z0 = triangle[2][i];
+            const auto e1x = triangle[3][i] - x0, e1y = triangle[4][i] - y0, e1z = triangle[5][i] - z0;
+            const auto e2x = triangle[6][i] - x0, e2y = triangle[7][i] - y0, e2z = triangle[8][i] - z0;
+
+            // p = d x e2
+            const auto px = dy * e2z - dz * e2y;
+            const auto py = dz * e2x - dx * e2z;
+            const auto pz = dx * e2y - dy * e2x;
+            const auto det = e1x * px + e1y * py + e1z * pz;
+
+            if (det == 0) {
+                continue;
+            }
+
+            const auto inverse = 1 / det;
+            const auto tx = start[0] - x0, ty = start[1] - y0, tz = start[2] - z0;
+            const auto u = (tx * px + ty * py + tz * pz) * inverse;
+
+            if (!(u >= 0 && u <= 1)) {
+                continue;
+            }
+
+            // q = (start - p0) x e1
+            const auto qx = ty * e1z - tz * e1y;
+            const auto qy = tz * e1x - tx * e1z;
+            const auto qz = tx * e1y - ty * e1x;
+            const auto v = (dx * qx + dy * qy + dz * qz) * inverse;
+
+            if (!(v >= 0 && u + v <= 1)) {
+                continue;
+            }
+
+            const auto t = (e2x * qx + e2y * qy + e2z * qz) * inverse;
+
+            if (t >= 0 && t <= 1 && t < ratio) {
+                ratio = t;
+                nearest = i;
+            }
+        }
+
+        return nearest;
+    }
+
+    // SIMD 版で交差したレーンだけ start に近い順を確認する
+    template <typename T>
+    std::size_t select_nearest_lane(const int mask, const T* lane_ratio, const std::size_t base, const int lane_num, std::size_t nearest, T& ratio) {
+        for (auto lane = 0; lane < lane_num; ++lane) {
+            if ((mask & (1 << lane)) != 0 && lane_ratio[lane] < ratio) {
+                ratio = lane_ratio[lane];
+                nearest = base + lane;
+            }
+        }
+
+        return nearest;
+    }
+
+    // 三角形の内外判定の係数 edge[12] (辺毎に a.x, a.y, a.z, c) を求める
+    // 法線 n と辺 e から a = n x e とすると、辺の始点 p から見た点 q の辺関数 (e x (q - p)) . n は a . q - a . p になる
+    // 3 辺の辺関数が -tolerance * (n . n) 以上なら内側 (n . n で割ると重心座標なので三角形の大きさに依らない)
+    template <typename T>
+    void make_inside_triangle_edge(const T* triangle, const T tolerance, T* edge) {
+        const T* point[] = { triangle, triangle + 3, triangle + 6 };
+        T side[3][3];
+
+        for (auto i = 0; i < 3; ++i) {
+            const auto* from = point[i];
+            const auto* to = point[(i + 1) % 3];
+
+            for (auto axis = 0; axis < 3; ++axis) {
+                side[i][axis] = to[axis] - from[axis];
+            }
+        }
+
+        // n = e0 x (p2 - p0) = e0 x -e2
+        const T normal[3] = {
+            side[2][1] * side[0][2] - side[2][2] * side[0][1],
+            side[2][2] * side[0][0] - side[2][0] * side[0][2],
+            side[2][0] * side[0][1] - side[2][1] * side[0][0]
+        };
+        const auto square = normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2];
+
+        for (auto i = 0; i < 3; ++i) {
+            auto* a = edge + i * 4;
+
+            // 縮退した三角形は全て外側になる様にする
+            if (!(square > 0)) {
+                a[0] = a[1] = a[2] = 0;
+                a[3] = -1;
+
+                continue;
+            }
+
+            a[0] = normal[1] * side[i][2] - normal[2] * side[i][1];
+            a[1] = normal[2] * side[i][0] - normal[0] * side[i][2];
+            a[2] = normal[0] * side[i][1] - normal[1] * side[i][0];
+            a[3] = tolerance * square - (a[0] * point[i][0] + a[1] * point[i][1] + a[2] * point[i][2]);
+        }
+    }
+
+    template <typename T>
+    void inside_triangle_scalar(const T* edge, const T* x, const T* y, const T* z, bool* result, const std::size_t count) {
+        for (std::size_t i = 0; i < count; ++i) {
+            const auto w0 = edge[0] * x[i] + edge[1] * y[i] + edge[2] * z[i] + edge[3];
+            const auto w1 = edge[4] * x[i] + edge[5] * y[i] + edge[6] * z[i] + edge[7];
+            const auto w2 = edge[8] * x[i] + edge[9] * y[i] + edge[10] * z[i] + edge[11];
+
+            result[i] = (w0 >= 0) && (w1 >= 0) && (w2 >= 0);
+        }
+    }
+
+    // 視錐台カリング (first 番目から count 個)
+    // 平面毎に 境界箱の広がり |a| * ex + |b| * ey + |c| * ez と球の半径 の小さい方より外側なら見えない
+    template <typename T>
+    void cull_bounds_scalar(const T* planes, const T* const* bounds, bool* visible, const std::size_t first, const std::size_t count) {
+        for (auto i = first; i < count; ++i) {
+            auto inside = true;
+
+            for (auto p = 0; p < 6 && inside; ++p) {
+                const auto* plane = planes + p * 4;
+                const auto distance = plane[0] * bounds[0][i] + plane[1] * bounds[1][i] + plane[2] * bounds[2][i] + plane[3];
+                const auto box = std::abs(plane[0]) * bounds[3][i] + std::abs(plane[1]) * bounds[4][i] + std::abs(plane[2]) * bounds[5][i];
+
+                inside = !(distance < -std::min(box, bounds[6][i]));
+            }
+
+            visible[i] = inside;
+        }
+    }
+
+    // SIMD 版の比較結果のビットを bool に展開する
+    inline void store_mask(const int mask, const int lane_num, bool* result) {
+        for (auto lane = 0; lane < lane_num; ++lane) {
+            result[lane] = (mask & (1 << lane)) != 0;
+        }
+    }
+
+#if defined(MATH_SIMD_X86)
+    // ========================================================================================================
+    // SSE2 (1 行を 2 レジスタで扱う)
+
+    void inverse_sse2(const double* matrix, double* result) {
+        double temporary[element_num];
+        double inverse[element_num] = { 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1 };
+
+        std::memcpy(temporary, matrix, sizeof(temporary));
+
+        for (auto i = 0; i < 4; ++i) {
+            const auto pivot_row = find_pivot(temporary, i);
+
+            if (pivot_row != i) {
+                for (auto k = 0; k < 4; ++k) {
+                    std::swap(temporary[i * 4 + k], temporary[pivot_row * 4 + k]);
+                    std::swap(inverse[i * 4 + k], inverse[pivot_row * 4 + k]);
+                }
+            }
+
+            const auto pivot = _mm_set1_pd(1.0 / temporary[i * 4 + i]);
+            auto* row_t = temporary + i * 4;
+            auto* row_i = inverse + i * 4;
+
+            _mm_storeu_pd(row_t, _mm_mul_pd(_mm_loadu_pd(row_t), pivot));
+            _mm_storeu_pd(row_t + 2, _mm_mul_pd(_mm_loadu_pd(row_t + 2), pivot));
+            _mm_storeu_pd(row_i, _mm_mul_pd(_mm_loadu_pd(row_i), pivot));
+            _mm_storeu_pd(row_i + 2, _mm_mul_pd(_mm_loadu_pd(row_i + 2), pivot));
+
+            for (auto j = 0; j < 4; ++j) {
+                if (i == j) {
+                    continue;
+                }
+
+                const auto coefficient = _mm_set1_pd(temporary[j * 4 + i]);
+                auto* target_t = temporary + j * 4;
+                auto* target_i = inverse + j * 4;
+
+                _mm_storeu_pd(target_t, _mm_sub_pd(_mm_loadu_pd(target_t), _mm_mul_pd(_mm_loadu_pd(row_t), coefficient)));
+                _mm_storeu_pd(target_t + 2, _mm_sub_pd(_mm_loadu_pd(target_t + 2), _mm_mul_pd(_mm_loadu_pd(row_t + 2), coefficient)));
+                _mm_storeu_pd(target_i, _mm_sub_pd(_mm_loadu_pd(target_i), _mm_mul_pd(_mm_loadu_pd(row_i), coefficient)));
+                _mm_storeu_pd(target_i + 2, _mm_sub_pd(_mm_loadu_pd(target_i + 2), _mm_mul_pd(_mm_loadu_pd(row_i + 2), coefficient)));
+            }
+        }
+
+        std::memcpy(result, inverse, sizeof(inverse));
+    }
+
+    // ========================================================================================================
+    // SSE2 float (1 行を 1 レジスタで扱う)
+
+    void multiply_sse2(const float* lhs, const float* rhs, float* result) {
+        const auto rhs0 = _mm_loadu_ps(rhs);
+        const auto rhs1 = _mm_loadu_ps(rhs + 4);
+        const auto rhs2 = _mm_loadu_ps(rhs + 8);
+        const auto rhs3 = _mm_loadu_ps(rhs + 12);
+
+        for (auto i = 0; i < 4; ++i) {
+            const auto* row = lhs + i * 4;
+            auto m = _mm_mul_ps(_mm_set1_ps(row[0]), rhs0);
+
+            m = _mm_add_ps(m, _mm_mul_ps(_mm_set1_ps(row[1]), rhs1));
+            m = _mm_add_ps(m, _mm_mul_ps(_mm_set1_ps(row[2]), rhs2));
+            m = _mm_add_ps(m, _mm_mul_ps(_mm_set1_ps(row[3]), rhs3));
+
+            _mm_storeu_ps(result + i * 4, m);
+        }
+    }
+
+    // 軸選択と係数は 1 要素ずつ読むので、行列はレジスタに置かずにメモリから読み書きする(レジスタから取り出すより速い)
+    void inverse_sse2(const float* matrix, float* result) {
+        float temporary[element_num];
+        float inverse[element_num] = { 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1 };
+
+        std::memcpy(temporary, matrix, sizeof(temporary));
+
+        for (auto i = 0; i < 4; ++i) {
+            const auto pivot_row = find_pivot(temporary, i);
+
+            if (pivot_row != i) {
+                for (auto k = 0; k < 4; ++k) {
+                    std::swap(temporary[i * 4 + k], temporary[pivot_row * 4 + k]);
+                    std::swap(inverse[i * 4 + k], inverse[pivot_row * 4 + k]);
+                }
+            }
+
+            const auto pivot = _mm_set1_ps(1.0f / temporary[i * 4 + i]);
+            const auto row_t = _mm_mul_ps(_mm_loadu_ps(temporary + i * 4), pivot);
+            const auto row_i = _mm_mul_ps(_mm_loadu_ps(inverse + i * 4), pivot);
+
+            _mm_storeu_ps(temporary + i * 4, row_t);
+            _mm_storeu_ps(inverse + i * 4, row_i);
+
+            for (auto j = 0; j < 4; ++j) {
+                if (i == j) {
+                    continue;
+                }
+
+                const auto coefficient = _mm_set1_ps(temporary[j * 4 + i]);
+
+                _mm_storeu_ps(temporary + j * 4, _mm_sub_ps(_mm_loadu_ps(temporary + j * 4), _mm_mul_ps(row_t, coefficient)));
+                _mm_storeu_ps(inverse + j * 4, _mm_sub_ps(_mm_loadu_ps(inverse + j * 4), _mm_mul_ps(row_i, coefficient)));
+            }
+        }
+
+        std::memcpy(result, inverse, sizeof(inverse));
+    }
+
+    // 2x2 の小行列に分割して余因子を求める(ブロック行列による逆行列)
+    // A B
+    // C D の各小行列を (m00, m01, m10, m11) の順で 1 レジスタに持つ
+
+    // a * b
+    __m128 multiply_2x2(const __m128 a, const __m128 b) {
+        return _mm_add_ps(_mm_mul_ps(a, _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 3, 0))),
+                          _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 2, 1, 2))));
+    }
+
+    // adjugate(a) * b
+    __m128 adjugate_multiply_2x2(const __m128 a, const __m128 b) {
+        return _mm_sub_ps(_mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(0, 0, 3, 3)), b),
+                          _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 2, 1, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 0, 3, 2))));
+    }
+
+    // a * adjugate(b)
+    __m128 multiply_adjugate_2x2(const __m128 a, const __m128 b) {
+        return _mm_sub_ps(_mm_mul_ps(a, _mm_shuffle_ps(b, b, _MM_SHUFFLE(0, 3, 0, 3))),
+                          _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 2, 1, 2))));
+    }
+
+    float inverse_cofactor_sse2(const float* matrix, float* result) {
+        const auto row0 = _mm_loadu_ps(matrix);
+        const auto row1 = _mm_loadu_ps(matrix + 4);
+        const auto row2 = _mm_loadu_ps(matrix + 8);
+        const auto row3 = _mm_loadu_ps(matrix + 12);
+
+        const auto a = _mm_movelh_ps(row0, row1);
+        const auto b = _mm_movehl_ps(row1, row0);
+        const auto c = _mm_movelh_ps(row2, row3);
+        const auto d = _mm_movehl_ps(row3, row2);
+
+        // (|A|, |B|, |C|, |D|)
+        const auto sub_determinant = _mm_sub_ps(
+            _mm_mul_ps(_mm_shuffle_ps(row0, row2, _MM_SHUFFLE(2, 0, 2, 0)), _mm_shuffle_ps(row1, row3, _MM_SHUFFLE(3, 1, 3, 1))),
+            _mm_mul_ps(_mm_shuffle_ps(row0, row2, _MM_SHUFFLE(3, 1, 3, 1)), _mm_shuffle_ps(row1, row3, _MM_SHUFFLE(2, 0, 2, 0))));
+
+        const auto determinant_a = _mm_shuffle_ps(sub_determinant, sub_determinant, _MM_SHUFFLE(0, 0, 0, 0));
+        const auto determinant_b = _mm_shuffle_ps(sub_determinant, sub_determinant, _MM_SHUFFLE(1, 1, 1, 1));
+        const auto determinant_c = _mm_shuffle_ps(sub_determinant, sub_determinant, _MM_SHUFFLE(2, 2, 2, 2));
+        const auto determinant_d = _mm_shuffle_ps(sub_determinant, sub_determinant, _MM_SHUFFLE(3, 3, 3, 3));
+
+        const auto d_c = adjugate_multiply_2x2(d, c);
+        const auto a_b = adjugate_multiply_2x2(a, b);
+
+        // 逆行列の各小行列の余因子 (符号と転置は格納時に処理する)
+        auto x = _mm_sub_ps(_mm_mul_ps(determinant_d, a), multiply_2x2(b, d_c));
+        auto w = _mm_sub_ps(_mm_mul_ps(determinant_a, d), multiply_2x2(c, a_b));
+        auto y = _mm_sub_ps(_mm_mul_ps(determinant_b, c), multiply_adjugate_2x2(d, a_b));
+        auto z = _mm_sub_ps(_mm_mul_ps(determinant_c, b), multiply_adjugate_2x2(a, d_c));
+
+        // |M| = |A||D| + |B||C| - tr((A#B)(D#C))
+        auto trace = _mm_mul_ps(a_b, _mm_shuffle_ps(d_c, d_c, _MM_SHUFFLE(3, 1, 2, 0)));
+
+        trace = _mm_add_ps(trace, _mm_shuffle_ps(trace, trace, _MM_SHUFFLE(2, 3, 0, 1)));
+        trace = _mm_add_ps(trace, _mm_shuffle_ps(trace, trace, _MM_SHUFFLE(1, 0, 3, 2)));
+
+        const auto determinant = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(determinant_a, determinant_d), _mm_mul_ps(determinant_b, determinant_c)), trace);
+        const auto value = _mm_cvtss_f32(determinant);
+
+        if (value == 0.0f) {
+            return value;
+        }
+
+        const auto reciprocal = _mm_div_ps(_mm_setr_ps(1.0f, -1.0f, -1.0f, 1.0f), determinant);
+
+        x = _mm_mul_ps(x, reciprocal);
+        y = _mm_mul_ps(y, reciprocal);
+        z = _mm_mul_ps(z, reciprocal);
+        w = _mm_mul_ps(w, reciprocal);
+
+        _mm_storeu_ps(result, _mm_shuffle_ps(x, y, _MM_SHUFFLE(1, 3, 1, 3)));
+        _mm_storeu_ps(result + 4, _mm_shuffle_ps(x, y, _MM_SHUFFLE(0, 2, 0, 2)));
+        _mm_storeu_ps(result + 8, _mm_shuffle_ps(z, w, _MM_SHUFFLE(1, 3, 1, 3)));
+        _mm_storeu_ps(result + 12, _mm_shuffle_ps(z, w, _MM_SHUFFLE(0, 2, 0, 2)));
+
+        return value;
+    }
+
+    // ========================================================================================================
+    // SSE2 SoA (double は 2 要素、float は 4 要素ずつ処理して端数は scalar で処理する)
+
+    void transform_soa_sse2(const double* matrix, const double* x, const double* y, const double* z,
+                            double* result_x, double* result_y, double* result_z, const std::size_t count, const bool point) {
+        const auto w = point ? 1.0 : 0.0;
+        const auto m00 = _mm_set1_pd(matrix[0]), m01 = _mm_set1_pd(matrix[1]), m02 = _mm_set1_pd(matrix[2]);
+        const auto m10 = _mm_set1_pd(matrix[4]), m11 = _mm_set1_pd(matrix[5]), m12 = _mm_set1_pd(matrix[6]);
+        const auto m20 = _mm_set1_pd(matrix[8]), m21 = _mm_set1_pd(matrix[9]), m22 = _mm_set1_pd(matrix[10]);
+        const auto tx = _mm_set1_pd(matrix[12] * w), ty = _mm_set1_pd(matrix[13] * w), tz = _mm_set1_pd(matrix[14] * w);
+        std::size_t i = 0;
+
+        for (; i + 2 <= count; i += 2) {
+            const auto vx = _mm_loadu_pd(x + i);
+            const auto vy = _mm_loadu_pd(y + i);
+            const auto vz = _mm_loadu_pd(z + i);
+
+            _mm_storeu_pd(result_x + i, _mm_add_pd(_mm_add_pd(_mm_mul_pd(vx, m00), _mm_mul_pd(vy, m10)), _mm_add_pd(_mm_mul_pd(vz, m20), tx)));
+            _mm_storeu_pd(result_y + i, _mm_add_pd(_mm_add_pd(_mm_mul_pd(vx, m01), _mm_mul_pd(vy, m11)), _mm_add_pd(_mm_mul_pd(vz, m21), ty)));
+            _mm_storeu_pd(result_z + i, _mm_add_pd(_mm_add_pd(_mm_mul_pd(vx, m02), _mm_mul_pd(vy, m12)), _mm_add_pd(_mm_mul_pd(vz, m22), tz)));
+        }
+
+        transform_soa_scalar(matrix, x + i, y + i, z + i, result_x + i, result_y + i, result_z + i, count - i, point);
+    }
+
+    void transform_soa_sse2(const float* matrix, const float* x, const float* y, const float* z,
+                            float* result_x, float* result_y, float* result_z, const std::size_t count, const bool point) {
+        const auto w = point ? 1.0f : 0.0f;
+        const auto m00 = _mm_set1_ps(matrix[0]), m01 = _mm_set1_ps(matrix[1]), m02 = _mm_set1_ps(matrix[2]);
+        const auto m10 = _mm_set1_ps(matrix[4]), m11 = _mm_set1_ps(matrix[5]), m12 = _mm_set1_ps(matrix[6]);
+        const auto m20 = _mm_set1_ps(matrix[8]), m21 = _mm_set1_ps(matrix[9]), m22 = _mm_set1_ps(matrix[10]);
+        const auto tx = _mm_set1_ps(matrix[12] * w), ty = _mm_set1_ps(matrix[13] * w), tz = _mm_set1_ps(matrix[14] * w);
+        std::size_t i = 0;
+
+        for (; i + 4 <= count; i += 4) {
+            const auto vx = _mm_loadu_ps(x + i);
+            const auto vy = _mm_loadu_ps(y + i);
+            const auto vz = _mm_loadu_ps(z + i);
+
+            _mm_storeu_ps(result_x + i, _mm_add_ps(_mm_add_ps(_mm_mul_ps(vx, m00), _mm_mul_ps(vy, m10)), _mm_add_ps(_mm_mul_ps(vz, m20), tx)));
+            _mm_storeu_ps(result_y + i, _mm_add_ps(_mm_add_ps(_mm_mul_ps(vx, m01), _mm_mul_ps(vy, m11)), _mm_add_ps(_mm_mul_ps(vz, m21), ty)));
+            _mm_storeu_ps(result_z + i, _mm_add_ps(_mm_add_ps(_mm_mul_ps(vx, m02), _mm_mul_ps(vy, m12)), _mm_add_ps(_mm_mul_ps(vz, m22), tz)));
+        }
+
+        transform_soa_scalar(matrix, x + i, y + i, z + i, result_x + i, result_y + i, result_z + i, count - i, point);
+    }
+
+    // ========================================================================================================
+    // SSE2 線分と三角形の交差判定 (double は 2 個、float は 4 個ずつ判定して端数は scalar で処理する)
+
+    std::size_t intersect_segment_triangle_sse2(const double* start, const double* end, const double* const* triangle,
+                                                        const std::size_t first, const std::size_t count, double& ratio) {
+        const auto sx = _mm_set1_pd(start[0]), sy = _mm_set1_pd(start[1]), sz = _mm_set1_pd(start[2]);
+        const auto dx = _mm_set1_pd(end[0] - start[0]), dy = _mm_set1_pd(end[1] - start[1]), dz = _mm_set1_pd(end[2] - start[2]);
+        const auto zero = _mm_setzero_pd();
+        const auto one = _mm_set1_pd(1.0);
+        auto nearest = count;
+        auto i = first;
+
+        for (; i + 2 <= count; i += 2) {
+            const auto x0 = _mm_loadu_pd(triangle[0] + i), y0 = _mm_loadu_pd(triangle[1] + i), z0 = _mm_loadu_pd(triangle[2] + i);
+            const auto e1x = _mm_sub_pd(_mm_loadu_pd(triangle[3] + i), x0);
+            const auto e1y = _mm_sub_pd(_mm_loadu_pd(triangle[4] + i), y0);
+            const auto e1z = _mm_sub_pd(_mm_loadu_pd(triangle[5] + i), z0);
+            const auto e2x = _mm_sub_pd(_mm_loadu_pd(triangle[6] + i), x0);
+            const auto e2y = _mm_sub_pd(_mm_loadu_pd(triangle[7] + i), y0);
+            const auto e2z = _mm_sub_pd(_mm_loadu_pd(triangle[8] + i), z0);
+
+            const auto px = _mm_sub_pd(_mm_mul_pd(dy, e2z), _mm_mul_pd(dz, e2y));
+            const auto py = _mm_sub_pd(_mm_mul_pd(dz, e2x), _mm_mul_pd(dx, e2z));
+            const auto pz = _mm_sub_pd(_mm_mul_pd(dx, e2y), _mm_mul_pd(dy, e2x));
+            const auto det = _mm_add_pd(_mm_add_pd(_mm_mul_pd(e1x, px), _mm_mul_pd(e1y, py)), _mm_mul_pd(e1z, pz));
+
+            const auto tx = _mm_sub_pd(sx, x0), ty = _mm_sub_pd(sy, y0), tz = _mm_sub_pd(sz, z0);
+            const auto qx = _mm_sub_pd(_mm_mul_pd(ty, e1z), _mm_mul_pd(tz, e1y));
+            const auto qy = _mm_sub_pd(_mm_mul_pd(tz, e1x), _mm_mul_pd(tx, e1z));
+            const auto qz = _mm_sub_pd(_mm_mul_pd(tx, e1y), _mm_mul_pd(ty, e1x));
+
+            const auto inverse = _mm_div_pd(one, det);
+            const auto u = _mm_mul_pd(_mm_add_pd(_mm_add_pd(_mm_mul_pd(tx, px), _mm_mul_pd(ty, py)), _mm_mul_pd(tz, pz)), inverse);
+            const auto v = _mm_mul_pd(_mm_add_pd(_mm_add_pd(_mm_mul_pd(dx, qx), _mm_mul_pd(dy, qy)), _mm_mul_pd(dz, qz)), inverse);
+            const auto t = _mm_mul_pd(_mm_add_pd(_mm_add_pd(_mm_mul_pd(e2x, qx), _mm_mul_pd(e2y, qy)), _mm_mul_pd(e2z, qz)), inverse);
+
+            auto hit = _mm_and_pd(_mm_cmpneq_pd(det, zero), _mm_and_pd(_mm_cmpge_pd(u, zero), _mm_cmple_pd(u, one)));
+
+            hit = _mm_and_pd(hit, _mm_and_pd(_mm_cmpge_pd(v, zero), _mm_cmple_pd(_mm_add_pd(u, v), one)));
+            hit = _mm_and_pd(hit, _mm_and_pd(_mm_cmpge_pd(t, zero), _mm_cmple_pd(t, one)));
+
+            const auto mask = _mm_movemask_pd(hit);
+
+            // 全レーンが交差しなければ次へ
+            if (mask == 0) {
+                continue;
+            }
+
+            alignas(16) double lane_ratio[2];
+
+            _mm_store_pd(lane_ratio, t);
+            nearest = select_nearest_lane(mask, lane_ratio, i, 2, nearest, ratio);
+        }
+
+        const auto rest = intersect_segment_triangle_scalar(start, end, triangle, i, count, ratio);
+
+        return (rest != count) ? rest : nearest;
+    }
+
+    std::size_t intersect_segment_triangle_sse2(const float* start, const float* end, const float* const* triangle,
+                                                        const std::size_t first, const std::size_t count, float& ratio) {
+        const auto sx = _mm_set1_ps(start[0]), sy = _mm_set1_ps(start[1]), sz = _mm_set1_ps(start[2]);
+        const auto dx = _mm_set1_ps(end[0] - start[0]), dy = _mm_set1_ps(end[1] - start[1]), dz = _mm_set1_ps(end[2] - start[2]);
+        const auto zero = _mm_setzero_ps();
+        const auto one = _mm_set1_ps(1.0f);
+        auto nearest = count;
+        auto i = first;
+
+        for (; i + 4 <= count; i += 4) {
+            const auto x0 = _mm_loadu_ps(triangle[0] + i), y0 = _mm_loadu_ps(triangle[1] + i), z0 = _mm_loadu_ps(triangle[2] + i);
+            const auto e1x = _mm_sub_ps(_mm_loadu_ps(triangle[3] + i), x0);
+            const auto e1y = _mm_sub_ps(_mm_loadu_ps(triangle[4] + i), y0);
+            const auto e1z = _mm_sub_ps(_mm_loadu_ps(triangle[5] + i), z0);
+            const auto e2x = _mm_sub_ps(_mm_loadu_ps(triangle[6] + i), x0);
+            const auto e2y = _mm_sub_ps(_mm_loadu_ps(triangle[7] + i), y0);
+            const auto e2z = _mm_sub_ps(_mm_loadu_ps(triangle[8] + i), z0);
+
+            const auto px = _mm_sub_ps(_mm_mul_ps(dy, e2z), _mm_mul_ps(dz, e2y));
+            const auto py = _mm_sub_ps(_mm_mul_ps(dz, e2x), _mm_mul_ps(dx, e2z));
+            const auto pz = _mm_sub_ps(_mm_mul_ps(dx, e2y), _mm_mul_ps(dy, e2x));
+            const auto det = _mm_add_ps(_mm_add_ps(_mm_mul_ps(e1x, px), _mm_mul_ps(e1y, py)), _mm_mul_ps(e1z, pz));
+
+            const auto tx = _mm_sub_ps(sx, x0), ty = _mm_sub_ps(sy, y0), tz = _mm_sub_ps(sz, z0);
+            const auto qx = _mm_sub_ps(_mm_mul_ps(ty, e1z), _mm_mul_ps(tz, e1y));
+            const auto qy = _mm_sub_ps(_mm_mul_ps(tz, e1x), _mm_mul_ps(tx, e1z));
+            const auto qz = _mm_sub_ps(_mm_mul_ps(tx, e1y), _mm_mul_ps(ty, e1x));
+
+            const auto inverse = _mm_div_ps(one, det);
+            const auto u = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(tx, px), _mm_mul_ps(ty, py)), _mm_mul_ps(tz, pz)), inverse);
+            const auto v = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, qx), _mm_mul_ps(dy, qy)), _mm_mul_ps(dz, qz)), inverse);
+            const auto t = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(e2x, qx), _mm_mul_ps(e2y, qy)), _mm_mul_ps(e2z, qz)), inverse);
+
+            auto hit = _mm_and_ps(_mm_cmpneq_ps(det, zero), _mm_and_ps(_mm_cmpge_ps(u, zero), _mm_cmple_ps(u, one)));
+
+            hit = _mm_and_ps(hit, _mm_and_ps(_mm_cmpge_ps(v, zero), _mm_cmple_ps(_mm_add_ps(u, v), one)));
+            hit = _mm_and_ps(hit, _mm_and_ps(_mm_cmpge_ps(t, zero), _mm_cmple_ps(t, one)));
+
+            const auto mask = _mm_movemask_ps(hit);
+
+            // 全レーンが交差しなければ次へ
+            if (mask == 0) {
+                continue;
+            }
+
+            alignas(16) float lane_ratio[4];
+
+            _mm_store_ps(lane_ratio, t);
+            nearest = select_nearest_lane(mask, lane_ratio, i, 4, nearest, ratio);
+        }
+
+        const auto rest = intersect_segment_triangle_scalar(start, end, triangle, i, count, ratio);
+
+        return (rest != count) ? rest : nearest;
+    }
+
+    // ========================================================================================================
+    // SSE2 三角形の内外判定 (double は 2 個、float は 4 個ずつ判定して端数は scalar で処理する)
+
+    void inside_triangle_sse2(const double* edge, const double* x, const double* y, const double* z, bool* result, const std::size_t count) {
+        const auto a0x = _mm_set1_pd(edge[0]), a0y = _mm_set1_pd(edge[1]), a0z = _mm_set1_pd(edge[2]), c0 = _mm_set1_pd(edge[3]);
+        const auto a1x = _mm_set1_pd(edge[4]), a1y = _mm_set1_pd(edge[5]), a1z = _mm_set1_pd(edge[6]), c1 = _mm_set1_pd(edge[7]);
+        const auto a2x = _mm_set1_pd(edge[8]), a2y = _mm_set1_pd(edge[9]), a2z = _mm_set1_pd(edge[10]), c2 = _mm_set1_pd(edge[11]);
+        const auto zero = _mm_setzero_pd();
+        std::size_t i = 0;
+
+        for (; i + 2 <= count; i += 2) {
+            const auto vx = _mm_loadu_pd(x + i);
+            const auto vy = _mm_loadu_pd(y + i);
+            const auto vz = _mm_loadu_pd(z + i);
+            const auto w0 = _mm_add_pd(_mm_add_pd(_mm_add_pd(_mm_mul_pd(a0x, vx), _mm_mul_pd(a0y, vy)), _mm_mul_pd(a0z, vz)), c0);
+            const auto w1 = _mm_add_pd(_mm_add_pd(_mm_add_pd(_mm_mul_pd(a1x, vx), _mm_mul_pd(a1y, vy)), _mm_mul_pd(a1z, vz)), c1);
+            const auto w2 = _mm_add_pd(_mm_add_pd(_mm_add_pd(_mm_mul_pd(a2x, vx), _mm_mul_pd(a2y, vy)), _mm_mul_pd(a2z, vz)), c2);
+            const auto inside = _mm_and_pd(_mm_cmpge_pd(w0, zero), _mm_and_pd(_mm_cmpge_pd(w1, zero), _mm_cmpge_pd(w2, zero)));
+
+            store_mask(_mm_movemask_pd(inside), 2, result + i);
+        }
+
+        inside_triangle_scalar(edge, x + i, y + i, z + i, result + i, count - i);
+    }
+
+    void inside_triangle_sse2(const float* edge, const float* x, const float* y, const float* z, bool* result, const std::size_t count) {
+        const auto a0x = _mm_set1_ps(edge[0]), a0y = _mm_set1_ps(edge[1]), a0z = _mm_set1_ps(edge[2]), c0 = _mm_set1_ps(edge[3]);
+        const auto a1x = _mm_set1_ps(edge[4]), a1y = _mm_set1_ps(edge[5]), a1z = _mm_set1_ps(edge[6]), c1 = _mm_set1_ps(edge[7]);
+        const auto a2x = _mm_set1_ps(edge[8]), a2y = _mm_set1_ps(edge[9]), a2z = _mm_set1_ps(edge[10]), c2 = _mm_set1_ps(edge[11]);
+        const auto zero = _mm_setzero_ps();
+        std::size_t i = 0;
+
+        for (; i + 4 <= count; i += 4) {
+            const auto vx = _mm_loadu_ps(x + i);
+            const auto vy = _mm_loadu_ps(y + i);
+            const auto vz = _mm_loadu_ps(z + i);
+            const auto w0 = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(a0x, vx), _mm_mul_ps(a0y, vy)), _mm_mul_ps(a0z, vz)), c0);
+            const auto w1 = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(a1x, vx), _mm_mul_ps(a1y, vy)), _mm_mul_ps(a1z, vz)), c1);
+            const auto w2 = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(a2x, vx), _mm_mul_ps(a2y, vy)), _mm_mul_ps(a2z, vz)), c2);
+            const auto inside = _mm_and_ps(_mm_cmpge_ps(w0, zero), _mm_and_ps(_mm_cmpge_ps(w1, zero), _mm_cmpge_ps(w2, zero)));
+
+            store_mask(_mm_movemask_ps(inside), 4, result + i);
+        }
+
+        inside_triangle_scalar(edge, x + i, y + i, z + i, result + i, count - i);
+    }
+
+    // ========================================================================================================
+    // SSE2 視錐台カリング (double は 2 個、float は 4 個ずつ 6 平面を判定して端数は scalar で処理する)
+
+    void cull_bounds_sse2(const double* planes, const double* const* bounds, bool* visible, const std::size_t first, const std::size_t count) {
+        const auto sign = _mm_set1_pd(-0.0);
+        std::size_t i = first;
+
+        for (; i + 2 <= count; i += 2) {
+            const auto x = _mm_loadu_pd(bounds[0] + i), y = _mm_loadu_pd(bounds[1] + i), z = _mm_loadu_pd(bounds[2] + i);
+            const auto ex = _mm_loadu_pd(bounds[3] + i), ey = _mm_loadu_pd(bounds[4] + i), ez = _mm_loadu_pd(bounds[5] + i);
+            const auto radius = _mm_loadu_pd(bounds[6] + i);
+            auto outside = _mm_setzero_pd();
+
+            for (auto p = 0; p < 6; ++p) {
+                const auto a = _mm_set1_pd(planes[p * 4]), b = _mm_set1_pd(planes[p * 4 + 1]), c = _mm_set1_pd(planes[p * 4 + 2]);
+                const auto distance = _mm_add_pd(_mm_add_pd(_mm_add_pd(_mm_mul_pd(a, x), _mm_mul_pd(b, y)), _mm_mul_pd(c, z)), _mm_set1_pd(planes[p * 4 + 3]));
+                const auto box = _mm_add_pd(_mm_add_pd(_mm_mul_pd(_mm_andnot_pd(sign, a), ex), _mm_mul_pd(_mm_andnot_pd(sign, b), ey)), _mm_mul_pd(_mm_andnot_pd(sign, c), ez));
+
+                outside = _mm_or_pd(outside, _mm_cmplt_pd(distance, _mm_xor_pd(sign, _mm_min_pd(box, radius))));
+            }
+
+            store_mask(~_mm_movemask_pd(outside), 2, visible + i);
+        }
+
+        cull_bounds_scalar(planes, bounds, visible, i, count);
+    }
+
+    void cull_bounds_sse2(const float* planes, const float* const* bounds, bool* visible, const std::size_t first, const std::size_t count) {
+        const auto sign = _mm_set1_ps(-0.0f);
+        std::size_t i = first;
+
+        for (; i + 4 <= count; i += 4) {
+            const auto x = _mm_loadu_ps(bounds[0] + i), y = _mm_loadu_ps(bounds[1] + i), z = _mm_loadu_ps(bounds[2] + i);
+            const auto ex = _mm_loadu_ps(bounds[3] + i), ey = _mm_loadu_ps(bounds[4] + i), ez = _mm_loadu_ps(bounds[5] + i);
+            const auto radius = _mm_loadu_ps(bounds[6] + i);
+            auto outside = _mm_setzero_ps();
+
+            for (auto p = 0; p < 6; ++p) {
+                const auto a = _mm_set1_ps(planes[p * 4]), b = _mm_set1_ps(planes[p * 4 + 1]), c = _mm_set1_ps(planes[p * 4 + 2]);
+                const auto distance = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(a, x), _mm_mul_ps(b, y)), _mm_mul_ps(c, z)), _mm_set1_ps(planes[p * 4 + 3]));
+                const auto box = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_andnot_ps(sign, a), ex), _mm_mul_ps(_mm_andnot_ps(sign, b), ey)), _mm_mul_ps(_mm_andnot_ps(sign, c), ez));
+
+                outside = _mm_or_ps(outside, _mm_cmplt_ps(distance, _mm_xor_ps(sign, _mm_min_ps(box, radius))));
+            }
+
+            store_mask(~_mm_movemask_ps(outside), 4, visible + i);
+        }
+
+        cull_bounds_scalar(planes, bounds, visible, i, count);
+    }
+
+    // ========================================================================================================
+    // AVX2 + FMA (1 行を 1 レジスタで扱う)
+
+    // rhs は直前に 16 バイト以下の書き込みで作った行列のことが多く、32 バイトで読むとストアフォワーディングが効かないので 16 バイトずつ読む
+    MATH_TARGET_AVX2 void multiply_avx2(const double* lhs, const double* rhs, double* result) {
+        const auto rhs0 = _mm256_set_m128d(_mm_loadu_pd(rhs + 2), _mm_loadu_pd(rhs));
+        const auto rhs1 = _mm256_set_m128d(_mm_loadu_pd(rhs + 6), _mm_loadu_pd(rhs + 4));
+        const auto rhs2 = _mm256_set_m128d(_mm_loadu_pd(rhs + 10), _mm_loadu_pd(rhs + 8));
+        const auto rhs3 = _mm256_set_m128d(_mm_loadu_pd(rhs + 14), _mm_loadu_pd(rhs + 12));
+
+        for (auto i = 0; i < 4; ++i) {
+            const auto* row = lhs + i * 4;
+            auto m = _mm256_mul_pd(_mm256_broadcast_sd(row), rhs0);
+
+            m = _mm256_fmadd_pd(_mm256_broadcast_sd(row + 1), rhs1, m);
+            m = _mm256_fmadd_pd(_mm256_broadcast_sd(row + 2), rhs2, m);
+            m = _mm256_fmadd_pd(_mm256_broadcast_sd(row + 3), rhs3, m);
+
+            _mm256_storeu_pd(result + i * 4, m);
+        }
+    }
+
+    // float の SSE2 版と同じく行列はメモリから読み書きする
+    MATH_TARGET_AVX2 void inverse_avx2(const double* matrix, double* result) {
+        double temporary[element_num];
+        double inverse[element_num] = { 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1 };
+
+        std::memcpy(temporary, matrix, sizeof(temporary));
+
+        for (auto i = 0; i < 4; ++i) {
+            const auto pivot_row = find_pivot(temporary, i);
+
+            if (pivot_row != i) {
+                for (auto k = 0; k < 4; ++k) {
+                    std::swap(temporary[i * 4 + k], temporary[pivot_row * 4 + k]);
+                    std::swap(inverse[i * 4 + k], inverse[pivot_row * 4 + k]);
+                }
+            }
+
+            const auto pivot = _mm256_set1_pd(1.0 / temporary[i * 4 + i]);
+            const auto row_t = _mm256_mul_pd(_mm256_loadu_pd(temporary + i * 4), pivot);
+            const auto row_i = _mm256_mul_pd(_mm256_loadu_pd(inverse + i * 4), pivot);
+
+            _mm256_storeu_pd(temporary + i * 4, row_t);
+            _mm256_storeu_pd(inverse + i * 4, row_i);
+
+            for (auto j = 0; j < 4; ++j) {
+                if (i == j) {
+                    continue;
+                }
+
+                const auto coefficient = _mm256_set1_pd(temporary[j * 4 + i]);
+
+                _mm256_storeu_pd(temporary + j * 4, _mm256_fnmadd_pd(row_t, coefficient, _mm256_loadu_pd(temporary + j * 4)));
+                _mm256_storeu_pd(inverse + j * 4, _mm256_fnmadd_pd(row_i, coefficient, _mm256_loadu_pd(inverse + j * 4)));
+            }
+        }
+
+        std::memcpy(result, inverse, sizeof(inverse));
+    }
+
+    // float の SSE2 版と同じブロック行列による逆行列 (小行列 1 つを 256bit レジスタで扱う)
+    // _mm256_permute4x64_pd の即値は _mm_shuffle_ps と同じ並び
+    MATH_TARGET_AVX2 __m256d multiply_2x2(const __m256d a, const __m256d b) {
+        return _mm256_fmadd_pd(a, _mm256_permute4x64_pd(b, _MM_SHUFFLE(3, 0, 3, 0)),
+                               _mm256_mul_pd(_mm256_permute_pd(a, 0b0101), _mm256_permute4x64_pd(b, _MM_SHUFFLE(1, 2, 1, 2))));
+    }
+
+    MATH_TARGET_AVX2 __m256d adjugate_multiply_2x2(const __m256d a, const __m256d b) {
+        return _mm256_fmsub_pd(_mm256_permute4x64_pd(a, _MM_SHUFFLE(0, 0, 3, 3)), b,
+                               _mm256_mul_pd(_mm256_permute4x64_pd(a, _MM_SHUFFLE(2, 2, 1, 1)), _mm256_permute4x64_pd(b, _MM_SHUFFLE(1, 0, 3, 2))));
+    }
+
+    MATH_TARGET_AVX2 __m256d multiply_adjugate_2x2(const __m256d a, const __m256d b) {
+        return _mm256_fmsub_pd(a, _mm256_permute4x64_pd(b, _MM_SHUFFLE(0, 3, 0, 3)),
+                               _mm256_mul_pd(_mm256_permute_pd(a, 0b0101), _mm256_permute4x64_pd(b, _MM_SHUFFLE(1, 2, 1, 2))));
+    }
+
+    // 行列は 16 バイトずつ読んで小行列と行を組み立てる (multiply_avx2 と同じくストアフォワーディングのため)
+    MATH_TARGET_AVX2 double inverse_cofactor_avx2(const double* matrix, double* result) {
+        __m128d half[8];
+
+        for (auto i = 0; i < 8; ++i) {
+            half[i] = _mm_loadu_pd(matrix + i * 2);
+        }
+
+        const auto a = _mm256_set_m128d(half[2], half[0]);
+        const auto b = _mm256_set_m128d(half[3], half[1]);
+        const auto c = _mm256_set_m128d(half[6], half[4]);
+        const auto d = _mm256_set_m128d(half[7], half[5]);
+
+        const auto row0 = _mm256_set_m128d(half[1], half[0]);
+        const auto row1 = _mm256_set_m128d(half[3], half[2]);
+        const auto row2 = _mm256_set_m128d(half[5], half[4]);
+        const auto row3 = _mm256_set_m128d(half[7], half[6]);
+
+        // (|A|, |C|, |B|, |D|)
+        const auto sub_determinant = _mm256_fmsub_pd(_mm256_unpacklo_pd(row0, row2), _mm256_unpackhi_pd(row1, row3),
+                                                      _mm256_mul_pd(_mm256_unpackhi_pd(row0, row2), _mm256_unpacklo_pd(row1, row3)));
+
+        const auto determinant_a = _mm256_permute4x64_pd(sub_determinant, _MM_SHUFFLE(0, 0, 0, 0));
+        const auto determinant_b = _mm256_permute4x64_pd(sub_determinant, _MM_SHUFFLE(2, 2, 2, 2));
+        const auto determinant_c = _mm256_permute4x64_pd(sub_determinant, _MM_SHUFFLE(1, 1, 1, 1));
+        const auto determinant_d = _mm256_permute4x64_pd(sub_determinant, _MM_SHUFFLE(3, 3, 3, 3));
+
+        const auto d_c = adjugate_multiply_2x2(d, c);
+        const auto a_b = adjugate_multiply_2x2(a, b);
+
+        auto x = _mm256_fmsub_pd(determinant_d, a, multiply_2x2(b, d_c));
+        auto w = _mm256_fmsub_pd(determinant_a, d, multiply_2x2(c, a_b));
+        auto y = _mm256_fmsub_pd(determinant_b, c, multiply_adjugate_2x2(d, a_b));
+        auto z = _mm256_fmsub_pd(determinant_c, b, multiply_adjugate_2x2(a, d_c));
+
+        // |M| = |A||D| + |B||C| - tr((A#B)(D#C))
+        auto trace = _mm256_mul_pd(a_b, _mm256_permute4x64_pd(d_c, _MM_SHUFFLE(3, 1, 2, 0)));
+
+        trace = _mm256_add_pd(trace, _mm256_permute_pd(trace, 0b0101));
+        trace = _mm256_add_pd(trace, _mm256_permute2f128_pd(trace, trace, 0x01));
+
+        const auto determinant = _mm256_sub_pd(_mm256_fmadd_pd(determinant_a, determinant_d, _mm256_mul_pd(determinant_b, determinant_c)), trace);
+        const auto value = _mm256_cvtsd_f64(determinant);
+
+        if (value == 0.0) {
+            return value;
+        }
+
+        const auto reciprocal = _mm256_div_pd(_mm256_setr_pd(1.0, -1.0, -1.0, 1.0), determinant);
+
+        x = _mm256_mul_pd(x, reciprocal);
+        y = _mm256_mul_pd(y, reciprocal);
+        z = _mm256_mul_pd(z, reciprocal);
+        w = _mm256_mul_pd(w, reciprocal);
+
+        // unpack で (x1, y1, x3, y3) / (x0, y0, x2, y2) にしてから (x3, x1, y3, y1) / (x2, x0, y2, y0) に並べ替える
+        _mm256_storeu_pd(result, _mm256_permute4x64_pd(_mm256_unpackhi_pd(x, y), _MM_SHUFFLE(1, 3, 0, 2)));
+        _mm256_storeu_pd(result + 4, _mm256_permute4x64_pd(_mm256_unpacklo_pd(x, y), _MM_SHUFFLE(1, 3, 0, 2)));
+        _mm256_storeu_pd(result + 8, _mm256_permute4x64_pd(_mm256_unpackhi_pd(z, w), _MM_SHUFFLE(1, 3, 0, 2)));
+        _mm256_storeu_pd(result + 12, _mm256_permute4x64_pd(_mm256_unpacklo_pd(z, w), _MM_SHUFFLE(1, 3, 0, 2)));
+
+        return value;
+    }
+
+    // ========================================================================================================
+    // FMA float (1 行を 128bit レジスタで扱い、積和を FMA にする)
+
+    MATH_TARGET_AVX2 void multiply_fma(const float* lhs, const float* rhs, float* result) {
+        const auto rhs0 = _mm_loadu_ps(rhs);
+        const auto rhs1 = _mm_loadu_ps(rhs + 4);
+        const auto rhs2 = _mm_loadu_ps(rhs + 8);
+        const auto rhs3 = _mm_loadu_ps(rhs + 12);
+
+        for (auto i = 0; i < 4; ++i) {
+            const auto* row = lhs + i * 4;
+            auto m = _mm_mul_ps(_mm_broadcast_ss(row), rhs0);
+
+            m = _mm_fmadd_ps(_mm_broadcast_ss(row + 1), rhs1, m);
+            m = _mm_fmadd_ps(_mm_broadcast_ss(row + 2), rhs2, m);
+            m = _mm_fmadd_ps(_mm_broadcast_ss(row + 3), rhs3, m);
+
+            _mm_storeu_ps(result + i * 4, m);
+        }
+    }
+
+    // ========================================================================================================
+    // AVX2 + FMA SoA (double は 4 要素、float は 8 要素ずつ処理して端数は scalar で処理する)
+
+    MATH_TARGET_AVX2 void transform_soa_avx2(const double* matrix, const double* x, const double* y, const double* z,
+                                             double* result_x, double* result_y, double* result_z, const std::size_t count, const bool point) {
+        const auto w = point ? 1.0 : 0.0;
+        const auto m00 = _mm256_set1_pd(matrix[0]), m01 = _mm256_set1_pd(matrix[1]), m02 = _mm256_set1_pd(matrix[2]);
+        const auto m10 = _mm256_set1_pd(matrix[4]), m11 = _mm256_set1_pd(matrix[5]), m12 = _mm256_set1_pd(matrix[6]);
+        const auto m20 = _mm256_set1_pd(matrix[8]), m21 = _mm256_set1_pd(matrix[9]), m22 = _mm256_set1_pd(matrix[10]);
+        const auto tx = _mm256_set1_pd(matrix[12] * w), ty = _mm256_set1_pd(matrix[13] * w), tz = _mm256_set1_pd(matrix[14] * w);
+        std::size_t i = 0;
+
+        for (; i + 4 <= count; i += 4) {
+            const auto vx = _mm256_loadu_pd(x + i);
+            const auto vy = _mm256_loadu_pd(y + i);
+            const auto vz = _mm256_loadu_pd(z + i);
+
+            _mm256_storeu_pd(result_x + i, _mm256_fmadd_pd(vx, m00, _mm256_fmadd_pd(vy, m10, _mm256_fmadd_pd(vz, m20, tx))));
+            _mm256_storeu_pd(result_y + i, _mm256_fmadd_pd(vx, m01, _mm256_fmadd_pd(vy, m11, _mm256_fmadd_pd(vz, m21, ty))));
+            _mm256_storeu_pd(result_z + i, _mm256_fmadd_pd(vx, m02, _mm256_fmadd_pd(vy, m12, _mm256_fmadd_pd(vz, m22, tz))));
+        }
+
+        // 端数処理は SSE のコードになるので上位レジスタを戻しておく(遷移ペナルティの回避)
+        _mm256_zeroupper();
+
+        transform_soa_scalar(matrix, x + i, y + i, z + i, result_x + i, result_y + i, result_z + i, count - i, point);
+    }
+
+    MATH_TARGET_AVX2 void transform_soa_avx2(const float* matrix, const float* x, const float* y, const float* z,
+                                             float* result_x, float* result_y, float* result_z, const std::size_t count, const bool point) {
+        const auto w = point ? 1.0f : 0.0f;
+        const auto m00 = _mm256_set1_ps(matrix[0]), m01 = _mm256_set1_ps(matrix[1]), m02 = _mm256_set1_ps(matrix[2]);
+        const auto m10 = _mm256_set1_ps(matrix[4]), m11 = _mm256_set1_ps(matrix[5]), m12 = _mm256_set1_ps(matrix[6]);
+        const auto m20 = _mm256_set1_ps(matrix[8]), m21 = _mm256_set1_ps(matrix[9]), m22 = _mm256_set1_ps(matrix[10]);
+        const auto tx = _mm256_set1_ps(matrix[12] * w), ty = _mm256_set1_ps(matrix[13] * w), tz = _mm256_set1_ps(matrix[14] * w);
+        std::size_t i = 0;
+
+        for (; i + 8 <= count; i += 8) {
+            const auto vx = _mm256_loadu_ps(x + i);
+            const auto vy = _mm256_loadu_ps(y + i);
+            const auto vz = _mm256_loadu_ps(z + i);
+
+            _mm256_storeu_ps(result_x + i, _mm256_fmadd_ps(vx, m00, _mm256_fmadd_ps(vy, m10, _mm256_fmadd_ps(vz, m20, tx))));
+            _mm256_storeu_ps(result_y + i, _mm256_fmadd_ps(vx, m01, _mm256_fmadd_ps(vy, m11, _mm256_fmadd_ps(vz, m21, ty))));
+            _mm256_storeu_ps(result_z + i, _mm256_fmadd_ps(vx, m02, _mm256_fmadd_ps(vy, m12, _mm256_fmadd_ps(vz, m22, tz))));
+        }
+
+        // 端数処理は SSE のコードになるので上位レジスタを戻しておく(遷移ペナルティの回避)
+        _mm256_zeroupper();
+
+        transform_soa_scalar(matrix, x + i, y + i, z + i, result_x + i, result_y + i, result_z + i, count - i, point);
+    }
+
+    // ========================================================================================================
+    // AVX2 線分と三角形の交差判定 (double は 4 個、float は 8 個ずつ判定して端数は scalar で処理する)
+    // scalar と同じ結果になる様に FMA は使わない
+
+    MATH_TARGET_AVX2 std::size_t intersect_segment_triangle_avx2(const double* start, const double* end, const double* const* triangle,
+                                                                         const std::size_t first, const std::size_t count, double& ratio) {
+        const auto sx = _mm256_set1_pd(start[0]), sy = _mm256_set1_pd(start[1]), sz = _mm256_set1_pd(start[2]);
+        const auto dx = _mm256_set1_pd(end[0] - start[0]), dy = _mm256_set1_pd(end[1] - start[1]), dz = _mm256_set1_pd(end[2] - start[2]);
+        const auto zero = _mm256_setzero_pd();
+        const auto one = _mm256_set1_pd(1.0);
+        auto nearest = count;
+        auto i = first;
+
+        for (; i + 4 <= count; i += 4) {
+            const auto x0 = _mm256_loadu_pd(triangle[0] + i), y0 = _mm256_loadu_pd(triangle[1] + i), z0 = _mm256_loadu_pd(triangle[2] + i);
+            const auto e1x = _mm256_sub_pd(_mm256_loadu_pd(triangle[3] + i), x0);
+            const auto e1y = _mm256_sub_pd(_mm256_loadu_pd(triangle[4] + i), y0);
+            const auto e1z = _mm256_sub_pd(_mm256_loadu_pd(triangle[5] + i), z0);
+            const auto e2x = _mm256_sub_pd(_mm256_loadu_pd(triangle[6] + i), x0);
+            const auto e2y = _mm256_sub_pd(_mm256_loadu_pd(triangle[7] + i), y0);
+            const auto e2z = _mm256_sub_pd(_mm256_loadu_pd(triangle[8] + i), z0);
+
+            const auto px = _mm256_sub_pd(_mm256_mul_pd(dy, e2z), _mm256_mul_pd(dz, e2y));
+            const auto py = _mm256_sub_pd(_mm256_mul_pd(dz, e2x), _mm256_mul_pd(dx, e2z));
+            const auto pz = _mm256_sub_pd(_mm256_mul_pd(dx, e2y), _mm256_mul_pd(dy, e2x));
+            const auto det = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(e1x, px), _mm256_mul_pd(e1y, py)), _mm256_mul_pd(e1z, pz));
+
+            const auto tx = _mm256_sub_pd(sx, x0), ty = _mm256_sub_pd(sy, y0), tz = _mm256_sub_pd(sz, z0);
+            const auto qx = _mm256_sub_pd(_mm256_mul_pd(ty, e1z), _mm256_mul_pd(tz, e1y));
+            const auto qy = _mm256_sub_pd(_mm256_mul_pd(tz, e1x), _mm256_mul_pd(tx, e1z));
+            const auto qz = _mm256_sub_pd(_mm256_mul_pd(tx, e1y), _mm256_mul_pd(ty, e1x));
+
+            const auto inverse = _mm256_div_pd(one, det);
+            const auto u = _mm256_mul_pd(_mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(tx, px), _mm256_mul_pd(ty, py)), _mm256_mul_pd(tz, pz)), inverse);
+            const auto v = _mm256_mul_pd(_mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(dx, qx), _mm256_mul_pd(dy, qy)), _mm256_mul_pd(dz, qz)), inverse);
+            const auto t = _mm256_mul_pd(_mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(e2x, qx), _mm256_mul_pd(e2y, qy)), _mm256_mul_pd(e2z, qz)), inverse);
+
+            auto hit = _mm256_and_pd(_mm256_cmp_pd(det, zero, _CMP_NEQ_UQ), _mm256_and_pd(_mm256_cmp_pd(u, zero, _CMP_GE_OQ), _mm256_cmp_pd(u, one, _CMP_LE_OQ)));
+
+            hit = _mm256_and_pd(hit, _mm256_and_pd(_mm256_cmp_pd(v, zero, _CMP_GE_OQ), _mm256_cmp_pd(_mm256_add_pd(u, v), one, _CMP_LE_OQ)));
+            hit = _mm256_and_pd(hit, _mm256_and_pd(_mm256_cmp_pd(t, zero, _CMP_GE_OQ), _mm256_cmp_pd(t, one, _CMP_LE_OQ)));
+
+            const auto mask = _mm256_movemask_pd(hit);
+
+            // 全レーンが交差しなければ次へ
+            if (mask == 0) {
+                continue;
+            }
+
+            alignas(32) double lane_ratio[4];
+
+            _mm256_store_pd(lane_ratio, t);
+            nearest = select_nearest_lane(mask, lane_ratio, i, 4, nearest, ratio);
+        }
+
+        // 端数処理は SSE のコードになるので上位レジスタを戻しておく(遷移ペナルティの回避)
+        _mm256_zeroupper();
+
+        const auto rest = intersect_segment_triangle_scalar(start, end, triangle, i, count, ratio);
+
+        return (rest != count) ? rest : nearest;
+    }
+
+    MATH_TARGET_AVX2 std::size_t intersect_segment_triangle_avx2(const float* start, const float* end, const float* const* triangle,
+                                                                         const std::size_t first, const std::size_t count, float& ratio) {
+        const auto sx = _mm256_set1_ps(start[0]), sy = _mm256_set1_ps(start[1]), sz = _mm256_set1_ps(start[2]);
+        const auto dx = _mm256_set1_ps(end[0] - start[0]), dy = _mm256_set1_ps(end[1] - start[1]), dz = _mm256_set1_ps(end[2] - start[2]);
+        const auto zero = _mm256_setzero_ps();
+        const auto one = _mm256_set1_ps(1.0f);
+        auto nearest = count;
+        auto i = first;
+
+        for (; i + 8 <= count; i += 8) {
+            const auto x0 = _mm256_loadu_ps(triangle[0] + i), y0 = _mm256_loadu_ps(triangle[1] + i), z0 = _mm256_loadu_ps(triangle[2] + i);
+            const auto e1x = _mm256_sub_ps(_mm256_loadu_ps(triangle[3] + i), x0);
+            const auto e1y = _mm256_sub_ps(_mm256_loadu_ps(triangle[4] + i), y0);
+            const auto e1z = _mm256_sub_ps(_mm256_loadu_ps(triangle[5] + i), z0);
+            const auto e2x = _mm256_sub_ps(_mm256_loadu_ps(triangle[6] + i), x0);
+            const auto e2y = _mm256_sub_ps(_mm256_loadu_ps(triangle[7] + i), y0);
+            const auto e2z = _mm256_sub_ps(_mm256_loadu_ps(triangle[8] + i), z0);
+
+            const auto px = _mm256_sub_ps(_mm256_mul_ps(dy, e2z), _mm256_mul_ps(dz, e2y));
+            const auto py = _mm256_sub_ps(_mm256_mul_ps(dz, e2x), _mm256_mul_ps(dx, e2z));
+            const auto pz = _mm256_sub_ps(_mm256_mul_ps(dx, e2y), _mm256_mul_ps(dy, e2x));
+            const auto det = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(e1x, px), _mm256_mul_ps(e1y, py)), _mm256_mul_ps(e1z, pz));
+
+            const auto tx = _mm256_sub_ps(sx, x0), ty = _mm256_sub_ps(sy, y0), tz = _mm256_sub_ps(sz, z0);
+            const auto qx = _mm256_sub_ps(_mm256_mul_ps(ty, e1z), _mm256_mul_ps(tz, e1y));
+            const auto qy = _mm256_sub_ps(_mm256_mul_ps(tz, e1x), _mm256_mul_ps(tx, e1z));
+            const auto qz = _mm256_sub_ps(_mm256_mul_ps(tx, e1y), _mm256_mul_ps(ty, e1x));
+
+            const auto inverse = _mm256_div_ps(one, det);
+            const auto u = _mm256_mul_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(tx, px), _mm256_mul_ps(ty, py)), _mm256_mul_ps(tz, pz)), inverse);
+            const auto v = _mm256_mul_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, qx), _mm256_mul_ps(dy, qy)), _mm256_mul_ps(dz, qz)), inverse);
+            const auto t = _mm256_mul_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(e2x, qx), _mm256_mul_ps(e2y, qy)), _mm256_mul_ps(e2z, qz)), inverse);
+
+            auto hit = _mm256_and_ps(_mm256_cmp_ps(det, zero, _CMP_NEQ_UQ), _mm256_and_ps(_mm256_cmp_ps(u, zero, _CMP_GE_OQ), _mm256_cmp_ps(u, one, _CMP_LE_OQ)));
+
+            hit = _mm256_and_ps(hit, _mm256_and_ps(_mm256_cmp_ps(v, zero, _CMP_GE_OQ), _mm256_cmp_ps(_mm256_add_ps(u, v), one, _CMP_LE_OQ)));
+            hit = _mm256_and_ps(hit, _mm256_and_ps(_mm256_cmp_ps(t, zero, _CMP_GE_OQ), _mm256_cmp_ps(t, one, _CMP_LE_OQ)));
+
+            const auto mask = _mm256_movemask_ps(hit);
+
+            // 全レーンが交差しなければ次へ
+            if (mask == 0) {
+                continue;
+            }
+
+            alignas(32) float lane_ratio[8];
+
+            _mm256_store_ps(lane_ratio, t);
+            nearest = select_nearest_lane(mask, lane_ratio, i, 8, nearest, ratio);
+        }
+
+        // 端数処理は SSE のコードになるので上位レジスタを戻しておく(遷移ペナルティの回避)
+        _mm256_zeroupper();
+
+        const auto rest = intersect_segment_triangle_scalar(start, end, triangle, i, count, ratio);
+
+        return (rest != count) ? rest : nearest;
+    }
+
+    // ========================================================================================================
+    // AVX2 三角形の内外判定 (double は 4 個、float は 8 個ずつ判定して端数は scalar で処理する)
+    // scalar と同じ結果になる様に FMA は使わない
+
+    MATH_TARGET_AVX2 void inside_triangle_avx2(const double* edge, const double* x, const double* y, const double* z, bool* result, const std::size_t count) {
+        const auto a0x = _mm256_set1_pd(edge[0]), a0y = _mm256_set1_pd(edge[1]), a0z = _mm256_set1_pd(edge[2]), c0 = _mm256_set1_pd(edge[3]);
+        const auto a1x = _mm256_set1_pd(edge[4]), a1y = _mm256_set1_pd(edge[5]), a1z = _mm256_set1_pd(edge[6]), c1 = _mm256_set1_pd(edge[7]);
+        const auto a2x = _mm256_set1_pd(edge[8]), a2y = _mm256_set1_pd(edge[9]), a2z = _mm256_set1_pd(edge[10]), c2 = _mm256_set1_pd(edge[11]);
+        const auto zero = _mm256_setzero_pd();
+        std::size_t i = 0;
+
+        for (; i + 4 <= count; i += 4) {
+            const auto vx = _mm256_loadu_pd(x + i);
+            const auto vy = _mm256_loadu_pd(y + i);
+            const auto vz = _mm256_loadu_pd(z + i);
+            const auto w0 = _mm256_add_pd(_mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(a0x, vx), _mm256_mul_pd(a0y, vy)), _mm256_mul_pd(a0z, vz)), c0);
+            const auto w1 = _mm256_add_pd(_mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(a1x, vx), _mm256_mul_pd(a1y, vy)), _mm256_mul_pd(a1z, vz)), c1);
+            const auto w2 = _mm256_add_pd(_mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(a2x, vx), _mm256_mul_pd(a2y, vy)), _mm256_mul_pd(a2z, vz)), c2);
+            const auto inside = _mm256_and_pd(_mm256_cmp_pd(w0, zero, _CMP_GE_OQ), _mm256_and_pd(_mm256_cmp_pd(w1, zero, _CMP_GE_OQ), _mm256_cmp_pd(w2, zero, _CMP_GE_OQ)));
+
+            store_mask(_mm256_movemask_pd(inside), 4, result + i);
+        }
+
+        // 端数処理は SSE のコードになるので上位レジスタを戻しておく(遷移ペナルティの回避)
+        _mm256_zeroupper();
+
+        inside_triangle_scalar(edge, x + i, y + i, z + i, result + i, count - i);
+    }
+
+    MATH_TARGET_AVX2 void inside_triangle_avx2(const float* edge, const float* x, const float* y, const float* z, bool* result, const std::size_t count) {
+        const auto a0x = _mm256_set1_ps(edge[0]), a0y = _mm256_set1_ps(edge[1]), a0z = _mm256_set1_ps(edge[2]), c0 = _mm256_set1_ps(edge[3]);
+        const auto a1x = _mm256_set1_ps(edge[4]), a1y = _mm256_set1_ps(edge[5]), a1z = _mm256_set1_ps(edge[6]), c1 = _mm256_set1_ps(edge[7]);
+        const auto a2x = _mm256_set1_ps(edge[8]), a2y = _mm256_set1_ps(edge[9]), a2z = _mm256_set1_ps(edge[10]), c2 = _mm256_set1_ps(edge[11]);
+        const auto zero = _mm256_setzero_ps();
+        std::size_t i = 0;
+
+        for (; i + 8 <= count; i += 8) {
+            const auto vx = _mm256_loadu_ps(x + i);
+            const auto vy = _mm256_loadu_ps(y + i);
+            const auto vz = _mm256_loadu_ps(z + i);
+            const auto w0 = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(a0x, vx), _mm256_mul_ps(a0y, vy)), _mm256_mul_ps(a0z, vz)), c0);
+            const auto w1 = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(a1x, vx), _mm256_mul_ps(a1y, vy)), _mm256_mul_ps(a1z, vz)), c1);
+            const auto w2 = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(a2x, vx), _mm256_mul_ps(a2y, vy)), _mm256_mul_ps(a2z, vz)), c2);
+            const auto inside = _mm256_and_ps(_mm256_cmp_ps(w0, zero, _CMP_GE_OQ), _mm256_and_ps(_mm256_cmp_ps(w1, zero, _CMP_GE_OQ), _mm256_cmp_ps(w2, zero, _CMP_GE_OQ)));
+
+            store_mask(_mm256_movemask_ps(inside), 8, result + i);
+        }
+
+        // 端数処理は SSE のコードになるので上位レジスタを戻しておく(遷移ペナルティの回避)
+        _mm256_zeroupper();
+
+        inside_triangle_scalar(edge, x + i, y + i, z + i, result + i, count - i);
+    }
+
+    // ========================================================================================================
+    // AVX2 視錐台カリング (double は 4 個、float は 8 個ずつ判定して端数は SSE2 で処理する)
+    // scalar と同じ結果になる様に FMA は使わない
+
+    MATH_TARGET_AVX2 void cull_bounds_avx2(const double* planes, const double* const* bounds, bool* visible, const std::size_t first, const std::size_t count) {
+        const auto sign = _mm256_set1_pd(-0.0);
+        std::size_t i = first;
+
+        for (; i + 4 <= count; i += 4) {
+            const auto x = _mm256_loadu_pd(bounds[0] + i), y = _mm256_loadu_pd(bounds[1] + i), z = _mm256_loadu_pd(bounds[2] + i);
+            const auto ex = _mm256_loadu_pd(bounds[3] + i), ey = _mm256_loadu_pd(bounds[4] + i), ez = _mm256_loadu_pd(bounds[5] + i);
+            const auto radius = _mm256_loadu_pd(bounds[6] + i);
+            auto outside = _mm256_setzero_pd();
+
+            for (auto p = 0; p < 6; ++p) {
+                const auto a = _mm256_set1_pd(planes[p * 4]), b = _mm256_set1_pd(planes[p * 4 + 1]), c = _mm256_set1_pd(planes[p * 4 + 2]);
+                const auto distance = _mm256_add_pd(_mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(a, x), _mm256_mul_pd(b, y)), _mm256_mul_pd(c, z)), _mm256_set1_pd(planes[p * 4 + 3]));
+                const auto box = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(_mm256_andnot_pd(sign, a), ex), _mm256_mul_pd(_mm256_andnot_pd(sign, b), ey)), _mm256_mul_pd(_mm256_andnot_pd(sign, c), ez));
+
+                outside = _mm256_or_pd(outside, _mm256_cmp_pd(distance, _mm256_xor_pd(sign, _mm256_min_pd(box, radius)), _CMP_LT_OQ));
+            }
+
+            store_mask(~_mm256_movemask_pd(outside), 4, visible + i);
+        }
+
+        // 端数処理は SSE のコードになるので上位レジスタを戻しておく(遷移ペナルティの回避)
+        _mm256_zeroupper();
+
+        cull_bounds_sse2(planes, bounds, visible, i, count);
+    }
+
+    MATH_TARGET_AVX2 void cull_bounds_avx2(const float* planes, const float* const* bounds, bool* visible, const std::size_t first, const std::size_t count) {
+        const auto sign = _mm256_set1_ps(-0.0f);
+        std::size_t i = first;
+
+        for (; i + 8 <= count; i += 8) {
+            const auto x = _mm256_loadu_ps(bounds[0] + i), y = _mm256_loadu_ps(bounds[1] + i), z = _mm256_loadu_ps(bounds[2] + i);
+            const auto ex = _mm256_loadu_ps(bounds[3] + i), ey = _mm256_loadu_ps(bounds[4] + i), ez = _mm256_loadu_ps(bounds[5] + i);
+            const auto radius = _mm256_loadu_ps(bounds[6] + i);
+            auto outside = _mm256_setzero_ps();
+
+            for (auto p = 0; p < 6; ++p) {
+                const auto a = _mm256_set1_ps(planes[p * 4]), b = _mm256_set1_ps(planes[p * 4 + 1]), c = _mm256_set1_ps(planes[p * 4 + 2]);
+                const auto distance = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(a, x), _mm256_mul_ps(b, y)), _mm256_mul_ps(c, z)), _mm256_set1_ps(planes[p * 4 + 3]));
+                const auto box = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_andnot_ps(sign, a), ex), _mm256_mul_ps(_mm256_andnot_ps(sign, b), ey)), _mm256_mul_ps(_mm256_andnot_ps(sign, c), ez));
+
+                outside = _mm256_or_ps(outside, _mm256_cmp_ps(distance, _mm256_xor_ps(sign, _mm256_min_ps(box, radius)), _CMP_LT_OQ));
+            }
+
+            store_mask(~_mm256_movemask_ps(outside), 8, visible + i);
+        }
+
+        // 端数処理は SSE のコードになるので上位レジスタを戻しておく(遷移ペナルティの回避)
+        _mm256_zeroupper();
+
+        cull_bounds_sse2(planes, bounds, visible, i, count);
+    }
+#endif
+
+    // ========================================================================================================
+
+    // カーネルは benchmark_matrix44 で scalar 版より安定して速い (中央値 x1.1 以上) 命令セットにだけ入れる
+    // multiply が nullptr の場合は simd.h で展開する scalar 版を使う(間接呼び出しをしない)
+    constexpr kernel_table scalar_table = {
+        math::simd_level::scalar,
+        nullptr, inverse_scalar<double>,
+        nullptr, inverse_scalar<float>,
+        transform_soa_scalar<double>, transform_soa_scalar<float>,
+        inverse_cofactor_scalar<double>, inverse_cofactor_scalar<float>,
+        intersect_segment_triangle_scalar<double>, intersect_segment_triangle_scalar<float>,
+        inside_triangle_scalar<double>, inside_triangle_scalar<float>,
+        cull_bounds_scalar<double>, cull_bounds_scalar<float>
+    };
+#if defined(MATH_SIMD_X86)
+    // double の行列の乗算と余因子による逆行列は 1 レジスタに 2 要素しか入らず、コンパイラーがベクトル化する scalar 版より速くならないので scalar 版を使う
+    constexpr kernel_table sse2_table = {
+        math::simd_level::sse2,
+        nullptr, inverse_sse2,
+        multiply_sse2, inverse_sse2,
+        transform_soa_sse2, transform_soa_sse2,
+        inverse_cofactor_scalar<double>, inverse_cofactor_sse2,
+        intersect_segment_triangle_sse2, intersect_segment_triangle_sse2,
+        inside_triangle_sse2, inside_triangle_sse2,
+        cull_bounds_sse2, cull_bounds_sse2
+    };
+    // float の逆行列は 128bit で足りるので SSE2 版を使う
+    constexpr kernel_table avx2_table = {
+        math::simd_level::avx2,
+        multiply_avx2, inverse_avx2,
+        multiply_fma, inverse_sse2,
+        transform_soa_avx2, transform_soa_avx2,
+        inverse_cofactor_avx2, inverse_cofactor_sse2,
+        intersect_segment_triangle_avx2, intersect_segment_triangle_avx2,
+        inside_triangle_avx2, inside_triangle_avx2,
+        cull_bounds_avx2, cull_bounds_avx2
+    };
+#endif
+
+    const kernel_table* get_table(const math::simd_level level) {
+        switch (level) {
+#if defined(MATH_SIMD_X86)
+        case math::simd_level::avx2:
+            return &avx2_table;
+
+        case math::simd_level::sse2:
+            return &sse2_table;
+#endif
+        case math::simd_level::scalar:
+        default:
+            return &scalar_table;
+        }
+    }
+
+    // 関数内 static にして他の翻訳単位の静的初期化から呼ばれても判定済みにする
+    const kernel_table*& current() {
+        static const kernel_table* table = get_table(math::simd::detect());
+
+        return table;
+    }
+}
+
+namespace math {
+
+    simd_level simd::detect() {
+#if defined(MATH_DETERMINISTIC)
+        // 命令セットで結果が変わらない様に scalar だけを使う
+        return simd_level::scalar;
+#elif defined(MATH_SIMD_X86)
+#if defined(_MSC_VER)
+        int info[4];
+
+        __cpuid(info, 0);
+
+        if (info[0] < 7) {
+            return simd_level::sse2;
+        }
+
+        __cpuid(info, 1);
+
+        const auto fma = (info[2] & (1 << 12)) != 0;
+        const auto osxsave = (info[2] & (1 << 27)) != 0;
+        const auto avx = (info[2] & (1 << 28)) != 0;
+
+        // OS が YMM レジスタを保存するか
+        if (!fma || !osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6) {
+            return simd_level::sse2;
+        }
+
+        __cpuidex(info, 7, 0);
+
+        const auto avx2 = (info[1] & (1 << 5)) != 0;
+
+        return avx2 ? simd_level::avx2 : simd_level::sse2;
+#else
+        __builtin_cpu_init();
+
+        if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+            return simd_level::avx2;
+        }
+
+        return simd_level::sse2;
+#endif
+#else
+        return simd_level::scalar;
+#endif
+    }
+
+    simd::matrix_kernel simd::matrix_kernels = {
+        current()->multiply, current()->multiply_f
+    };
+
+    simd_level simd::get_level() {
+        return current()->level;
+    }
+
+    bool simd::set_level(const simd_level level) {
+        if (static_cast<int>(level) > static_cast<int>(detect())) {
+            return false;
+        }
+
+        const auto* table = get_table(level);
+
+        current() = table;
+        matrix_kernels = { table->multiply, table->multiply_f };
+
+        return true;
+    }
+
+    void simd::inverse(const double* matrix, double* result) {
+        current()->inverse(matrix, result);
+    }
+
+    void simd::inverse(const float* matrix, float* result) {
+        current()->inverse_f(matrix, result);
+    }
+
+    void simd::transform_soa(const double* matrix, const double* x, const double* y, const double* z,
+                             double* result_x, double* result_y, double* result_z, const std::size_t count, const bool point) {
+        current()->transform_soa(matrix, x, y, z, result_x, result_y, result_z, count, point);
+    }
+
+    void simd::transform_soa(const float* matrix, const float* x, const float* y, const float* z,
+                             float* result_x, float* result_y, float* result_z, const std::size_t count, const bool point) {
+        current()->transform_soa_f(matrix, x, y, z, result_x, result_y, result_z, count, point);
+    }
+
+    double simd::inverse_cofactor(const double* matrix, double* result) {
+        return current()->inverse_cofactor(matrix, result);
+    }
+
+    float simd::inverse_cofactor(const float* matrix, float* result) {
+        return current()->inverse_cofactor_f(matrix, result);
+    }
+
+    std::size_t simd::intersect_segment_triangle(const double* start, const double* end, const double* const* triangle, const std::size_t count, double& ratio) {
+        return current()->intersect_segment_triangle(start, end, triangle, 0, count, ratio);
+    }
+
+    std::size_t simd::intersect_segment_triangle(const float* start, const float* end, const float* const* triangle, const std::size_t count, float& ratio) {
+        return current()->intersect_segment_triangle_f(start, end, triangle, 0, count, ratio);
+    }
+
+    void simd::inside_triangle(const double* triangle, const double* x, const double* y, const double* z, bool* result, const std::size_t count, const double tolerance) {
+        double edge[12];
+
+        make_inside_triangle_edge(triangle, tolerance, edge);
+        current()->inside_triangle(edge, x, y, z, result, count);
+    }
+
+    void simd::inside_triangle(const float* triangle, const float* x, const float* y, const float* z, bool* result, const std::size_t count, const float tolerance) {
+        float edge[12];
+
+        make_inside_triangle_edge(triangle, tolerance, edge);
+        current()->inside_triangle_f(edge, x, y, z, result, count);
+    }
+
+    void simd::cull_bounds(const double* planes, const double* const* bounds, bool* visible, const std::size_t count) {
+        current()->cull_bounds(planes, bounds, visible, 0, count);
+    }
+
+    void simd::cull_bounds(const float* planes, const float* const* bounds, bool* visible, const std::size_t count) {
+        current()->cull_bounds_f(planes, bounds, visible, 0, count);
+    }
+}
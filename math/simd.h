@@ -0,0 +1,128 @@
+#pragma once
+#include <cstddef>
+#include <cstring>
+
+namespace math {
+
+    // 使用する命令セット
+    enum class simd_level {
+        scalar, sse2, avx2
+    };
+
+    // matrix44 / vector4 の演算カーネル
+    // 行列は行優先の T[16]、ベクトルは T[4] として扱う
+    // 命令セットは起動時に CPU を判定して選択される
+    class simd {
+    public:
+        // CPU が対応している最上位の命令セット
+        static simd_level detect();
+
+        static simd_level get_level();
+        // 判定結果より上位は指定できない(ベンチマークや検証用)
+        static bool set_level(const simd_level level);
+
+        // 行列の乗算は、選択中の命令セットに scalar 版より速いカーネルがある場合だけカーネルを呼び、
+        // それ以外はカーネルを間接呼び出しせずに、ここで展開した scalar 版で計算する
+
+        // result = lhs * rhs (result は lhs / rhs と同じ領域でも良い)
+        static void multiply(const double* lhs, const double* rhs, double* result) {
+            if (matrix_kernels.multiply != nullptr) {
+                matrix_kernels.multiply(lhs, rhs, result);
+            }
+            else {
+                multiply_scalar(lhs, rhs, result);
+            }
+        }
+        static void multiply(const float* lhs, const float* rhs, float* result) {
+            if (matrix_kernels.multiply_f != nullptr) {
+                matrix_kernels.multiply_f(lhs, rhs, result);
+            }
+            else {
+                multiply_scalar(lhs, rhs, result);
+            }
+        }
+
+        // result = vector * matrix
+        // SIMD 版はどの命令セットでも scalar 版より速くならないので、常に scalar 版を展開する
+        template <typename T>
+        static void transform(const T* vector, const T* matrix, T* result) {
+            T temporary[4];
+
+            for (auto j = 0; j < 4; ++j) {
+                temporary[j] = vector[0] * matrix[j]
+                             + vector[1] * matrix[4 + j]
+                             + vector[2] * matrix[8 + j]
+                             + vector[3] * matrix[12 + j];
+            }
+
+            std::memcpy(result, temporary, sizeof(temporary));
+        }
+
+        // 部分軸選択付きの掃き出し法による逆行列
+        static void inverse(const double* matrix, double* result);
+        static void inverse(const float* matrix, float* result);
+
+        // 余因子による逆行列(行列式を返す。行列式が 0 の場合は result を書き換えない)
+        // double は avx2 のみ SIMD 版で、sse2 は scalar 版を使う
+        static double inverse_cofactor(const double* matrix, double* result);
+        static float inverse_cofactor(const float* matrix, float* result);
+
+        // x[] / y[] / z[] の座標列を count 個まとめて変換する
+        // point が true なら w = 1 (点)、false なら w = 0 (方向) として扱い、結果の w は捨てる
+        static void transform_soa(const double* matrix, const double* x, const double* y, const double* z,
+                                  double* result_x, double* result_y, double* result_z, const std::size_t count, const bool point);
+        static void transform_soa(const float* matrix, const float* x, const float* y, const float* z,
+                                  float* result_x, float* result_y, float* result_z, const std::size_t count, const bool point);
+
+        // 線分 start -> end と count 個の三角形の交差判定 (Moller-Trumbore 法)
+        // start / end は x, y, z の T[3]、triangle は x0, y0, z0, x1, y1, z1, x2, y2, z2 の 9 本の座標列
+        // ratio (0 ～ 1 の線分上の位置) より start に近い交点の中で最も近い三角形の番号を返して ratio を更新する
+        // 交差しなければ count を返す
+        static std::size_t intersect_segment_triangle(const double* start, const double* end, const double* const* triangle, const std::size_t count, double& ratio);
+        static std::size_t intersect_segment_triangle(const float* start, const float* end, const float* const* triangle, const std::size_t count, float& ratio);
+
+        // count 個の点が三角形の内側か判定する(点は三角形と同平面である事。平方根と除算は使わない)
+        // triangle は 3 頂点の x, y, z を並べた T[9]、tolerance は辺上とみなす重心座標の幅
+        // 縮退した三角形(面積が 0)では全て外側になる
+        static void inside_triangle(const double* triangle, const double* x, const double* y, const double* z, bool* result, const std::size_t count, const double tolerance);
+        static void inside_triangle(const float* triangle, const float* x, const float* y, const float* z, bool* result, const std::size_t count, const float tolerance);
+
+        // count 個の境界が視錐台と重なるか判定して visible に書き込む
+        // planes は視錐台の 6 平面の T[24] (a, b, c, d、内側が正)
+        // bounds は 中心 x, y, z、軸平行境界箱の半分の大きさ x, y, z、球の半径 の 7 本の列
+        // 平面毎に境界箱と球の小さい方の広がりで判定するので、どちらかが平面の外側なら見えない扱いになる
+        static void cull_bounds(const double* planes, const double* const* bounds, bool* visible, const std::size_t count);
+        static void cull_bounds(const float* planes, const float* const* bounds, bool* visible, const std::size_t count);
+
+    private:
+        simd() = default;
+
+        template <typename T>
+        static void multiply_scalar(const T* lhs, const T* rhs, T* result) {
+            T temporary[16];
+
+            for (auto i = 0; i < 4; ++i) {
+                for (auto j = 0; j < 4; ++j) {
+                    T m = 0;
+
+                    for (auto k = 0; k < 4; ++k) {
+                        m += lhs[i * 4 + k] * rhs[k * 4 + j];
+                    }
+
+                    temporary[i * 4 + j] = m;
+                }
+            }
+
+            std::memcpy(result, temporary, sizeof(temporary));
+        }
+
+        // 選択中の命令セットの乗算のカーネル (nullptr なら scalar 版を展開する)
+        // 他の翻訳単位の静的初期化で使われても、初期化前は 0 なので scalar 版で計算する
+        struct matrix_kernel {
+            void (*multiply)(const double*, const double*, double*);
+            void (*multiply_f)(const float*, const float*, float*);
+        };
+
+        static matrix_kernel matrix_kernels;
+    };
+}
@@ -1,61 +1,52 @@
-#include <random>
 #include <cmath>
+#include <limits>
 #include "vector4.h"
 #include "utility.h"
-
-namespace {
-    std::random_device seed_gen;
-    std::mt19937_64 random(seed_gen());
-}
+#include "batch.h"
+#include "random.h"
+#include "simd.h"
 
 namespace math {
 
+    // 呼び出したスレッドの系列を使う(一括で必要な場合は random::fill を使う)
     int utility::get_random(const int min, const int max) {
-        std::uniform_int_distribution<int>  distr(min, max);
-
-        return distr(random);
+        return random::get_int(min, max);
     }
 
-    // `Ɛ̓蔻
+    // 矩形と線分の当たり判定
     collision utility::collision_polygon_line(const vector4& polygon_point0, const vector4& polygon_point1,
                                               const vector4& polygon_point2, const vector4& polygon_point3,
                                               const vector4& line_start, const vector4& line_end) {
-        // ʂ̏Zbg
-        const auto normal = get_normal(polygon_point0, polygon_point1, polygon_point2);
-        const auto plane  = std::make_tuple(polygon_point0, normal);
-        auto result = std::make_tuple(false, vector4());
+        // 矩形を三角形に分けて判定(法線の正規化と平面との判定は不要)
+        const auto result = collision_triangle_line(polygon_point0, polygon_point1, polygon_point2, line_start, line_end);
 
-        // ʂƐ邩
-        if (!collision_plane_line(plane, line_start, line_end, result)) {
+        if (std::get<0>(result)) {
             return result;
         }
 
-        // ʂƂ̌_
-        const vector4 point = std::get<1>(result);
-
-        // `Op`ɕĔ
-        if (inside_triangle_point(polygon_point0, polygon_point1, polygon_point2, point)) {
-            std::get<0>(result) = true;
-            std::get<1>(result) = point;
-
-            return result;
-        }
-
-        if (inside_triangle_point(polygon_point1, polygon_point3, polygon_point2, point)) {
-            std::get<0>(result) = true;
-            std::get<1>(result) = point;
+        return collision_triangle_line(polygon_point1, polygon_point3, polygon_point2, line_start, line_end);
+    }
 
-            return result;
+    // 三角形と線分の当たり判定
+    collision utility::collision_triangle_line(const vector4& triangle_point0, const vector4& triangle_point1, const vector4& triangle_point2,
+                                               const vector4& line_start, const vector4& line_end) {
+        // 1 個分の座標列として simd class の判定を使う
+        const auto* p0 = triangle_point0.data();
+        const auto* p1 = triangle_point1.data();
+        const auto* p2 = triangle_point2.data();
+        const double* const triangle[] = { p0, p0 + 1, p0 + 2, p1, p1 + 1, p1 + 2, p2, p2 + 1, p2 + 2 };
+        auto ratio = std::numeric_limits<double>::max();
+
+        if (simd::intersect_segment_triangle(line_start.data(), line_end.data(), triangle, 1, ratio) != 0) {
+            return std::make_tuple(false, vector4());
         }
 
-        std::get<0>(result) = false;
-
-        return result;
+        return std::make_tuple(true, line_start.add_scaled(line_end - line_start, ratio));
     }
 
-    // ʂ̖@߂
+    // 面の法線を求める
     vector4 utility::get_normal(const vector4& point0, const vector4& point1, const vector4& point2) {
-        // ʂ̖@߂
+        // 面の法線を求める
         const auto v0 = point1 - point0;
         const auto v1 = point2 - point0;
         auto cross = v0.cross(v1);
@@ -63,30 +54,25 @@ namespace math {
         return cross.normalize();
     }
 
-    // Op`Ɠ_̓O(point ͕KOp`Ɠʂł鎖)
+    // 三角形と点の内外判定(point は必ず三角形と同平面である事)
     bool utility::inside_triangle_point(const vector4& triangle_point0, const vector4& triangle_point1, const vector4& triangle_point2, const vector4& point) {
         const auto v01 = triangle_point1 - triangle_point0;
         const auto v12 = triangle_point2 - triangle_point1;
         const auto v20 = triangle_point0 - triangle_point2;
-        const auto v0p = point - triangle_point0;
-        const auto v1p = point - triangle_point1;
-        const auto v2p = point - triangle_point2;
-
-        auto c0 = v01.cross(v0p);
-        auto c1 = v12.cross(v1p);
-        auto c2 = v20.cross(v2p);
-
-        c0.normalized();
-        c1.normalized();
-        c2.normalized();
+        const auto normal = v01.cross(triangle_point2 - triangle_point0);
+        const auto square = normal.dot(normal);
 
-        const auto dot01 = c0.dot(c1);
-        const auto dot02 = c0.dot(c2);
+        // 各辺の外積を法線方向に射影した値(辺関数)の符号で判定するので正規化は不要
+        // 許容幅は n . n に対する割合にして三角形の大きさに依らない様にする(batch::inside_triangle_point と同じ)
+        const auto tolerance = -batch::inside_tolerance<double> * square;
+        const auto w0 = v01.cross(point - triangle_point0).dot(normal);
+        const auto w1 = v12.cross(point - triangle_point1).dot(normal);
+        const auto w2 = v20.cross(point - triangle_point2).dot(normal);
 
-        return (dot01 > 0.0) && (dot02 > 0.0);
+        return (square > 0.0) && (w0 >= tolerance) && (w1 >= tolerance) && (w2 >= tolerance);
     }
 
-    // ʂƐ̓蔻
+    // 平面と線分の当たり判定
     bool utility::collision_plane_line(const plane& p, const vector4& line_start, const vector4& line_end, collision& result) {
         const vector4 plane_point  = std::get<0>(p);
         const vector4 plane_normal = std::get<1>(p);
@@ -99,7 +85,7 @@ namespace math {
         const auto ret = pattern_a || pattern_b;
 
         if (ret) {
-            // ʂƐ̌_
+            // 平面と線分の交点
             const auto line = line_end - line_start;
             const auto ratio = std::abs(dot_p_s) / (std::abs(dot_p_s) + std::abs(dot_p_e));
             const auto point = line_start + (line * ratio);
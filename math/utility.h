@@ -1,10 +1,9 @@
 #pragma once
 #include <tuple>
+#include "math_fwd.h"
 
 namespace math {
 
-    class vector4;
-
     using plane  = std::tuple<vector4/*point*/, vector4/*normal*/>;
     using collision = std::tuple<bool, vector4>;
 
@@ -13,11 +12,11 @@ namespace math {
         static constexpr double PI = 3.14159265358979;
         static constexpr double DEGREES_180 = 180.0;
 
-        static double degree_to_radian(double degree) {
+        static constexpr double degree_to_radian(double degree) {
             return degree * PI / DEGREES_180;
         }
 
-        static double radian_to_degree(double radion) {
+        static constexpr double radian_to_degree(double radion) {
             return radion * DEGREES_180 / PI;
         }
 
@@ -26,18 +25,22 @@ namespace math {
             return get_random(1, 2) == 1 ? true : false;
         }
 
-        // `Ɛ̓蔻
+        // 矩形と線分の当たり判定
         static collision collision_polygon_line(const vector4& polygon_point0, const vector4& polygon_point1,
                                                 const vector4& polygon_point2, const vector4& polygon_point3,
                                                 const vector4& line_start, const vector4& line_end);
 
-        // ʂ̖@߂
+        // 三角形と線分の当たり判定 (Moller-Trumbore 法、三角形の辺上も当たりとする)
+        static collision collision_triangle_line(const vector4& triangle_point0, const vector4& triangle_point1, const vector4& triangle_point2,
+                                                 const vector4& line_start, const vector4& line_end);
+
+        // 面の法線を求める
         static vector4 get_normal(const vector4& point0, const vector4& point1, const vector4& point2);
 
-        // Op`Ɠ_̓O(point ͕KOp`Ɠʂł鎖)
+        // 三角形と点の内外判定(point は必ず三角形と同平面である事。辺上の点は内側とする)
         static bool inside_triangle_point(const vector4& triangle_point0, const vector4& triangle_point1, const vector4& triangle_point2, const vector4& point);
 
-        // ʂƐ̕ӂ蔻
+        // 平面と線分の辺り判定
         static bool collision_plane_line(const plane& p, const vector4& line_start, const vector4& line_end, collision& result);
 
     private:
@@ -1,55 +1,90 @@
 #pragma once
+#include <type_traits>
+#include "math_fwd.h"
+#include "fast_math.h"
 
 namespace math {
-    class matrix44;
 
-    class vector4 {
+    // 仮想関数を持たない値型 (double は 32 byte、float は 16 byte 境界に配置する)
+    template <typename T>
+    class alignas(sizeof(T) * 4) basic_vector4 {
     public:
-        // RXgN^
-        vector4();
-        vector4(const double x, const double y, const double z) : x(x), y(y), z(z), w(1.0) {}
-        vector4(const double x, const double y, const double z, double w) : x(x), y(y), z(z), w(w) {}
-        vector4(const vector4&) = default; // Rs[
-        vector4(vector4&&) = default; // [u
+        using value_type = T;
 
-        // fXgN^
-        virtual ~vector4() = default;
+        // コンストラクタ
+        // 演算は constexpr なので定数の頂点や法線はコンパイル時に計算できる
+        constexpr basic_vector4() : x(0), y(0), z(0), w(1) {}
+        constexpr basic_vector4(const T x, const T y, const T z) : x(x), y(y), z(z), w(1) {}
+        constexpr basic_vector4(const T x, const T y, const T z, T w) : x(x), y(y), z(z), w(w) {}
+        basic_vector4(const basic_vector4&) = default; // コピー
+        basic_vector4(basic_vector4&&) = default; // ムーブ
 
-        vector4& operator =(const vector4&) = default; // Rs[
-        vector4& operator =(vector4&&) = default; // [u
+        // 精度の違う型からの変換
+        template <typename U>
+        constexpr explicit basic_vector4(const basic_vector4<U>& vector)
+            : x(static_cast<T>(vector.get_x())), y(static_cast<T>(vector.get_y())),
+              z(static_cast<T>(vector.get_z())), w(static_cast<T>(vector.get_w())) {}
 
-        vector4 operator +(const vector4& rhs) const;
-        vector4 operator -(const vector4& rhs) const;
+        basic_vector4& operator =(const basic_vector4&) = default; // コピー
+        basic_vector4& operator =(basic_vector4&&) = default; // ムーブ
 
-        vector4 operator *(const double rhs) const;
-        vector4 operator /(const double rhs) const;
+        constexpr basic_vector4 operator +(const basic_vector4& rhs) const { return basic_vector4(x + rhs.x, y + rhs.y, z + rhs.z); }
+        constexpr basic_vector4 operator -(const basic_vector4& rhs) const { return basic_vector4(x - rhs.x, y - rhs.y, z - rhs.z); }
 
-        vector4 operator *(const matrix44 rhs) const;
+        constexpr basic_vector4 operator *(const T rhs) const { return basic_vector4(x * rhs, y * rhs, z * rhs); }
+        constexpr basic_vector4 operator /(const T rhs) const { return basic_vector4(x / rhs, y / rhs, z / rhs); }
 
-        void set(const vector4& vector);
-        void set(const double x, const double y, const double z);
+        basic_vector4 operator *(const basic_matrix44<T>& rhs) const;
 
-        void add(const vector4& vector);
-        void add(const double x, const double y, const double z);
+        constexpr void set(const basic_vector4& vector) { x = vector.x; y = vector.y; z = vector.z; w = vector.w; }
+        constexpr void set(const T x, const T y, const T z) { this->x = x; this->y = y; this->z = z; }
 
-        double get_x() const { return x; }
-        double get_y() const { return y; }
-        double get_z() const { return z; }
-        double get_w() const { return w; }
+        constexpr void add(const basic_vector4& vector) { x += vector.x; y += vector.y; z += vector.z; }
+        constexpr void add(const T x, const T y, const T z) { this->x += x; this->y += y; this->z += z; }
+        // this += vector * scale
+        constexpr void add(const basic_vector4& vector, const T scale) { x += vector.x * scale; y += vector.y * scale; z += vector.z * scale; }
 
-        double length() const;
+        // this + vector * scale を途中のベクトルを作らずに求める
+        constexpr basic_vector4 add_scaled(const basic_vector4& vector, const T scale) const {
+            return basic_vector4(x + vector.x * scale, y + vector.y * scale, z + vector.z * scale);
+        }
 
+        constexpr T get_x() const { return x; }
+        constexpr T get_y() const { return y; }
+        constexpr T get_z() const { return z; }
+        constexpr T get_w() const { return w; }
+
+        // x, y, z, w の順で連続している
+        const T* data() const { return &x; }
+
+        T length() const;
+
+        // 正規化は fast でも precise と同じ計算をする(近似の方が速くならないため、mode は互換のために残している)
         void normalized();
-        vector4 normalize() const;
+        void normalized(const math_mode mode);
+        basic_vector4 normalize() const;
+        basic_vector4 normalize(const math_mode mode) const;
 
-        double dot(const vector4& rhs) const;
-        vector4 cross(const vector4& rhs) const;
+        constexpr T dot(const basic_vector4& rhs) const { return x * rhs.x + y * rhs.y + z * rhs.z; }
+
+        constexpr basic_vector4 cross(const basic_vector4& rhs) const {
+            return basic_vector4(y * rhs.z - z * rhs.y, z * rhs.x - x * rhs.z, x * rhs.y - y * rhs.x, 0);
+        }
 
     private:
-        double x;
-        double y;
-        double z;
-        double w;
+        T x;
+        T y;
+        T z;
+        T w;
     };
 
+    extern template class basic_vector4<double>;
+    extern template class basic_vector4<float>;
+
+    // 配列を memcpy でまとめてコピーしたり SIMD のアラインメント付きロードで扱える事
+    static_assert(sizeof(vector4) == sizeof(double) * 4 && alignof(vector4) == 32);
+    static_assert(sizeof(vector4f) == sizeof(float) * 4 && alignof(vector4f) == 16);
+    static_assert(std::is_trivially_copyable_v<vector4> && std::is_standard_layout_v<vector4>);
+    static_assert(std::is_trivially_copyable_v<vector4f> && std::is_standard_layout_v<vector4f>);
+
 } // math
@@ -2,8 +2,10 @@
 #include "camera_base.h"
 #include "vector4.h"
 #include "matrix44.h"
+#include "frustum.h"
 #include "utility.h"
 #include "dx_utility.h"
+#include "dx_math_policy.h"
 
 namespace {
     constexpr auto DEFAULT_POSITION_Z = -100.0;
@@ -24,6 +26,7 @@ namespace world {
         far_value = DEFAULT_FAR;
         fov = math::utility::degree_to_radian(DEFAULT_FOV_ANGLE);
         aspect = static_cast<double>(screen_width) / static_cast<double>(screen_height);
+        this->screen_height = screen_height;
 
 #if defined(_AMG_MATH)
         position = math::vector4(0.0, 0.0, DEFAULT_POSITION_Z);
@@ -58,31 +61,15 @@ namespace world {
 
 #if defined(_AMG_MATH)
     const math::matrix44 camera_base::get_view_matrix() const {
-        math::matrix44 camera_matrix = math::matrix44();
-
-        camera_matrix.look_at(position, target, up);
-
-        return camera_matrix;
+        return backend::camera_math<backend::object_math>::view(position, target, up);
     }
 
     const math::matrix44 camera_base::get_projection_matrix() const {
-        math::matrix44 projection_matrix = math::matrix44();
-
-        projection_matrix.perspective(fov, aspect, near_value, far_value);
-
-        return projection_matrix;
+        return backend::camera_math<backend::object_math>::projection(fov, aspect, near_value, far_value);
     }
 
     const math::matrix44 camera_base::get_billboard_matrix() const {
-        auto view_matrix = get_view_matrix();
-        auto inverse_matrix = view_matrix.get_inverse();
-
-        // sړ̓Jbg
-        inverse_matrix.set_value(3, 0, 0.0);
-        inverse_matrix.set_value(3, 1, 0.0);
-        inverse_matrix.set_value(3, 2, 0.0);
-
-        return inverse_matrix;
+        return backend::camera_math<backend::object_math>::billboard(get_view_matrix());
     }
 #else
     MATRIX camera_base::get_view_matrix() const {
@@ -94,14 +81,11 @@ namespace world {
     }
 
     MATRIX camera_base::get_billboard_matrix() const {
-        MATRIX view_matrix = get_view_matrix();
-        MATRIX inverse_matrix = MInverse(view_matrix);
-
-        inverse_matrix.m[3][0] = 0.0f;
-        inverse_matrix.m[3][1] = 0.0f;
-        inverse_matrix.m[3][2] = 0.0f;
-
-        return inverse_matrix;
+        return backend::camera_math<backend::object_math>::billboard(get_view_matrix());
     }
 #endif
+
+    const math::frustumf camera_base::get_frustum() const {
+        return math::frustumf(backend::camera_math<backend::object_math>::view_projection(get_view_matrix(), get_projection_matrix()));
+    }
 }
@@ -1,5 +1,6 @@
 #pragma once
 #include <functional>
+#include "math_fwd.h"
 #if defined(_AMG_MATH)
 #include "vector4.h"
 #else
@@ -7,21 +8,16 @@ struct tagVECTOR;
 struct tagMATRIX;
 #endif
 
-namespace math {
-    class vector4;
-    class matrix44;
-}
-
 namespace world {
 
     class camera_base {
     public:
-        // RXgN^
+        // コンストラクタ
         camera_base(int screen_width, int screen_height);
-        camera_base(const camera_base&) = default; // Rs[
-        camera_base(camera_base&&) = default; // [u
+        camera_base(const camera_base&) = default; // コピー
+        camera_base(camera_base&&) = default; // ムーブ
 
-         // fXgN^
+         // デストラクタ
         virtual ~camera_base() = default;
 
         virtual void process();
@@ -31,6 +27,8 @@ namespace world {
         void set_near(const double near_value) { this->near_value = near_value; }
         void set_far(const double far_value) { this->far_value = far_value; }
         void set_fov(const double fov) { this->fov = fov; }
+        double get_fov() const { return fov; }
+        int get_screen_height() const { return screen_height; }
 
 #if defined(_AMG_MATH)
         void set_position(const math::vector4& position) { this->position = position; }
@@ -53,6 +51,8 @@ namespace world {
         MATRIX get_projection_matrix() const;
         MATRIX get_billboard_matrix() const;
 #endif
+        // ビュー x 射影の行列から取り出した視錐台(カリング用)
+        const math::frustumf get_frustum() const;
 
     protected:
         std::function<void(camera_base*)> update;
@@ -61,6 +61,7 @@ namespace world {
         double far_value;
         double fov;
         double aspect;
+        int screen_height;
 
 #if defined(_AMG_MATH)
         math::vector4 position;
@@ -0,0 +1,107 @@
+//!
+//! @file dx_math_policy.h
+//!
+//! @brief DX ライブラリの VECTOR / MATRIX 関数の Policy と、オブジェクトが使う Policy (object_math)
+//!        Policy の関数は math_policy.h の amg_math と同じ
+//!
+#pragma once
+#include <cstring>
+#include "DxLib.h"
+#include "math_policy.h"
+
+namespace backend {
+
+    // DX ライブラリ (角度は度で受け取ってラジアンへ変換する)
+    struct dx_math {
+        using vector = VECTOR;
+        using matrix = MATRIX;
+        using camera_matrix = MATRIX;
+
+        static constexpr auto name = "dx";
+
+        static vector make_vector(const double x, const double y, const double z) {
+            return VGet(static_cast<float>(x), static_cast<float>(y), static_cast<float>(z));
+        }
+        static double get_x(const vector& vector) { return vector.x; }
+        static double get_y(const vector& vector) { return vector.y; }
+        static double get_z(const vector& vector) { return vector.z; }
+
+        static vector add(const vector& lhs, const vector& rhs) { return VAdd(lhs, rhs); }
+        static vector sub(const vector& lhs, const vector& rhs) { return VSub(lhs, rhs); }
+        static vector scale(const vector& vector, const double scale) { return VScale(vector, static_cast<float>(scale)); }
+        static double dot(const vector& lhs, const vector& rhs) { return VDot(lhs, rhs); }
+        static vector normalize(const vector& vector) { return VNorm(vector); }
+
+        static vector rotate_xy(const vector& vector, const double degree_x, const double degree_y) {
+            return VTransform(vector, MMult(MGetRotX(to_radian(degree_x)), MGetRotY(to_radian(degree_y))));
+        }
+
+        static vector rotate_y(const vector& vector, const double degree) {
+            return VTransform(vector, MGetRotY(to_radian(degree)));
+        }
+
+        static vector reflect_y(const vector& vector) {
+            return rotate_y(vector, 180.0);
+        }
+
+        static matrix rotate_matrix(const vector& rotation) {
+            return MMult(MMult(MGetRotX(to_radian(rotation.x)), MGetRotY(to_radian(rotation.y))), MGetRotZ(to_radian(rotation.z)));
+        }
+
+        static matrix scale_matrix(const vector& scale) { return MGetScale(scale); }
+        static matrix transfer_matrix(const vector& position) { return MGetTranslate(position); }
+
+        static matrix compose(const vector& scale, const matrix& rotate, const vector& position) {
+            return MMult(MMult(MGetScale(scale), rotate), MGetTranslate(position));
+        }
+
+        // SetCameraPositionAndTargetAndUpVec / SetupCamera_Perspective と同じ行列をカメラの設定を変えずに作る
+        static camera_matrix look_at(const vector& position, const vector& target, const vector& up) {
+            auto eye = position;
+            auto at = target;
+            auto up_vector = up;
+            MATRIX matrix;
+
+            CreateLookAtMatrix(&matrix, &eye, &at, &up_vector);
+
+            return matrix;
+        }
+
+        static camera_matrix perspective(const double fov, const double aspect, const double near_value, const double far_value) {
+            MATRIX matrix;
+
+            CreatePerspectiveFovMatrix(&matrix, static_cast<float>(fov), static_cast<float>(near_value), static_cast<float>(far_value), static_cast<float>(aspect));
+
+            return matrix;
+        }
+
+        static camera_matrix inverse_view(const camera_matrix& view) { return MInverse(view); }
+
+        static camera_matrix multiply(const camera_matrix& lhs, const camera_matrix& rhs) { return MMult(lhs, rhs); }
+
+        static double get_value(const matrix& matrix, const int row, const int column) { return matrix.m[row][column]; }
+        static void set_value(camera_matrix& matrix, const int row, const int column, const double value) { matrix.m[row][column] = static_cast<float>(value); }
+
+        // MATRIX と math::matrix44f はメモリ配置が同じ (dx_utility の ToMathF / ToDX と同じ変換)
+        static math::matrix44f to_math(const matrix& matrix) {
+            math::matrix44f result;
+
+            std::memcpy(result.data(), matrix.m, sizeof(matrix.m));
+
+            return result;
+        }
+
+        static math::vector4f to_math(const vector& vector) { return math::vector4f(vector.x, vector.y, vector.z); }
+        static const matrix& to_native(const math::matrix44f& matrix) { return *reinterpret_cast<const MATRIX*>(matrix.data()); }
+
+    private:
+        static float to_radian(const double degree) { return static_cast<float>(degree) * (DX_PI_F / 180.0f); }
+    };
+
+    // オブジェクトが使う Policy
+#if defined(_AMG_MATH)
+    using object_math = amg_math;
+#else
+    using object_math = dx_math;
+#endif
+}
@@ -78,7 +78,7 @@ namespace mv1 {
             return false;
         }
 
-        // transition.mv1  100 x 100 ̒_fȂ̂ŁAʂ̔䗦 1280 x 720 ɍ킹ăXP[O
+        // transition.mv1 は 100 x 100 の頂点モデルなので、画面の比率 1280 x 720 に合わせてスケーリングする
 #if defined(_AMG_MATH)
         set_scale(math::vector4(1.78, 1.0, 1.0));
 #else
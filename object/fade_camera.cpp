@@ -9,7 +9,7 @@ namespace world {
 
     fade_camera::fade_camera(int screen_width, int screen_height) : camera_base(screen_width, screen_height) {
         ortho = false;
-        // 185.0f ̓p[XyNeBuݒ(I[X͉̎łǂ)
+        // 185.0f はパースペクティブ設定(オースの時は何でも良い)
 #if defined(_AMG_MATH)
         position = math::vector4(0.0, 0.0, 185.0);
 #else
@@ -30,7 +30,7 @@ namespace world {
         SetCameraNearFar(near_value, far_value);
 
         if (ortho) {
-            // transition.mv1  100 x 100 TCY̒_Ȃ̂
+            // transition.mv1 は 100 x 100 サイズの頂点なので
             SetupCamera_Ortho(100.0f);
         }
     }
@@ -8,12 +8,12 @@ namespace mv1 {
 
     class gun : public model_base {
     public:
-        // RXgN^
+        // コンストラクタ
         gun();
-        gun(const gun&) = default; // Rs[
-        gun(gun&&) = default; // [u
+        gun(const gun&) = default; // コピー
+        gun(gun&&) = default; // ムーブ
 
-         // fXgN^
+         // デストラクタ
         virtual ~gun() = default;
 
         virtual bool initialize();
@@ -0,0 +1,262 @@
+//!
+//! @file math_policy.h
+//!
+//! @brief オブジェクトの計算を 数学ライブラリ(Policy) を差し替えられる様にまとめたもの
+//!
+//! @details
+//! Policy は 位置・行列の型 と それを扱う static 関数を持つ struct
+//!   amg_math : math ライブラリ (math::vector4 / math::matrix44f)
+//!   dx_math  : DX ライブラリの VECTOR / MATRIX 関数 (dx_math_policy.h)
+//! オブジェクトは _AMG_MATH で選ばれる object_math (dx_math_policy.h) を使い、
+//! カリングなど math ライブラリの float 版で計算する所へは to_math / to_native で変換して渡す(#if で分けない)
+//! benchmark_backend は同じ処理を両方の Policy で実体化して処理時間と誤差を比較する
+//! このヘッダーは DX ライブラリに依存しない
+//!
+#pragma once
+#include <tuple>
+#include "vector4.h"
+#include "matrix44.h"
+#include "quaternion.h"
+
+namespace backend {
+
+    // math ライブラリ
+    struct amg_math {
+        using vector = math::vector4;
+        using matrix = math::matrix44f; // 描画用 (DX ライブラリへそのまま渡せる float 版)
+        using camera_matrix = math::matrix44;
+
+        static constexpr auto name = "amg";
+
+        static vector make_vector(const double x, const double y, const double z) { return vector(x, y, z); }
+        static double get_x(const vector& vector) { return vector.get_x(); }
+        static double get_y(const vector& vector) { return vector.get_y(); }
+        static double get_z(const vector& vector) { return vector.get_z(); }
+
+        static vector add(const vector& lhs, const vector& rhs) { return lhs + rhs; }
+        static vector sub(const vector& lhs, const vector& rhs) { return lhs - rhs; }
+        static vector scale(const vector& vector, const double scale) { return vector * scale; }
+        static double dot(const vector& lhs, const vector& rhs) { return lhs.dot(rhs); }
+        static vector normalize(const vector& vector) { return vector.normalize(); }
+
+        // X 軸 -> Y 軸の順に回転する(度)
+        static vector rotate_xy(const vector& vector, const double degree_x, const double degree_y) {
+            auto rotate = math::matrix44();
+
+            rotate.rotate_x(degree_x, true);
+            rotate.rotate_y(degree_y, false);
+
+            return vector * rotate;
+        }
+
+        static vector rotate_y(const vector& vector, const double degree) {
+            auto rotate = math::matrix44();
+
+            rotate.rotate_y(degree, true);
+
+            return vector * rotate;
+        }
+
+        // Y 軸 180 度回転はコンパイル時に作っておく
+        static vector reflect_y(const vector& vector) {
+            constexpr auto reflect = [] {
+                auto matrix = math::matrix44();
+
+                matrix.rotate_y(180.0, true);
+
+                return matrix;
+            }();
+
+            return vector * reflect;
+        }
+
+        // オイラー角 (度、X -> Y -> Z) の回転行列
+        static matrix rotate_matrix(const vector& rotation) {
+            const auto rotation_f = math::vector4f(rotation);
+
+            return math::quaternionf::from_euler(rotation_f.get_x(), rotation_f.get_y(), rotation_f.get_z()).to_matrix();
+        }
+
+        static matrix scale_matrix(const vector& scale) {
+            const auto scale_f = math::vector4f(scale);
+            auto matrix = math::matrix44f();
+
+            matrix.scale(scale_f.get_x(), scale_f.get_y(), scale_f.get_z(), true);
+
+            return matrix;
+        }
+
+        static matrix transfer_matrix(const vector& position) {
+            const auto position_f = math::vector4f(position);
+            auto matrix = math::matrix44f();
+
+            matrix.transfer(position_f.get_x(), position_f.get_y(), position_f.get_z(), true);
+
+            return matrix;
+        }
+
+        // スケール x 回転 x 平行移動
+        static matrix compose(const vector& scale, const matrix& rotate, const vector& position) {
+            return math::matrix44f::compose(math::vector4f(scale), rotate, math::vector4f(position));
+        }
+
+        static camera_matrix look_at(const vector& position, const vector& target, const vector& up) {
+            auto matrix = camera_matrix();
+
+            matrix.look_at(position, target, up);
+
+            return matrix;
+        }
+
+        static camera_matrix perspective(const double fov, const double aspect, const double near_value, const double far_value) {
+            auto matrix = camera_matrix();
+
+            matrix.perspective(fov, aspect, near_value, far_value);
+
+            return matrix;
+        }
+
+        // ビュー行列は回転 x 平行移動のみなので一般の逆行列は不要
+        static camera_matrix inverse_view(const camera_matrix& view) { return view.affine_inverse(); }
+
+        static camera_matrix multiply(const camera_matrix& lhs, const camera_matrix& rhs) { return lhs * rhs; }
+
+        static double get_value(const matrix& matrix, const int row, const int column) { return matrix.get_value(row, column); }
+        static double get_value(const camera_matrix& matrix, const int row, const int column) { return matrix.get_value(row, column); }
+        static void set_value(camera_matrix& matrix, const int row, const int column, const double value) { matrix.set_value(row, column, value); }
+
+        // カリングや batch が使う math ライブラリの float 版との変換 (matrix は float 版そのものなので変換しない)
+        static const math::matrix44f& to_math(const matrix& matrix) { return matrix; }
+        static math::matrix44f to_math(const camera_matrix& matrix) { return math::matrix44f(matrix); }
+        static math::vector4f to_math(const vector& vector) { return math::vector4f(vector); }
+        static const matrix& to_native(const math::matrix44f& matrix) { return matrix; }
+    };
+
+    // 姿勢 (posture_base)
+    template <typename Policy>
+    class posture_math {
+    public:
+        using vector = typename Policy::vector;
+        using matrix = typename Policy::matrix;
+
+        struct matrices {
+            matrix scale;
+            matrix rotate;
+            matrix transfer;
+            matrix posture;
+        };
+
+        // 回転はオイラー角 (度) で指定する
+        static matrices make(const vector& scale, const vector& rotation, const vector& position) {
+            return make(scale, Policy::rotate_matrix(rotation), position);
+        }
+
+        static matrices make(const vector& scale, const matrix& rotate, const vector& position) {
+            return { Policy::scale_matrix(scale), rotate, Policy::transfer_matrix(position), Policy::compose(scale, rotate, position) };
+        }
+
+    private:
+        posture_math() = default;
+    };
+
+    // カメラ (camera_base)
+    template <typename Policy>
+    class camera_math {
+    public:
+        using vector = typename Policy::vector;
+        using camera_matrix = typename Policy::camera_matrix;
+
+        static camera_matrix view(const vector& position, const vector& target, const vector& up) {
+            return Policy::look_at(position, target, up);
+        }
+
+        static camera_matrix projection(const double fov, const double aspect, const double near_value, const double far_value) {
+            return Policy::perspective(fov, aspect, near_value, far_value);
+        }
+
+        // 視錐台を取り出すためのビュー x 射影の行列 (math ライブラリの float 版)
+        static math::matrix44f view_projection(const camera_matrix& view, const camera_matrix& projection) {
+            return Policy::to_math(Policy::multiply(view, projection));
+        }
+
+        // ビュー行列の逆行列から平行移動成分をカットする
+        static camera_matrix billboard(const camera_matrix& view) {
+            auto matrix = Policy::inverse_view(view);
+
+            Policy::set_value(matrix, 3, 0, 0.0);
+            Policy::set_value(matrix, 3, 1, 0.0);
+            Policy::set_value(matrix, 3, 2, 0.0);
+
+            return matrix;
+        }
+
+    private:
+        camera_math() = default;
+    };
+
+    // 移動とジャンプ (player)
+    template <typename Policy>
+    class player_math {
+    public:
+        using vector = typename Policy::vector;
+
+        // direction へ movement 分進めた位置と移動量
+        static std::tuple<vector, vector> forward(const vector& position, const vector& direction, const double movement) {
+            const auto moved = Policy::scale(direction, movement);
+
+            return { Policy::add(position, moved), moved };
+        }
+
+        static vector rotate_direction(const vector& direction, const double degree) {
+            return Policy::rotate_y(direction, degree);
+        }
+
+        // power の水平 (-Z) のベクトルを angle の角度で傾けて、rotation_y の向きに合わせる
+        static vector jump_velocity(const double power, const double angle, const double rotation_y) {
+            return Policy::rotate_xy(Policy::make_vector(0.0, 0.0, -power), angle, rotation_y);
+        }
+
+        static vector reflect_velocity(const vector& velocity) {
+            return Policy::reflect_y(velocity);
+        }
+
+        // 放物線の式 y = y0 + v0t - 1/2gt^2
+        static vector jump_position(const vector& start, const vector& velocity, const double timer, const double gravity) {
+            const auto jump_position = Policy::add(start, Policy::scale(velocity, timer));
+
+            return Policy::add(jump_position, Policy::make_vector(0.0, -(0.5 * gravity * timer * timer), 0.0));
+        }
+
+    private:
+        player_math() = default;
+    };
+
+    // ホーミング (missile)
+    template <typename Policy>
+    class missile_math {
+    public:
+        using vector = typename Policy::vector;
+
+        // position から target への単位ベクトル
+        static vector to_target(const vector& position, const vector& target) {
+            return Policy::normalize(Policy::sub(target, position));
+        }
+
+        // 姿勢の Y 軸 (進行方向) から target への回転を rate の割合だけ加える
+        // (100% の回転を加えると必ず当たってしまうので補間する)
+        static math::quaternionf homing(const math::quaternionf& posture, const vector& position, const vector& target, const float rate) {
+            const auto to = to_target(position, target);
+            const auto to_f = math::vector4f(static_cast<float>(Policy::get_x(to)), static_cast<float>(Policy::get_y(to)), static_cast<float>(Policy::get_z(to)));
+            const auto y = posture.rotate(math::vector4f(0.0f, 1.0f, 0.0f));
+            const auto rotate = math::quaternionf::from_to(y, to_f);
+            auto result = posture * math::quaternionf::lerp(math::quaternionf(), rotate, rate);
+
+            result.normalized();
+
+            return result;
+        }
+
+    private:
+        missile_math() = default;
+    };
+}
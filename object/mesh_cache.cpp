@@ -0,0 +1,42 @@
+#include <map>
+#include <mutex>
+#include "DxLib.h"
+#include "mesh_cache.h"
+
+namespace {
+    std::mutex cache_mutex;
+    std::map<primitive::mesh_key, primitive::shared_mesh> cache;
+}
+
+namespace primitive {
+
+    shared_mesh mesh_cache::get(const mesh_key& key, const std::function<shared_mesh()>& create) {
+        std::lock_guard<std::mutex> lock(cache_mutex);
+
+        const auto it = cache.find(key);
+
+        if (it != cache.end()) {
+            return it->second;
+        }
+
+        auto mesh = create();
+
+        if (mesh.vertex == nullptr || mesh.index == nullptr) {
+            return mesh;
+        }
+
+        return cache.emplace(key, std::move(mesh)).first->second;
+    }
+
+    void mesh_cache::clear() {
+        std::lock_guard<std::mutex> lock(cache_mutex);
+
+        cache.clear();
+    }
+
+    std::size_t mesh_cache::size() {
+        std::lock_guard<std::mutex> lock(cache_mutex);
+
+        return cache.size();
+    }
+}
@@ -0,0 +1,45 @@
+#pragma once
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+
+struct tagVERTEX3D;
+
+namespace primitive {
+
+    // インデックスは 32bit で持つ(描画時に 16bit の範囲毎に分ける)
+    using index_type = unsigned int;
+
+    // 生成したメッシュの種類とパラメータ (種類, 大きさ, 分割数, その他)
+    using mesh_key = std::tuple<std::string, double, int, int>;
+
+    // 描画用のチャンクと GPU のバッファ(定義は primitive_base.h)
+    struct mesh_draw;
+
+    // draw はメッシュと一緒に登録しておき、同じメッシュを使う全てのインスタンスで 1 度だけ転送する
+    struct shared_mesh {
+        std::shared_ptr<std::vector<tagVERTEX3D>> vertex;
+        std::shared_ptr<std::vector<index_type>> index;
+        std::shared_ptr<mesh_draw> draw;
+    };
+
+    // 同じパラメータで生成したメッシュをプロセス全体で共有する
+    // 共有したメッシュは全てのインスタンスから見えるので書き換えない
+    class mesh_cache {
+    public:
+        // key のメッシュが無ければ create で作って登録する(create が空のメッシュを返した場合は登録しない)
+        // create はロックを取得したまま呼ぶので、中で mesh_cache を使わない
+        static shared_mesh get(const mesh_key& key, const std::function<shared_mesh()>& create);
+
+        // 登録を解除する(使用中のインスタンスのメッシュと GPU のバッファは残る)
+        // GPU のバッファを解放するため、インスタンスを破棄してから DxLib_End の前に呼ぶ
+        static void clear();
+        static std::size_t size();
+
+    private:
+        mesh_cache() = default;
+    };
+}
@@ -0,0 +1,158 @@
+#include <algorithm>
+#include "DxLib.h"
+#include "mesh_renderer.h"
+#include "vector4.h"
+#include "matrix44.h"
+#include "dx_utility.h"
+
+namespace {
+    // 転送用バッファの大きさ(16bit インデックスのチャンク 1 つ分)
+    constexpr auto STREAM_VERTEX_NUM = 65536;
+    constexpr auto STREAM_INDEX_NUM = 65536 * 3;
+
+    std::shared_ptr<primitive::mesh_renderer> default_renderer;
+}
+
+namespace primitive {
+
+    dx_mesh_renderer::dx_mesh_renderer() {
+        stream_vertex_buffer = -1;
+        stream_index_buffer = -1;
+        stream_vertex_offset = 0;
+        stream_index_offset = 0;
+    }
+
+    dx_mesh_renderer::~dx_mesh_renderer() {
+        for (auto i = 0; i < static_cast<int>(buffer_list.size()); ++i) {
+            delete_buffer(i);
+        }
+
+        if (stream_vertex_buffer != -1) {
+            DeleteVertexBuffer(stream_vertex_buffer);
+        }
+
+        if (stream_index_buffer != -1) {
+            DeleteIndexBuffer(stream_index_buffer);
+        }
+    }
+
+    int dx_mesh_renderer::create_buffer(std::span<const VERTEX3D> vertex, std::span<const unsigned short> index) {
+        const auto vertex_num = static_cast<int>(vertex.size());
+        const auto index_num = static_cast<int>(index.size());
+        const auto vertex_buffer = CreateVertexBuffer(vertex_num, DX_VERTEX_TYPE_NORMAL_3D);
+        const auto index_buffer = CreateIndexBuffer(index_num, DX_INDEX_TYPE_16BIT);
+
+        if (vertex_buffer == -1 || index_buffer == -1
+            || SetVertexBufferData(0, vertex.data(), vertex_num, vertex_buffer) == -1
+            || SetIndexBufferData(0, index.data(), index_num, index_buffer) == -1) {
+            if (vertex_buffer != -1) {
+                DeleteVertexBuffer(vertex_buffer);
+            }
+
+            if (index_buffer != -1) {
+                DeleteIndexBuffer(index_buffer);
+            }
+
+            return -1;
+        }
+
+        const auto info = buffer_info{ vertex_buffer, index_buffer };
+        const auto it = std::find_if(buffer_list.begin(), buffer_list.end(), [](const auto& buffer) { return buffer.vertex_buffer == -1; });
+
+        if (it != buffer_list.end()) {
+            *it = info;
+
+            return static_cast<int>(it - buffer_list.begin());
+        }
+
+        buffer_list.emplace_back(info);
+
+        return static_cast<int>(buffer_list.size()) - 1;
+    }
+
+    void dx_mesh_renderer::delete_buffer(const int buffer) {
+        if (buffer < 0 || buffer >= static_cast<int>(buffer_list.size()) || buffer_list[buffer].vertex_buffer == -1) {
+            return;
+        }
+
+        DeleteVertexBuffer(buffer_list[buffer].vertex_buffer);
+        DeleteIndexBuffer(buffer_list[buffer].index_buffer);
+
+        buffer_list[buffer] = { -1, -1 };
+    }
+
+    bool dx_mesh_renderer::draw_buffer(const int buffer, const int handle, const int transparent) {
+        if (buffer < 0 || buffer >= static_cast<int>(buffer_list.size()) || buffer_list[buffer].vertex_buffer == -1) {
+            return false;
+        }
+
+        const auto& info = buffer_list[buffer];
+
+        return (-1 != DrawPolygonIndexed3D_UseVertexBuffer(info.vertex_buffer, info.index_buffer, handle, transparent));
+    }
+
+    // 転送用バッファへ書き込んだ範囲だけを描画する(入らない大きさは DX ライブラリの転送に任せる)
+    bool dx_mesh_renderer::draw_stream(std::span<const VERTEX3D> vertex, std::span<const unsigned short> index, const int handle, const int transparent) {
+        const auto vertex_num = static_cast<int>(vertex.size());
+        const auto index_num = static_cast<int>(index.size());
+
+        if (stream_vertex_buffer == -1 && vertex_num <= STREAM_VERTEX_NUM && index_num <= STREAM_INDEX_NUM) {
+            stream_vertex_buffer = CreateVertexBuffer(STREAM_VERTEX_NUM, DX_VERTEX_TYPE_NORMAL_3D);
+            stream_index_buffer = CreateIndexBuffer(STREAM_INDEX_NUM, DX_INDEX_TYPE_16BIT);
+        }
+
+        if (stream_vertex_buffer == -1 || stream_index_buffer == -1 || vertex_num > STREAM_VERTEX_NUM || index_num > STREAM_INDEX_NUM) {
+            return (-1 != DrawPolygonIndexed3D(vertex.data(), vertex_num, index.data(), index_num / 3, handle, transparent));
+        }
+
+        // 入らなければ先頭から書き直す(二重化はしていないので、直前の描画が読んでいる範囲でも書き換える)
+        if (stream_vertex_offset + vertex_num > STREAM_VERTEX_NUM || stream_index_offset + index_num > STREAM_INDEX_NUM) {
+            stream_vertex_offset = 0;
+            stream_index_offset = 0;
+        }
+
+        SetVertexBufferData(stream_vertex_offset, vertex.data(), vertex_num, stream_vertex_buffer);
+        SetIndexBufferData(stream_index_offset, index.data(), index_num, stream_index_buffer);
+
+        const auto result = DrawPrimitiveIndexed3D_UseVertexBuffer2(stream_vertex_buffer, stream_index_buffer, DX_PRIMTYPE_TRIANGLELIST,
+                                                                    stream_vertex_offset, 0, vertex_num, stream_index_offset, index_num, handle, transparent);
+
+        stream_vertex_offset += vertex_num;
+        stream_index_offset += index_num;
+
+        return (-1 != result);
+    }
+
+    void dx_mesh_renderer::set_transform(const math::matrix44f& world) {
+        SetTransformToWorld(&ToDX(world));
+    }
+
+    void dx_mesh_renderer::set_lighting(const int lighting) {
+        SetUseLighting(lighting);
+    }
+
+    void dx_mesh_renderer::set_z_buffer(const bool use, const bool write) {
+        SetUseZBuffer3D(use ? TRUE : FALSE);
+        SetWriteZBuffer3D(write ? TRUE : FALSE);
+    }
+
+    void dx_mesh_renderer::set_texture_wrap(const bool wrap) {
+        SetTextureAddressMode(wrap ? DX_TEXADDRESS_WRAP : DX_TEXADDRESS_CLAMP);
+    }
+
+    void dx_mesh_renderer::draw_line(const math::vector4f& start, const math::vector4f& end, const unsigned int color) {
+        DrawLine3D(ToDX(start), ToDX(end), color);
+    }
+
+    std::shared_ptr<mesh_renderer> get_default_renderer() {
+        if (default_renderer == nullptr) {
+            default_renderer = std::make_shared<dx_mesh_renderer>();
+        }
+
+        return default_renderer;
+    }
+
+    void set_default_renderer(const std::shared_ptr<mesh_renderer>& renderer) {
+        default_renderer = renderer;
+    }
+}
@@ -0,0 +1,82 @@
+#pragma once
+#include <memory>
+#include <span>
+#include <vector>
+#include "math_fwd.h"
+
+struct tagVERTEX3D;
+
+namespace primitive {
+
+    // プリミティブの描画の方法
+    // primitive_base は DX ライブラリを直接呼ばずにこれを通して描画するので、呼び出しを記録する実装へ差し替えられる
+    class mesh_renderer {
+    public:
+        virtual ~mesh_renderer() = default;
+
+        // 静的なメッシュを GPU のバッファへ 1 度だけ転送する(失敗したら -1)
+        virtual int create_buffer(std::span<const tagVERTEX3D> vertex, std::span<const unsigned short> index) = 0;
+        virtual void delete_buffer(const int buffer) = 0;
+        virtual bool draw_buffer(const int buffer, const int handle, const int transparent) = 0;
+
+        // 動的なメッシュは描画の度に転送する
+        virtual bool draw_stream(std::span<const tagVERTEX3D> vertex, std::span<const unsigned short> index, const int handle, const int transparent) = 0;
+
+        // 以降の描画の状態(描画し終えたら world は単位行列、lighting は TRUE、wrap は false へ戻す)
+        virtual void set_transform(const math::matrix44f& world) = 0;
+        virtual void set_lighting(const int lighting) = 0;
+        virtual void set_z_buffer(const bool use, const bool write) = 0;
+        // テクスチャ座標の 0 ～ 1 の外を繰り返す(false なら端の色で止める)
+        virtual void set_texture_wrap(const bool wrap) = 0;
+
+        // デバッグ表示の線(ワールド座標)
+        virtual void draw_line(const math::vector4f& start, const math::vector4f& end, const unsigned int color) = 0;
+    };
+
+    // DX ライブラリの頂点・インデックスバッファ
+    // 動的なメッシュは 1 組の転送用バッファを使い回して描画する
+    // 同じフレームの描画が前の描画の範囲を上書きしない様に続きへ書き込み、末尾に届いたら先頭から書き直す
+    // GPU の描画を待つ仕組み (フェンス) は持たないので、使用中の範囲を書き直す時の同期は DX ライブラリ (Direct3D) に任せる
+    class dx_mesh_renderer : public mesh_renderer {
+    public:
+        // コンストラクタ
+        dx_mesh_renderer();
+        dx_mesh_renderer(const dx_mesh_renderer&) = delete;
+
+        // デストラクタ
+        virtual ~dx_mesh_renderer();
+
+        int create_buffer(std::span<const tagVERTEX3D> vertex, std::span<const unsigned short> index) override;
+        void delete_buffer(const int buffer) override;
+        bool draw_buffer(const int buffer, const int handle, const int transparent) override;
+
+        bool draw_stream(std::span<const tagVERTEX3D> vertex, std::span<const unsigned short> index, const int handle, const int transparent) override;
+
+        void set_transform(const math::matrix44f& world) override;
+        void set_lighting(const int lighting) override;
+        void set_z_buffer(const bool use, const bool write) override;
+        void set_texture_wrap(const bool wrap) override;
+
+        void draw_line(const math::vector4f& start, const math::vector4f& end, const unsigned int color) override;
+
+    private:
+        // 削除した番号は vertex_buffer を -1 にして再利用する
+        struct buffer_info {
+            int vertex_buffer;
+            int index_buffer;
+        };
+
+        std::vector<buffer_info> buffer_list;
+
+        int stream_vertex_buffer;
+        int stream_index_buffer;
+        int stream_vertex_offset;
+        int stream_index_offset;
+    };
+
+    // primitive_base が初期状態で使う描画 (dx_mesh_renderer)
+    // DX ライブラリを初期化しない場合は先に recording_mesh_renderer などへ差し替える
+    // DxLib_End の前に nullptr を設定して解放する(次の get_default_renderer で作り直す)
+    std::shared_ptr<mesh_renderer> get_default_renderer();
+    void set_default_renderer(const std::shared_ptr<mesh_renderer>& renderer);
+}
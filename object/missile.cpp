@@ -1,25 +1,25 @@
 //!
 //! @file missile.h
 //!
-//! @brief ~TC̃fNX
+//! @brief ミサイルのモデルを扱うクラス
 //!
 //! @details
-//!  ~TCdl
-//! ˂܂ł͓莞ԂŃJEg_EsAb̕`s
-//! ˌ̓~TCI܂ player class ̍W x̕`s
-//! ˌ͓莞Ԃ܂Ő^ɒi
-//! 莞Ԍ player class ̍WɃz[~O
-//! z[~O ̊Ԋuœ̊ōs
-//! z[~O͓̍ƏI
+//! ■ ミサイル動作仕様
+//! 発射までは特定時間でカウントダウンを行い、秒の文字列描画も行う
+//! 発射後はミサイル処理が終わるまで player class の座標に 警告の文字描画を行う
+//! 発射後は特定時間まで真上に直進する
+//! 特定時間後は player class の座標にホーミングする
+//! ホーミング処理は 特定の間隔で特定の割合で行う
+//! ホーミング中は特定の高さを下回ると処理を終了する
 //!
-//!  ~TC̎p
-//! oϐ posture(MATRIX^)̊es̒l
-//! pp̂ꂼ x / y/ z (xNg)̒lƂĎgp
-//! (K Ƃĉ]sƂĈ)
+//! ■ ミサイルの姿勢制御
+//! メンバ変数の posture(クォータニオン)で姿勢を保持する
+//! 進行方向は posture で回転した Y 軸で、ホーミングは Y 軸から player への回転を割合分だけ補間して行う
+//! (3 軸を個別に正規化しないので正規直交基底が崩れない)
 //!
-//!  ʕ`ɂ
-//! ʂ̉E 1/4 ̗̈ɕʕ`揈sA˒̃~TC̎plɂ
-//! eNX`_OƉʕ` 2 ̕@ōsAIׂlɎ
+//! ■ 別描画について
+//! 画面の右上 1/4 の領域に別描画処理を行い、発射中のミサイルの姿勢を見える様にする
+//! テクスチャレンダリングと画面分割描画の 2 つの方法で行える、且つ選べる様に実装
 //!
 #include <cstring>
 #include <cmath>
@@ -30,31 +30,33 @@
 #include "primitive_sphere.h"
 #include "missile.h"
 #include "dx_utility.h"
+#include "dx_math_policy.h"
 #include "vector4.h"
+#include "matrix44.h"
 #include "utility.h"
 
 namespace {
     constexpr auto render_texture_camera_distance = 1000.0;
     constexpr auto render_separate_camera_distance = 3500.0;
-    constexpr auto model_scale = 0.2; // f̕`XP[
-    constexpr auto count_down_millisecond = 5000; // ˂܂ł̃JEg_E
-    constexpr auto launch_millisecond = 2000; // ˌ̒i
-    constexpr auto homing_millisecond = 100; // z[~O̊Ԋu
-    constexpr auto homing_end_y = 50.0; // e Y l
-    constexpr auto default_velocity = 20.0f; // ړ
-    constexpr auto default_homing_rate = 0.2f; // z[~O銄
-    constexpr auto explode_add_angle = 15.0; // ̉]
-    constexpr auto explode_multi_scale = 1.075; // ̃XP[
-    constexpr auto explode_end_scale = 20.0; // ̍ŏIXP[
-    constexpr auto line_width = 10; // ʘg`p̃C̑
-    constexpr auto separate_distance = 3250.0f; // ʘg`掞̃fƃJ̋
-    constexpr auto warning_text_offset_y = 130.0f; // x`̃ItZbgl
-    constexpr auto text_format = _T("%.2f"); // JEg_Ep
-    constexpr auto warning_message = _T("W A R N I N G"); // vC[p̌x
-    const auto text_color = GetColor(255, 255, 0); // `p
-    const auto line_color = GetColor(32, 32, 32); // ʘg`p
-
-    // ʘg`p̊e 1 xvZΗǂl
+    constexpr auto model_scale = 0.2; // モデルの描画スケール
+    constexpr auto count_down_millisecond = 5000; // 発射までのカウントダウン
+    constexpr auto launch_millisecond = 2000; // 発射後の直進時間
+    constexpr auto homing_millisecond = 100; // ホーミング処理の間隔
+    constexpr auto homing_end_y = 50.0; // 着弾判定の Y 値
+    constexpr auto default_velocity = 20.0f; // 移動量
+    constexpr auto default_homing_rate = 0.2f; // ホーミングする割合
+    constexpr auto explode_add_angle = 15.0; // 爆発の回転
+    constexpr auto explode_multi_scale = 1.075; // 爆発のスケール
+    constexpr auto explode_end_scale = 20.0; // 爆発の最終スケール
+    constexpr auto line_width = 10; // 別枠描画用のラインの太さ
+    constexpr auto separate_distance = 3250.0f; // 別枠描画時のモデルとカメラの距離
+    constexpr auto warning_text_offset_y = 130.0f; // 警告描画のオフセット値
+    constexpr auto text_format = _T("%.2f"); // カウントダウン用
+    constexpr auto warning_message = _T("W A R N I N G"); // プレイヤー用の警告
+    const auto text_color = GetColor(255, 255, 0); // 文字描画用
+    const auto line_color = GetColor(32, 32, 32); // 別枠描画用
+
+    // 別枠描画用の各種 1 度だけ計算すれば良い値
     auto half_width = 0;
     auto half_height = 0;
     auto quarter_width = 0;
@@ -74,7 +76,7 @@ namespace mv1 {
         player = nullptr;
         explosion = nullptr;
 
-        posture = MGetIdent();
+        posture = math::quaternionf();
         fire_point = VGet(0.0f, 0.0f, 0.0f);
 
         velocity = default_velocity;
@@ -116,8 +118,8 @@ namespace mv1 {
             return false;
         }
 
-        // ʘg`p̒lvZ
-        // ʂ̉EŁA傫͉ʂ 1/4 
+        // 別枠描画用の値を計算
+        // 画面の右上で、大きさは画面の 1/4 
         half_width = screen_width / 2;
         half_height = screen_height / 2;
         quarter_width = half_width / 2;
@@ -126,28 +128,28 @@ namespace mv1 {
         line_width_pos = base_width + line_width;
         line_height_pos = quarter_height - line_width;
 
-        // eNX`_Op̉摜쐬
+        // テクスチャレンダリング用の画像作成
         render_texture_handle = MakeScreen(quarter_width, quarter_height);
 
         if (-1 == render_texture_handle) {
             return false;
         }
 
-       // ʉʕ`ݒ肷
+       // 別画面描画を設定する
        auto post_render = [this](void) -> void {
            render_screen();
        };
 
        world->set_post_render(post_render);
 
-        // f傫̂ŃXP[
+        // モデルが大きいのでスケールをかける
 #if defined(_AMG_MATH)
         set_scale(math::vector4(model_scale, model_scale, model_scale));
 #else
         set_scale(VGet(model_scale, model_scale, model_scale));
 #endif
 
-        // DrawString pɕ`敶̔̉vZ
+        // DrawString 用に描画文字列の半分の横幅を計算する
         const auto count_down_text = _T("0.00");
 
         count_down.offset_x = GetDrawStringWidth(count_down_text, std::strlen(count_down_text)) / 2;
@@ -157,7 +159,7 @@ namespace mv1 {
     }
 
     bool missile::initialize_click_screen() {
-        // XN[ʂ}EXNbN 3D Ԃ̒nʈʒu擾鏈
+        // スクリーン画面をマウス左クリックしたら 3D 空間の地面位置を取得する処理
         auto ground = std::make_tuple(math::vector4(), math::vector4(0.0, 1.0, 0.0));
         auto setup_missile = [this, ground](posture_base* base)-> void {
             if (is_stand_by()) {
@@ -186,7 +188,7 @@ namespace mv1 {
     }
 
     bool missile::initialize_camera() {
-        // ~TCʕ`悷邽߂̃J
+        // ミサイルを別描画するためのカメラ
         std::shared_ptr<world::camera_base> missile_camera(new world::camera_base(screen_width, screen_height));
 
         auto update_missile_camera = [this](world::camera_base* base)-> void {
@@ -223,38 +225,26 @@ namespace mv1 {
         return GetNowCount() - count_start_time;
     }
 
-    VECTOR missile::get_posture_x() const {
-        return VGet(posture.m[0][0], posture.m[0][1], posture.m[0][2]);
-    }
-
     VECTOR missile::get_posture_y() const {
-        return VGet(posture.m[1][0], posture.m[1][1], posture.m[1][2]);
-    }
+        const auto y = posture.rotate(math::vector4f(0.0f, 1.0f, 0.0f));
 
-    VECTOR missile::get_posture_z() const {
-        return VGet(posture.m[2][0], posture.m[2][1], posture.m[2][2]);
+        return ToDX(y);
     }
 
-    void missile::set_posture(const VECTOR& x, const VECTOR& y, const VECTOR& z) {
-        posture.m[0][0] = x.x; posture.m[0][1] = x.y; posture.m[0][2] = x.z;
-        posture.m[1][0] = y.x; posture.m[1][1] = y.y; posture.m[1][2] = y.z;
-        posture.m[2][0] = z.x; posture.m[2][1] = z.y; posture.m[2][2] = z.z;
-    }
-
-    // 3D WXN[Wɕϊ
+    // 3D 座標をスクリーン座標に変換
     std::tuple<bool, int, int> missile::check_in_screen(const VECTOR& position) const {
         VECTOR screeen = ConvWorldPosToScreenPos(position);
         auto x = static_cast<int>(screeen.x);
         auto y = static_cast<int>(screeen.y);
         auto in_x = (x >= 0) && (x < screen_width);
         auto in_y = (y >= 0) && (y < screen_height);
-        auto in_z = (screeen.z > 0.0f) && (screeen.z < 1.0f); // ConvWorldPosToScreenPos ̎dl
+        auto in_z = (screeen.z > 0.0f) && (screeen.z < 1.0f); // ConvWorldPosToScreenPos の仕様
         auto in = in_x && in_y && in_z;
 
         return std::make_tuple(in, x, y);
     }
 
-    // ˍWZbg
+    // 発射座標をセットする
     void missile::set_fire(const VECTOR position) {
         state = state::wait;
 
@@ -287,12 +277,12 @@ namespace mv1 {
         }
     }
 
-    // ˏ
+    // 発射処理
     void missile::process_fire() {
         if (state == state::launch || state == state::homing) {
             VECTOR move = process_moving();
 
-            // z[~OɎw Y l珈I̎dlƂ
+            // ホーミング中に指定の Y 値を下回ったら処理終了の仕様とする
 #if defined(_AMG_MATH)
             auto position = get_position() + ToMath(move);
             auto homing_end = (state == state::homing) && (position.get_y() < homing_end_y);
@@ -308,9 +298,9 @@ namespace mv1 {
                 state = state::explode;
                 set_explosion();
 
-                // e평(̔˗p)
+                // 各種初期化(次の発射用)
                 player_warning.reset();
-                posture = MGetIdent();
+                posture = math::quaternionf();
 #if defined(_AMG_MATH)
                 set_rotation(math::vector4());
 #else
@@ -330,7 +320,7 @@ namespace mv1 {
         explode_angle = 0.0;
         explode_scale = 1.0;
 
-        // z[~OI~TC XZ Wŏ
+        // ホーミング処理が終わったミサイルの XZ 座標で処理する
 #if defined(_AMG_MATH)
         auto position = get_position();
 
@@ -351,7 +341,7 @@ namespace mv1 {
             return;
         }
 
-        // ]Ȃg傳
+        // 回転しながら拡大させる
 #if defined(_AMG_MATH)
         explosion->set_rotation(math::vector4(0.0, explode_angle, 0.0));
         explosion->set_scale(math::vector4(explode_scale, explode_scale, explode_scale));
@@ -363,14 +353,14 @@ namespace mv1 {
         explode_angle += explode_add_angle;
         explode_scale *= explode_multi_scale;
 
-        // w̃XP[l𒴂甚I̎dlƂ
+        // 指定のスケール値を超えたら爆発終了の仕様とする
         if (explode_scale > explode_end_scale) {
             state = state::none;
             explosion->set_invisible(true);
         }
     }
 
-    // ړ
+    // 移動処理
     VECTOR missile::process_moving() {
         if (state == state::launch) {
             process_moving_launch();
@@ -383,77 +373,47 @@ namespace mv1 {
         return VScale(get_posture_y(), velocity);
     }
 
-    // ˂čŏ̒i(㏸)
+    // 発射して最初の直進(上昇)処理
     void missile::process_moving_launch() {
-        // {Iɐ^ɒiȂ̂ŉ͂Ȃ
-        // (݂̎p Y  velocity Ȃ̂)
-        //  launch I  homing ̃Zbgs
+        // 基本的に真上に直進なので何も処理はしない
+        // (現在の姿勢の Y 方向へ velocity 分動くだけなので)
+        // よって launch 終了判定 および homing 処理のセットを行うだけ
         if (get_count() > launch_millisecond) {
             state = state::homing;
             start_count();
 
-            // R[obNŃz[~O̎p䂾s
-            // z[~O process_moving_homing ̉ӏ
-            auto update_after = [this](posture_base* base) -> void {
-                // posture_base ̃}gNX̓XP[܂܂̂
-                // initialize ŃZbg scale ľvZsȂ΂ȂȂ
-                // ݂̎p\oϐ posture ́Â܂܉]sƂĎg
 #if defined(_AMG_MATH)
-                auto scale = math::matrix44();
-                auto trans = math::matrix44();
-                auto position = get_position();
-                auto rotate = ToMath(posture);
-
-                scale.scale(model_scale, model_scale, model_scale, true);
-                trans.transfer(position.get_x(), position.get_y(), position.get_z(), true);
-
-                set_posture_matrix(scale * rotate * trans);
+            // ホーミング中の姿勢は posture_base の回転としてそのまま設定する
+            set_orientation(posture);
 #else
+            // コールバックでホーミング中の姿勢制御だけを行う
+            // ホーミング処理は process_moving_homing の箇所
+            auto update_after = [this](posture_base* base) -> void {
+                // posture_base のマトリクス処理はスケールも含まれるので
+                // initialize でセットした scale 値の計算も行わなければならない
                 MATRIX scale = MGetScale(VGet(model_scale, model_scale, model_scale));
                 MATRIX trans = MGetTranslate(get_position());
+                MATRIX rotate = ToDX(posture.to_matrix());
 
-                set_posture_matrix(MMult(MMult(scale, posture), trans));
-#endif
+                set_posture_matrix(MMult(MMult(scale, rotate), trans));
             };
 
             set_update_posture_matrix(false);
             set_update_after(update_after);
+#endif
         }
     }
 
-    // z[~O
+    // ホーミング処理
     void missile::process_moving_homing() {
         if (get_count() > homing_millisecond) {
-            // g(~TC) player ւ̒PʃxNg쐬
+            // ここがホーミング処理相当
+            // (ミサイルは直進するので姿勢を制御するのがホーミングになる)
+            // ミサイルの向き( Y 軸)から player への向きへの回転を割合(これがホーミングの割合)で補間して使用する
+            posture = backend::missile_math<backend::object_math>::homing(posture, get_position(), player->get_position(), homing_rate);
 #if defined(_AMG_MATH)
-            auto player_position = player->get_position();
-            auto position = get_position();
-            auto to_player_math = player_position - position;
-
-            to_player_math.normalized();
-
-            VECTOR to_player = ToDX(to_player_math);
-#else
-            VECTOR player_position = player->get_position();
-            VECTOR position = get_position();
-            VECTOR to_player = VNorm(VSub(player_position, position));
+            set_orientation(posture);
 #endif
-            VECTOR x = get_posture_x();
-            VECTOR y = get_posture_y();
-            VECTOR z = get_posture_z();
-            // z[~O
-            // (~TC͒îŎp𐧌䂷̂z[~OɂȂ)
-            // 100%  player ւ̃xNgKĂ܂ KĂ܂̂
-            // ~TČ( Y )Aplayer ւ()PʃxNgԃxNg쐬
-            // ̃xNg(ꂪz[~O̊)ŏĎgp
-            VECTOR homing = VScale(VSub(to_player, y), homing_rate);
-
-            // ݂ɒԂ x / y / z 𓯂
-            x = VNorm(VAdd(x, homing));
-            y = VNorm(VAdd(y, homing));
-            z = VNorm(VAdd(z, homing));
-
-            set_posture(x, y, z);
             start_count();
         }
     }
@@ -466,7 +426,7 @@ namespace mv1 {
         count_down.y = std::get<2>(check);
 
         auto count_down = count_down_millisecond - get_count();
-        count_down_time = count_down / 1000.0f; // b֕ϊ
+        count_down_time = count_down / 1000.0f; // 秒へ変換
 
         if (count_down < 0) {
             count_down_time = 0.0f;
@@ -488,7 +448,7 @@ namespace mv1 {
 #else
         VECTOR player_position = player->get_position();
 #endif
-        // player f̓゠ɂȂ悤ɃItZbg
+        // player モデルの頭上あたりになるようにオフセットをかける
         VECTOR player_point = VAdd(player_position, VGet(0.0f, warning_text_offset_y, 0.0f));
         auto check = check_in_screen(player_point);
 
@@ -519,7 +479,7 @@ namespace mv1 {
         return ret;
     }
 
-    // ʘg`
+    // 別枠描画
     void missile::render_screen() {
         if (world  == nullptr || -1 == camera_index || is_stand_by() || is_explode()) {
             return;
@@ -532,13 +492,13 @@ namespace mv1 {
             render_separate();
         }
 
-        // g`
+        // 枠描画
         DrawBox(base_width, 0, line_width_pos, quarter_height, line_color, TRUE);
         DrawBox(line_width_pos, line_height_pos, screen_width, quarter_height, line_color, TRUE);
     }
 
     void missile::world_process_and_render() const {
-        // J؂ւ
+        // カメラを切り替える
         auto now_camera_index = world->get_camera_index();
 
         world->set_camera_index(camera_index);
@@ -554,27 +514,27 @@ namespace mv1 {
             return;
         }
 
-        // _O^[QbgeNX`ɂ
+        // レンダリングターゲットをテクスチャにする
         SetDrawScreen(render_texture_handle);
         ClearDrawScreen();
 
         world_process_and_render();
 
-        // ^[QbgobNobt@ɖ߂āA_OeNX`gpĕ`
+        // ターゲットをバックバッファに戻して、レンダリングしたテクスチャを使用して描画
         SetDrawScreen(DX_SCREEN_BACK);
         DrawExtendGraph(base_width, 0, screen_width, quarter_height, render_texture_handle, FALSE);
     }
 
     void missile::render_separate() {
-        // ʂ̉E(Ŝ1/4TCY)`Ώۂɂݒ
+        // 画面の右上(全体の1/4サイズ)を描画対象にする設定
         SetDrawArea(base_width, 0, screen_width, quarter_height);
         SetCameraScreenCenter(base_width + (quarter_width / 2), quarter_height / 2);
-        // Z obt@NAčĕ`
+        // Z バッファをクリアして再描画
         ClearDrawScreenZBuffer();
 
         world_process_and_render();
 
-        // J̐ݒ߂
+        // カメラの設定も戻す
         SetCameraScreenCenter(screen_width * 0.5f, screen_height * 0.5f);
         SetDrawAreaFull();
     }
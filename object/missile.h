@@ -1,13 +1,14 @@
 //!
 //! @file missile.h
 //!
-//! @brief ~TC̃fNX
-//!        ڍׂ missile.cpp 
+//! @brief ミサイルのモデルを扱うクラス
+//!        詳細は missile.cpp 側
 //!
 #pragma once
 #include <memory>
 #include <tuple>
 #include "model_base.h"
+#include "quaternion.h"
 
 struct tagVECTOR;
 
@@ -24,12 +25,12 @@ namespace mv1 {
 
     class missile : public model_base {
     public:
-        // RXgN^
+        // コンストラクタ
         missile(const int screen_width, const int screen_height);
-        missile(const missile&) = default; // Rs[
-        missile(missile&&) = default; // [u
+        missile(const missile&) = default; // コピー
+        missile(missile&&) = default; // ムーブ
 
-        // fXgN^
+        // デストラクタ
         virtual ~missile();
 
         void process() override;
@@ -50,8 +51,8 @@ namespace mv1 {
             none, wait, launch, homing, explode
         };
 
-        // ̃NXŎgp镶`p̍\
-        //  Ⴄ`𕡐ŝł܂Ƃ߂
+        // このクラスだけで使用する文字列描画用の構造体
+        // 同じ処理で 違う描画を複数行うのでまとめる
         struct draw_text {
             draw_text() {
                 offset_x = 0; x = 0; y = 0; is_valid = false; is_draw = false;
@@ -84,11 +85,7 @@ namespace mv1 {
         void process_moving_homing();
         VECTOR process_moving();
 
-        VECTOR get_posture_x() const;
         VECTOR get_posture_y() const;
-        VECTOR get_posture_z() const;
-
-        void set_posture(const VECTOR& x, const VECTOR& y, const VECTOR& z);
 
         void world_process_and_render() const;
 
@@ -103,7 +100,7 @@ namespace mv1 {
         std::shared_ptr<mv1::player> player;
         std::shared_ptr<primitive::sphere> explosion;
 
-        MATRIX posture;
+        math::quaternionf posture;
         VECTOR fire_point;
 
         float velocity;
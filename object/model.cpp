@@ -29,7 +29,7 @@ namespace mv1 {
         process_blend();
     }
 
-    // Aj[V uh
+    // アニメーション ブレンド処理
     void model::process_blend() {
         if (-1 == main .index || -1 == blend.index) {
             return;
@@ -43,14 +43,14 @@ namespace mv1 {
 
         blend_count++;
 
-        // w̃uht[߂
+        // 指定のブレンドフレームが過ぎたら
         if (blend_count > blend_frame) {
-            detach_anim_info(main); // main ͔̕j
+            detach_anim_info(main); // main の方は破棄
 
-            main = blend;           // blend ̃Aj[V main ɂ
-            main.play = base_frame; // uh t[i߂
+            main = blend;           // blend のアニメーションを main にする
+            main.play = base_frame; // ブレンド フレーム分進める
 
-            blend.reset();          // main ɃRs[̂ŃZbg
+            blend.reset();          // main にコピーしたのでリセット
         }
     }
 
@@ -21,12 +21,12 @@ namespace mv1 {
             std::function<void(void)> loop_end;
         };
 
-        // RXgN^
+        // コンストラクタ
         model();
-        model(const model&) = default; // Rs[
-        model(model&&) = default; // [u
+        model(const model&) = default; // コピー
+        model(model&&) = default; // ムーブ
 
-         // fXgN^
+         // デストラクタ
         virtual ~model() = default;
 
         bool load(const TCHAR* fileName) override;
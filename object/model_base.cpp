@@ -1,11 +1,17 @@
+#include <algorithm>
 #include "DxLib.h"
 #include "model_base.h"
+#include "dx_utility.h"
 #if defined(_AMG_MATH)
 #include "vector4.h"
 #include "matrix44.h"
-#include "dx_utility.h"
 #endif
 
+namespace {
+    // メッシュの境界は初期姿勢なので、アニメーションで手足が出る分だけ広げておく
+    constexpr auto BOUNDS_MARGIN = 1.25f;
+}
+
 namespace mv1 {
 
     model_base::model_base() : posture_base(){
@@ -22,7 +28,38 @@ namespace mv1 {
 
         handle = MV1LoadModel(fileName);
 
-        return (-1 != handle);
+        if (-1 == handle) {
+            return false;
+        }
+
+        update_local_bounds();
+
+        return true;
+    }
+
+    // 全メッシュの軸平行境界箱
+    void model_base::update_local_bounds() {
+        const auto mesh_num = MV1GetMeshNum(handle);
+
+        if (mesh_num <= 0) {
+            return;
+        }
+
+        auto min = MV1GetMeshMinPosition(handle, 0);
+        auto max = MV1GetMeshMaxPosition(handle, 0);
+
+        for (auto i = 1; i < mesh_num; ++i) {
+            const auto mesh_min = MV1GetMeshMinPosition(handle, i);
+            const auto mesh_max = MV1GetMeshMaxPosition(handle, i);
+
+            min = VGet(std::min(min.x, mesh_min.x), std::min(min.y, mesh_min.y), std::min(min.z, mesh_min.z));
+            max = VGet(std::max(max.x, mesh_max.x), std::max(max.y, mesh_max.y), std::max(max.z, mesh_max.z));
+        }
+
+        const auto center = VScale(VAdd(min, max), 0.5f);
+        const auto extent = VScale(VSub(max, min), 0.5f * BOUNDS_MARGIN);
+
+        set_local_bounds(ToMathF(VSub(center, extent)), ToMathF(VAdd(center, extent)), VSize(extent));
     }
 
     bool model_base::unload() {
@@ -52,7 +89,7 @@ namespace mv1 {
             return false;
         }
 
-        // Z obt@L
+        // Z バッファを有効化
         MV1SetUseZBuffer(handle, TRUE);
         MV1SetWriteZBuffer(handle, TRUE);
 
@@ -14,15 +14,15 @@ namespace mv1 {
 
     class model_base : public posture_base {
     public:
-        // RXgN^
+        // コンストラクタ
         model_base();
-        model_base(const model_base&) = default; // Rs[
-        model_base(model_base&&) = default; // [u
+        model_base(const model_base&) = default; // コピー
+        model_base(model_base&&) = default; // ムーブ
 
-         // fXgN^
+         // デストラクタ
         virtual ~model_base();
 
-        // C++17 ߂l𖳎ꍇɌxo
+        // C++17 戻り値を無視した場合に警告を出す
         [[nodiscard]] virtual bool load(const TCHAR* fileName);
         virtual bool unload();
 
@@ -37,6 +37,8 @@ namespace mv1 {
         const bool get_invisible() const { return invisible; };
 
     protected:
+        void update_local_bounds();
+
         int handle;
         bool invisible;
     };
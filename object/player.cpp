@@ -3,21 +3,21 @@
 #include "utility.h"
 #include "vector4.h"
 #include "matrix44.h"
+#include "batch.h"
 #include "primitive_plane.h"
 #include "primitive_sphere.h"
 #include "primitive_cube.h"
 #include "dx_utility.h"
+#include "dx_math_policy.h"
 
 namespace {
     constexpr auto DEFAULT_COLLISION_RADIUS = 55.0;
-    constexpr auto GRAVITY = 9.8; // d͉x
+    constexpr auto GRAVITY = 9.8; // 重力加速度
     constexpr auto DEFAULT_JUMP_POWER = 110.0;
     constexpr auto DEFAULT_JUMP_ANGLE = 85.0;
     constexpr auto DEFAULT_BACK_POWER = 60.0;
-    constexpr auto DEFAULT_BACK_ANGLE = 97.5; // 90x傫ȂƌɂȂȂ
-#if !defined(_AMG_MATH)
-    constexpr auto DEGREE_TO_RADIAN = DX_PI_F / 180.0f;
-#endif
+    constexpr auto DEFAULT_BACK_ANGLE = 97.5; // 90度より大きくないと後ろにならない
+    using player_math = backend::player_math<backend::object_math>;
 
     const std::array<primitive::cube::face_type, 4> cube_side = {
         primitive::cube::face_type::front,
@@ -49,7 +49,7 @@ namespace mv1 {
         is_debug = false;
 
 #if defined(_AMG_MATH)
-        // ɏlKvȂ΃RXgN^ł̒lɂȂ
+        // 特に初期値が必要なければコンストラクタでの値になる
         direction = math::vector4(0.0, 0.0, -1.0);
         direction.normalized();
 #else
@@ -58,7 +58,6 @@ namespace mv1 {
         moved = VGet(0.0f, 0.0f, 0.0f);
         jump_velocity = VGet(0.0f, 0.0f, 0.0f);
         jump_start_position = VGet(0.0f, 0.0f, 0.0f);
-        rotate_y = MGetIdent();
 #endif
 
         last_position = position;
@@ -73,7 +72,7 @@ namespace mv1 {
         auto rotate_value = 0.0;
 
         if (1 == CheckHitKey(KEY_INPUT_SPACE)) {
-            // jump  attack ͔r
+            // jump と attack は排他処理
             if (!is_attack && !is_jump) {
                 is_jump = true;
                 start_jump = true;
@@ -81,7 +80,7 @@ namespace mv1 {
         }
 
         if (1 == CheckHitKey(KEY_INPUT_V)) {
-            // jump  attack ͔r
+            // jump と attack は排他処理
             if (!is_jump && !is_attack) {
                 is_attack = true;
                 start_attack = true;
@@ -104,7 +103,7 @@ namespace mv1 {
             rotate_value = rotate;
         }
 
-        // jump  ȊO͔rs
+        // jump と それ以外は排他処理を行う
         if (is_jump) {
             if (start_jump) {
                 process_jump_initialize(jump_type::normal);
@@ -116,7 +115,7 @@ namespace mv1 {
             process_jump();
         }
         else {
-            // attack  ȊO͔rs
+            // attack と それ以外は排他処理を行う
             if (is_attack) {
                 process_attack(start_attack);
             }
@@ -156,9 +155,9 @@ namespace mv1 {
             return false;
         }
 
-        // WvȂɏ邩`FbN
+        // ジャンプ中なら上に乗るかチェック
         if (is_jump) {
-            // C++17 \
+            // C++17 構造化束縛
             auto [vertices, normal] = plane->get_info();
 
             if (process_jump_landing(position, vertices)) {
@@ -166,7 +165,7 @@ namespace mv1 {
             }
         }
         else {
-            // ɏĂ痎`FbN
+            // 上に乗っていたら落下チェック
             if (collision_ride_on != nullptr && collision_ride_on == primitive) {
                 auto [vertices, normal] = plane->get_info();
 
@@ -185,10 +184,10 @@ namespace mv1 {
         }
 
         if (!check_sphere_distance(sphere)) {
-            return true; // sphere Ȃ̂ true
+            return true; // sphere なので true
         }
 
-        // TODO : ̃RW͖
+        // TODO : 球のコリジョン処理は未実装
 
         return true;
     }
@@ -200,13 +199,13 @@ namespace mv1 {
             return false;
         }
 
-        // ͈͊OȂ珈Ȃs
+        // 範囲外なら処理しないs
         if (!check_cube_distance(cube)) {
-            return true; // cube Ȃ̂ true
+            return true; // cube なので true
         }
 
         if (is_jump) {
-            // WvȂɏ邩`FbN
+            // ジャンプ中なら上に乗るかチェック
             auto [vertices, normal] = cube->get_face(primitive::cube::face_type::top);
 
             if (process_jump_landing(position, vertices)) {
@@ -214,7 +213,7 @@ namespace mv1 {
             }
         }
         else {
-            // ɏĂ痎`FbN
+            // 上に乗っていたら落下チェック
             if (collision_ride_on != nullptr && collision_ride_on == primitive) {
                 auto [vertices, normal] = cube->get_face(primitive::cube::face_type::top);
 
@@ -226,36 +225,58 @@ namespace mv1 {
             }
         }
 
-        // łȂ
+        // 落下中でなければ
         if (!is_fall) {
-            // ʂƂ̃RW
+            // 側面とのコリジョン処理
             auto [start, end] = make_collision_line();
+            // 判定する側面の頂点を SoA に並べて 1 回で判定する([頂点番号 * 3 + 軸][面])
+            std::array<std::array<double, 4>, 12> side_vertices;
+            std::array<math::vector4, 4> side_normals;
+            std::size_t side_num = 0;
 
             for (const auto& side : cube_side) {
                 auto [vertices, normal] = cube->get_face(side);
 
-                // ʂ̖@ƌ̃xNgœςsO̎
+                // 面の法線と向きのベクトルで内積を行い外向きの時だけ判定
 #if defined(_AMG_MATH)
                 auto dot = normal.dot(direction);
 #else
                 auto dot = VDot(ToDX(normal), direction);
 #endif
-                // obNWv͏O
+                // バックジャンプ時は除外
                 if (is_back || dot <= 0.0) {
-                    auto [is_collision, collision_point] = math::utility::collision_polygon_line(vertices[0], vertices[1], vertices[2], vertices[3], start, end);
-
-                    if (is_collision) {
-                        set_collision_to_position(collision_point);
-
-                        if (is_jump) {
-                            jump_velocity_initialize_reflect();
-                        }
-                        else if (is_forward) {
-                            process_press_forward(normal);
-                        }
-                        // ̑ʂƂ͕̔sv
-                        break;
+                    for (auto i = 0; i < 4; ++i) {
+                        side_vertices[i * 3 + 0][side_num] = vertices[i].get_x();
+                        side_vertices[i * 3 + 1][side_num] = vertices[i].get_y();
+                        side_vertices[i * 3 + 2][side_num] = vertices[i].get_z();
                     }
+
+                    side_normals[side_num] = normal;
+                    ++side_num;
+                }
+            }
+
+            const auto get_span = [&side_vertices, side_num](const int point) -> math::basic_soa_span<const double> {
+                return {
+                    { side_vertices[point * 3 + 0].data(), side_num },
+                    { side_vertices[point * 3 + 1].data(), side_num },
+                    { side_vertices[point * 3 + 2].data(), side_num }
+                };
+            };
+
+            // 複数の側面と交差した場合は線分の始点に最も近い面を使う
+            auto [is_collision, face, ratio] = math::batch::intersect_segment_quad(start, end, get_span(0), get_span(1), get_span(2), get_span(3));
+
+            if (is_collision) {
+                auto collision_point = start.add_scaled(end - start, ratio);
+
+                set_collision_to_position(collision_point);
+
+                if (is_jump) {
+                    jump_velocity_initialize_reflect();
+                }
+                else if (is_forward) {
+                    process_press_forward(side_normals[face]);
                 }
             }
         }
@@ -277,7 +298,7 @@ namespace mv1 {
         auto check = xz_dir.cross(player_dir);
         auto forward = math::vector4();
 
-        // Oς̌ʂ Y ̒l̐ōE
+        // 外積の結果の Y の値の正負で左右判定
         if (check.get_y() < 0.0) {
             forward = xz_dir.cross(up);
         }
@@ -285,7 +306,7 @@ namespace mv1 {
             forward = up.cross(xz_dir);
         }
 
-        // ʂɓĂ̂œς̒l -1 ~ 0
+        // 面に当たっているので内積の値は -1 ~ 0
         auto power = movement * (1.0 + xz_dir.dot(player_dir));
         auto moved = forward * power;
 
@@ -296,8 +317,8 @@ namespace mv1 {
 #endif
     }
 
-    // primitive::sphere Ƃ̋`FbN
-    // (ĂȂRWȂ)
+    // primitive::sphere との距離をチェックする
+    // (距離が離れているならコリジョン処理をしない)
     bool player::check_sphere_distance(const std::shared_ptr<primitive::sphere>& sphere) const {
 #if defined(_AMG_MATH)
         auto distance = sphere->get_position() - position;
@@ -306,9 +327,9 @@ namespace mv1 {
 #else
         VECTOR distance = VSub(sphere->get_position(), position);
         auto check = distance.x * distance.x + distance.y * distance.y + distance.z * distance.z;
-        auto radius = sphere->get_radius() * sphere->get_scale().x; // XP[ x lgĂ݂
+        auto radius = sphere->get_radius() * sphere->get_scale().x; // スケールは x 値を使ってみる
 #endif
-        auto player_range = (collision_sphere_radius + movement) * 2.0; // MMƂ蔲N\̂ 2 {Ă
+        auto player_range = (collision_sphere_radius + movement) * 2.0; // ギリギリだとすり抜けが起きる可能性があるので 2 倍しておく
         auto range = radius + player_range;
 
         if (check > range * range) {
@@ -318,11 +339,11 @@ namespace mv1 {
         return true;
     }
 
-    // primitive::cube Ƃ̋`FbN
-    // (ĂȂRWȂ)
+    // primitive::cube との距離をチェックする
+    // (距離が離れているならコリジョン処理をしない)
     bool player::check_cube_distance(const std::shared_ptr<primitive::cube>& cube) const {
-        // RŴׂȂ̂łxGcȔŗǂ
-        // (tɃMMƂ蔲N\܂)
+        // 毎回コリジョン処理をするのを回避する為なのである程度大雑把な判定で良い
+        // (逆にギリギリだとすり抜けが起きる可能性が高まる)
 #if defined(_AMG_MATH)
         auto distance = cube->get_position() - position;
         auto check = distance.get_x() * distance.get_x() + distance.get_y() * distance.get_y() + distance.get_z() * distance.get_z();
@@ -330,10 +351,10 @@ namespace mv1 {
 #else
         VECTOR distance = VSub(cube->get_position(), position);
         auto check = distance.x * distance.x + distance.y * distance.y + distance.z * distance.z;
-        auto cube_size = cube->get_size() * cube->get_scale().x; // XP[ x lgĂ݂
+        auto cube_size = cube->get_size() * cube->get_scale().x; // スケールは x 値を使ってみる
 #endif
-        auto player_range = (collision_sphere_radius + movement) * 2.0; // MMƂ蔲N\̂ 2 {Ă
-        auto range = cube_size + player_range; // {Ȃ cube ̑Ίp̒̔gp邪 ]T size ̂܂܎gp
+        auto player_range = (collision_sphere_radius + movement) * 2.0; // ギリギリだとすり抜けが起きる可能性があるので 2 倍しておく
+        auto range = cube_size + player_range; // 本来なら cube の対角線の長さの半分を使用するが こちらも余裕をもたせて size をそのまま使用する
 
         if (check > range * range) {
             return false;
@@ -342,7 +363,7 @@ namespace mv1 {
         return true;
     }
 
-    // `̓Oŗ̃`FbNs
+    // 矩形の内外判定で落下のチェックを行う
     bool player::check_fall(const std::array<math::vector4, 4>& vertices) const {
 #if defined(_AMG_MATH)
         auto& check = position;
@@ -359,14 +380,14 @@ namespace mv1 {
             return false;
         }
 
-        // `͈̔͊O
+        // 矩形の範囲外
         return true;
     }
 
-    // RW̔aݒñxNg쐬
+    // コリジョン球の半径を加味した現在地のベクトルを作成
     math::vector4 player::make_collision_position() const {
 #if defined(_AMG_MATH)
-        auto radius_position = position + (direction * collision_sphere_radius);
+        auto radius_position = position.add_scaled(direction, collision_sphere_radius);
 #else
         VECTOR radius = VAdd(position, VScale(direction, collision_sphere_radius));
         auto radius_position = math::vector4(radius.x, radius.y, radius.z);
@@ -375,9 +396,9 @@ namespace mv1 {
         return radius_position;
     }
 
-    // RW̔aŌݒnƂ̐쐬
+    // コリジョン球の半径で現在地との線分を作成
     const std::tuple<math::vector4, math::vector4> player::make_collision_line() const {
-        // RW̔ǎݒñxNg쐬
+        // コリジョン球の半径分の現在地のベクトルを作成
 #if defined(_AMG_MATH)
         auto start = position;
 #else
@@ -385,20 +406,20 @@ namespace mv1 {
 #endif
         auto end = make_collision_position();
 
-        // RW̔a̍
+        // コリジョン球の半径分の高さを加味
         start.add(0.0, collision_sphere_radius, 0.0);
         end.add(0.0, collision_sphere_radius, 0.0);
 
         return std::make_tuple(start, end);
     }
 
-    // RWʒuRW̑傫Č݈ʒuZbg
+    // コリジョン位置からコリジョン球の大きさを加味して現在位置をセットする
     void player::set_collision_to_position(math::vector4& collision) {
-        // make_collision_sphere Ƌt̏
+        // make_collision_sphere と逆の処理をする
         collision.add(0.0, -collision_sphere_radius, 0.0);
 
 #if defined(_AMG_MATH)
-        position = collision + (direction * -collision_sphere_radius);
+        position = collision.add_scaled(direction, -collision_sphere_radius);
 #else
         VECTOR inverse_radius = VScale(direction, -collision_sphere_radius);
 
@@ -412,13 +433,7 @@ namespace mv1 {
                 set_blend(1, 10, true);
             }
 
-#if defined(_AMG_MATH)
-            moved = direction * movement;
-            position = position + moved;
-#else
-            moved = VScale(direction, movement);
-            position = VAdd(position, moved);
-#endif
+            std::tie(position, moved) = player_math::forward(position, direction, movement);
         } else if (!is_blend() && 0 != get_main_index()) {
             set_blend(0, 10, true);
         }
@@ -426,13 +441,10 @@ namespace mv1 {
 
     void player::process_rotate(const double rotate_value) {
         if (rotate_value != 0.0) {
+            direction = player_math::rotate_direction(direction, rotate_value);
 #if defined(_AMG_MATH)
-            rotate_y.rotate_y(rotate_value, true);
-            direction = direction * rotate_y;
             rotation.add(0.0, rotate_value, 0.0);
 #else
-            rotate_y = MGetRotY(rotate_value * DEGREE_TO_RADIAN);
-            direction = VTransform(direction, rotate_y);
             rotation.y += rotate_value;
 #endif
         }
@@ -440,7 +452,7 @@ namespace mv1 {
 
     void player::process_attack(const bool start_attack) {
         if (start_attack) {
-            // index 2 ̃Aj[VIs
+            // index 2 のアニメーションが終わったら行う処理
             std::function<void(void)> attack_end = [this](void) -> void {
                 is_attack = false;
                 set_blend(0, 5, true);
@@ -452,7 +464,7 @@ namespace mv1 {
 
     void player::process_jump() {
         // ========================================================================================================
-        // jump ̌vZWbN
+        // jump の計算ロジック
         position = process_jump_logic_physics();
         //position = process_jump_logic_vector();
         // ========================================================================================================
@@ -483,23 +495,10 @@ namespace mv1 {
     }
 
     void player::jump_velocity_initialize_normal() {
-        // jump ̃xNg쐬
-        // jump_power ̊{̃xNg()쐬 jump_angle ̊pxŌX
-        // Ō player ̕ɉ]Č킹
-#if defined(_AMG_MATH)
-        auto jump_base = math::vector4(0.0, 0.0, -jump_power);
-        auto jump_rotate = math::matrix44();
-
-        jump_rotate.rotate_x(jump_angle, true);
-        jump_rotate.rotate_y(rotation.get_y(), false);
-
-        jump_velocity = jump_base * jump_rotate;
-#else
-        VECTOR jump_base = VGet(0.0f, 0.0f, -jump_power);
-        MATRIX jump_rotate = MMult(MGetRotX(jump_angle * DEGREE_TO_RADIAN), MGetRotY(rotation.y * DEGREE_TO_RADIAN));
-
-        jump_velocity = VTransform(jump_base, jump_rotate);
-#endif
+        // jump のベクトルを作成する
+        // jump_power の基本のベクトル(水平)を作成して jump_angle の角度で傾ける
+        // 最後に player の方向に回転させて向きを合わせる
+        jump_velocity = player_math::jump_velocity(jump_power, jump_angle, backend::object_math::get_y(rotation));
     }
 
     void player::jump_velocity_initialize_fall() {
@@ -514,35 +513,15 @@ namespace mv1 {
     }
 
     void player::jump_velocity_initialize_back() {
-#if defined(_AMG_MATH)
-        auto back_base = math::vector4(0.0, 0.0, -DEFAULT_BACK_POWER);
-        auto back_rotate = math::matrix44();
-
-        back_rotate.rotate_x(DEFAULT_BACK_ANGLE, true);
-        back_rotate.rotate_y(rotation.get_y(), false);
-
-        jump_velocity = back_base * back_rotate;
-#else
-        VECTOR back_base = VGet(0.0f, 0.0f, -DEFAULT_BACK_POWER);
-        MATRIX back_rotate = MMult(MGetRotX(DEFAULT_BACK_ANGLE * DEGREE_TO_RADIAN), MGetRotY(rotation.y * DEGREE_TO_RADIAN));
-
-        jump_velocity = VTransform(back_base, back_rotate);
-#endif
+        jump_velocity = player_math::jump_velocity(DEFAULT_BACK_POWER, DEFAULT_BACK_ANGLE, backend::object_math::get_y(rotation));
     }
 
     void player::jump_velocity_initialize_reflect() {
-#if defined(_AMG_MATH)
-        auto reflect_matrix = math::matrix44();
-
-        reflect_matrix.rotate_y(180.0, true);
-        jump_velocity = jump_velocity * reflect_matrix;
-#else
-        jump_velocity = VTransform(jump_velocity, MGetRotY(180.0f * DEGREE_TO_RADIAN));
-#endif
+        jump_velocity = player_math::reflect_velocity(jump_velocity);
     }
 
     void player::process_jump_finished(std::shared_ptr<primitive::primitive_base>& primitive) {
-        collision_ride_on.reset(); // L
+        collision_ride_on.reset(); // 所有権を放棄
         collision_ride_on = primitive;
 
         is_jump = false;
@@ -557,18 +536,12 @@ namespace mv1 {
     math::vector4 player::process_jump_logic_physics() {
         jump_timer += 1.0;
 
-        // ̎ŌvZ
-        // y = y0 + v0t - 1/2gt^2
-        auto jump_position = jump_start_position + (jump_velocity * jump_timer);
-        auto jump_y = (0.5 * GRAVITY * jump_timer * jump_timer);
-
-        jump_position.add(0.0, -jump_y, 0.0);
-
-        return jump_position;
+        // 放物線の式で計算する
+        return player_math::jump_position(jump_start_position, jump_velocity, jump_timer, GRAVITY);
     }
 
     math::vector4 player::process_jump_logic_vector() {
-        // xNgŏ
+        // ベクトルで処理する
         auto jump_position = position + jump_velocity;
 
         jump_velocity.add(0.0, -GRAVITY, 0.0);
@@ -594,19 +567,16 @@ namespace mv1 {
 #else
 
     VECTOR player::process_jump_logic_physics() {
-        // ̎ŌvZ
-        // y = y0 + v0t - 1/2gt^2
-        VECTOR jump_position = VAdd(jump_start_position, VScale(jump_velocity, jump_timer));
-        auto jump_y = (0.5 * GRAVITY * jump_timer * jump_timer);
+        // 放物線の式で計算する
+        VECTOR jump_position = player_math::jump_position(jump_start_position, jump_velocity, jump_timer, GRAVITY);
 
-        jump_position.y -= jump_y;
         jump_timer += 1.0;
 
         return jump_position;
     }
 
     VECTOR player::process_jump_logic_vector() {
-        // xNgŏ
+        // ベクトルで処理する
         VECTOR jump_position = VAdd(position, jump_velocity);
 
         jump_velocity.y -= GRAVITY;
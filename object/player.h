@@ -4,6 +4,7 @@
 #include <memory>
 #include <tuple>
 #include "model.h"
+#include "math_fwd.h"
 
 namespace primitive {
     class primitive_base;
@@ -11,10 +12,6 @@ namespace primitive {
     class cube;
 }
 
-namespace math {
-    class vector4;
-}
-
 namespace mv1 {
 
     class player : public model {
@@ -23,12 +20,12 @@ namespace mv1 {
             normal, fall, back
         };
 
-        // RXgN^
+        // コンストラクタ
         player();
-        player(const player&) = default; // Rs[
-        player(player&&) = default; // [u
+        player(const player&) = default; // コピー
+        player(player&&) = default; // ムーブ
 
-         // fXgN^
+         // デストラクタ
         virtual ~player() = default;
 
         void process() override;
@@ -105,10 +102,10 @@ namespace mv1 {
         const std::tuple<math::vector4, math::vector4> make_collision_line() const;
         void set_collision_to_position(math::vector4& collision);
 
-        std::vector<std::shared_ptr<primitive::primitive_base>> collision_list; // RWv~eBu
-        std::shared_ptr<primitive::primitive_base> collision_ride_on; // ɏĂv~eBu
+        std::vector<std::shared_ptr<primitive::primitive_base>> collision_list; // コリジョン処理をするプリミティブ
+        std::shared_ptr<primitive::primitive_base> collision_ride_on; // 上に乗っているプリミティブ
 
-        double collision_sphere_radius; // RWp̋̔a
+        double collision_sphere_radius; // コリジョン処理用の球の半径
 
         double movement;
         double rotate;
@@ -129,14 +126,12 @@ namespace mv1 {
         math::vector4 jump_velocity;
         math::vector4 jump_start_position;
         math::vector4 last_position;
-        math::matrix44 rotate_y;
 #else
         VECTOR direction;
         VECTOR moved;
         VECTOR jump_velocity;
         VECTOR jump_start_position;
         VECTOR last_position;
-        MATRIX rotate_y;
 #endif
     };
 }
@@ -1,17 +1,13 @@
 #include "DxLib.h"
 #include "posture_base.h"
-#if defined(_AMG_MATH)
-#include "vector4.h"
-#include "matrix44.h"
-#endif
-
-namespace {
-    constexpr auto DEGREE_TO_RADIAN = DX_PI_F / 180.0f;
-}
+#include "dx_math_policy.h"
+#include <algorithm>
+#include <cmath>
 
 posture_base::posture_base() {
 #if defined(_AMG_MATH)
     scale = math::vector4(1.0, 1.0, 1.0);
+    use_orientation = false;
 #else
     position = VGet(0.0f, 0.0f, 0.0f);
     rotation = VGet(0.0f, 0.0f, 0.0f);
@@ -22,6 +18,10 @@ posture_base::posture_base() {
     posture_matrix = MGetIdent();
 #endif
     update_posture_matrix = true;
+
+    bounds_valid = false;
+    local_radius = 0.0f;
+    bounds_radius = 0.0f;
 }
 
 void posture_base::process_posture() {
@@ -30,33 +30,68 @@ void posture_base::process_posture() {
     }
 
 #if defined(_AMG_MATH)
-    scale_matrix.scale(scale.get_x(), scale.get_y(), scale.get_z(), true);
-    rotate_matrix.rotate_x(rotation.get_x(), true);
-    rotate_matrix.rotate_y(rotation.get_y(), false);
-    rotate_matrix.rotate_z(rotation.get_z(), false);
-    transfer_matrix.transfer(position.get_x(), position.get_y(), position.get_z(), true);
+    // rotation は派生クラスが直接書き換えるので毎回クォータニオンへ変換する
+    if (!use_orientation) {
+        const auto rotation_f = math::vector4f(rotation);
 
-    if (update_posture_matrix) {
-        posture_matrix = scale_matrix * rotate_matrix * transfer_matrix;
+        orientation = math::quaternionf::from_euler(rotation_f.get_x(), rotation_f.get_y(), rotation_f.get_z());
     }
+
+    const auto matrices = backend::posture_math<backend::object_math>::make(scale, orientation.to_matrix(), position);
 #else
-    auto radian_x = rotation.x * DEGREE_TO_RADIAN;
-    auto radian_y = rotation.y * DEGREE_TO_RADIAN;
-    auto radian_z = rotation.z * DEGREE_TO_RADIAN;
-    auto rot_x = MGetRotX(radian_x);
-    auto rot_y = MGetRotY(radian_y);
-    auto rot_z = MGetRotZ(radian_z);
+    const auto matrices = backend::posture_math<backend::object_math>::make(scale, rotation, position);
+#endif
 
-    scale_matrix = MGetScale(scale);
-    rotate_matrix = MMult(MMult(rot_x, rot_y), rot_z);
-    transfer_matrix = MGetTranslate(position);
+    scale_matrix = matrices.scale;
+    rotate_matrix = matrices.rotate;
+    transfer_matrix = matrices.transfer;
 
     if (update_posture_matrix) {
-        posture_matrix = MMult(MMult(scale_matrix, rotate_matrix), transfer_matrix);
+        posture_matrix = matrices.posture;
     }
-#endif
 
     if (update_after != nullptr) {
         update_after(this);
     }
+
+    update_bounds();
+}
+
+void posture_base::set_local_bounds(const math::vector4f& min, const math::vector4f& max, const float radius) {
+    local_center = (min + max) * 0.5f;
+    local_extent = (max - min) * 0.5f;
+    local_radius = radius;
+    bounds_valid = true;
+
+    update_bounds();
+}
+
+// 中心は点として変換し、境界箱は行列の各成分の絶対値で広がりを求める (Arvo の方法)
+// 球の半径は行列の拡大率の最大値で拡大する
+void posture_base::update_bounds() {
+    if (!bounds_valid) {
+        return;
+    }
+
+    const auto& matrix = backend::object_math::to_math(posture_matrix);
+    const float extent[] = { local_extent.get_x(), local_extent.get_y(), local_extent.get_z() };
+    float world_extent[] = { 0.0f, 0.0f, 0.0f };
+    auto scale = 0.0f;
+
+    for (auto i = 0; i < 3; ++i) {
+        auto row_length = 0.0f;
+
+        for (auto j = 0; j < 3; ++j) {
+            const auto value = matrix.get_value(i, j);
+
+            world_extent[j] += std::abs(value) * extent[i];
+            row_length += value * value;
+        }
+
+        scale = std::max(scale, row_length);
+    }
+
+    bounds_center = local_center * matrix;
+    bounds_extent = math::vector4f(world_extent[0], world_extent[1], world_extent[2]);
+    bounds_radius = local_radius * std::sqrt(scale);
 }
@@ -1,9 +1,10 @@
 #pragma once
 #include <functional>
 #include <tchar.h>
-#if defined(_AMG_MATH)
 #include "vector4.h"
+#if defined(_AMG_MATH)
 #include "matrix44.h"
+#include "quaternion.h"
 #else
 struct tagVECTOR;
 struct tagMATRIX;
@@ -11,12 +12,12 @@ struct tagMATRIX;
 
 class posture_base {
 public:
-    // RXgN^
+    // コンストラクタ
     posture_base();
-    posture_base(const posture_base&) = default; // Rs[
-    posture_base(posture_base&&) = default; // [u
+    posture_base(const posture_base&) = default; // コピー
+    posture_base(posture_base&&) = default; // ムーブ
 
-     // fXgN^
+     // デストラクタ
     virtual ~posture_base() = default;
 
     virtual void process_posture();
@@ -26,17 +27,20 @@ public:
 
 #if defined(_AMG_MATH)
     virtual void set_position(const math::vector4& position) { this->position = position; };
-    virtual void set_rotation(const math::vector4& rotation) { this->rotation = rotation; };
+    virtual void set_rotation(const math::vector4& rotation) { this->rotation = rotation; use_orientation = false; };
     virtual void set_scale(const math::vector4& scale) { this->scale = scale; };
+    // オイラー角の代わりにクォータニオンで回転を指定する(set_rotation を呼ぶまで有効)
+    virtual void set_orientation(const math::quaternionf& orientation) { this->orientation = orientation; use_orientation = true; };
 
     virtual math::vector4 get_position() const { return position; };
     virtual math::vector4 get_rotation() const { return rotation; };
     virtual math::vector4 get_scale() const { return scale; };
-    virtual math::matrix44 get_scale_matrix() const { return scale_matrix; };
-    virtual math::matrix44 get_rotate_matrix() const { return rotate_matrix; };
-    virtual math::matrix44 get_transfer_matrix() const { return transfer_matrix; };
-    virtual math::matrix44 get_posture_matrix() const { return posture_matrix; };
-    virtual void set_posture_matrix(const math::matrix44& posture) { this->posture_matrix = posture; };
+    virtual math::quaternionf get_orientation() const { return orientation; };
+    virtual math::matrix44f get_scale_matrix() const { return scale_matrix; };
+    virtual math::matrix44f get_rotate_matrix() const { return rotate_matrix; };
+    virtual math::matrix44f get_transfer_matrix() const { return transfer_matrix; };
+    virtual math::matrix44f get_posture_matrix() const { return posture_matrix; };
+    virtual void set_posture_matrix(const math::matrix44f& posture) { this->posture_matrix = posture; update_bounds(); };
 #else
     virtual void set_position(const VECTOR position) { this->position = position; };
     virtual void set_rotation(const VECTOR rotation) { this->rotation = rotation; };
@@ -49,13 +53,24 @@ public:
     virtual MATRIX get_rotate_matrix() const { return rotate_matrix; };
     virtual MATRIX get_transfer_matrix() const { return transfer_matrix; };
     virtual MATRIX get_posture_matrix() const { return posture_matrix; };
-    virtual void set_posture_matrix(const MATRIX& posture) { this->posture_matrix = posture; };
+    virtual void set_posture_matrix(const MATRIX& posture) { this->posture_matrix = posture; update_bounds(); };
 #endif
 
     virtual void set_update_posture_matrix(const bool update) { update_posture_matrix = update; }
     virtual bool get_update_posture_matrix() const { return update_posture_matrix; }
 
+    // 視錐台カリング用の境界
+    // モデル座標の軸平行境界箱 (min ～ max) と中心からの球の半径を設定すると、process_posture と set_posture_matrix の度にワールド座標へ変換する
+    void set_local_bounds(const math::vector4f& min, const math::vector4f& max, const float radius);
+    bool has_bounds() const { return bounds_valid; }
+    // ワールド座標の 中心 / 軸平行境界箱の半分の大きさ / 球の半径
+    const math::vector4f& get_bounds_center() const { return bounds_center; }
+    const math::vector4f& get_bounds_extent() const { return bounds_extent; }
+    float get_bounds_radius() const { return bounds_radius; }
+
 protected:
+    void update_bounds();
+
     std::function<void(posture_base*)> update;
     std::function<void(posture_base*)> update_after;
 
@@ -63,10 +78,14 @@ protected:
     math::vector4 position;
     math::vector4 rotation;
     math::vector4 scale;
-    math::matrix44 scale_matrix;
-    math::matrix44 rotate_matrix;
-    math::matrix44 transfer_matrix;
-    math::matrix44 posture_matrix;
+    // 回転はクォータニオンで保持して行列へ展開する
+    math::quaternionf orientation;
+    bool use_orientation;
+    // 描画用の行列は DX ライブラリへそのまま渡せる float 版にする
+    math::matrix44f scale_matrix;
+    math::matrix44f rotate_matrix;
+    math::matrix44f transfer_matrix;
+    math::matrix44f posture_matrix;
 #else
     VECTOR position;
     VECTOR rotation;
@@ -78,4 +97,12 @@ protected:
 #endif
 
     bool update_posture_matrix;
+
+    bool bounds_valid;
+    math::vector4f local_center;
+    math::vector4f local_extent;
+    float local_radius;
+    math::vector4f bounds_center;
+    math::vector4f bounds_extent;
+    float bounds_radius;
 };
\ No newline at end of file
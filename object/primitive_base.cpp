@@ -1,16 +1,18 @@
 #include "DxLib.h"
 #include "primitive_base.h"
-#if defined(_AMG_MATH)
 #include "vector4.h"
 #include "matrix44.h"
 #include "dx_utility.h"
-#endif
+#include "dx_math_policy.h"
+#include <algorithm>
+#include <limits>
 
 namespace {
     constexpr auto DEGREE_TO_RADIAN = DX_PI_F / 180.0f;
     constexpr auto DEBUG_NORMAL_SCALE = 50.0f;
     const auto debug_normal_color = GetColor(255, 0, 0);
-    const MATRIX identity = MGetIdent();
+    // 16bit インデックスで参照できる頂点数
+    constexpr std::size_t INDEX_16BIT_VERTEX_NUM = std::numeric_limits<unsigned short>::max() + 1;
 }
 
 namespace primitive {
@@ -21,15 +23,22 @@ namespace primitive {
         transparent = FALSE;
 
         vertex = std::make_unique<std::vector<VERTEX3D>>();
-        index = std::make_unique<std::vector<unsigned short>>();
+        index = std::make_unique<std::vector<index_type>>();
 
         invisible = false;
         is_debug = false;
+
+        mesh_vertex_num = 0;
+        mesh_index_num = 0;
+        mesh_dirty = true;
+        draw = std::make_shared<mesh_draw>();
+
+        dynamic = false;
+        renderer = get_default_renderer();
     }
 
+    // 頂点とインデックスは他のプリミティブと共有している場合があるので消さない
     primitive_base::~primitive_base() {
-        vertex->clear();
-        index->clear();
     }
 
     bool primitive_base::load(const TCHAR* fileName) {
@@ -56,58 +65,229 @@ namespace primitive {
         return result;
     }
 
+    bool primitive_base::create_shared(const mesh_key& key, const std::function<bool()>& create_mesh) {
+        const auto mesh = mesh_cache::get(key, [&]() -> shared_mesh {
+            vertex = std::make_shared<std::vector<VERTEX3D>>();
+            index = std::make_shared<std::vector<index_type>>();
+
+            if (!create_mesh()) {
+                return {};
+            }
+
+            return { vertex, index, std::make_shared<mesh_draw>() };
+        });
+
+        if (mesh.vertex == nullptr || mesh.index == nullptr) {
+            return false;
+        }
+
+        // 頂点数とインデックス数が同じでも別のメッシュなので、境界を作り直す(チャンクとバッファはメッシュの物を使う)
+        vertex = mesh.vertex;
+        index = mesh.index;
+        draw = mesh.draw;
+        mesh_dirty = true;
+
+        return true;
+    }
+
+    void primitive_base::share_mesh(const primitive_base& source) {
+        vertex = source.vertex;
+        index = source.index;
+        draw = source.draw;
+        mesh_dirty = true;
+    }
+
     void primitive_base::process() {
+        update_mesh_cache();
         process_posture();
     }
 
+    // 境界はプリミティブ毎、チャンクはメッシュ毎に作る
+    void primitive_base::update_mesh_cache() {
+        if (mesh_dirty || mesh_vertex_num != vertex->size() || mesh_index_num != index->size()) {
+            mesh_vertex_num = vertex->size();
+            mesh_index_num = index->size();
+            mesh_dirty = false;
+
+            update_local_bounds();
+        }
+
+        if (draw->dirty || draw->vertex_num != vertex->size() || draw->index_num != index->size()) {
+            draw->vertex_num = vertex->size();
+            draw->index_num = index->size();
+            draw->dirty = false;
+
+            update_draw_list();
+        }
+    }
+
+    // 頂点の軸平行境界箱と、その中心から最も遠い頂点までの球
+    void primitive_base::update_local_bounds() {
+        if (vertex->empty()) {
+            return;
+        }
+
+        auto min = vertex->front().pos;
+        auto max = min;
+
+        for (const auto& v : *vertex) {
+            min = VGet(std::min(min.x, v.pos.x), std::min(min.y, v.pos.y), std::min(min.z, v.pos.z));
+            max = VGet(std::max(max.x, v.pos.x), std::max(max.y, v.pos.y), std::max(max.z, v.pos.z));
+        }
+
+        const auto center = VScale(VAdd(min, max), 0.5f);
+        auto radius = 0.0f;
+
+        for (const auto& v : *vertex) {
+            radius = std::max(radius, VSize(VSub(v.pos, center)));
+        }
+
+        set_local_bounds(ToMathF(min), ToMathF(max), radius);
+    }
+
+    // 三角形を順に見て、参照する頂点の範囲が 16bit に収まる間は同じチャンクにまとめる
+    // 格子状に頂点を並べたメッシュは頂点をコピーせずに分割できる
+    void primitive_base::update_draw_list() {
+        auto& draw_list = draw->chunk_list;
+
+        draw_list.clear();
+
+        const auto& indices = *index;
+        const auto polygon_num = indices.size() / 3;
+        std::size_t start = 0;
+
+        while (start < polygon_num) {
+            auto min = std::numeric_limits<index_type>::max();
+            auto max = std::numeric_limits<index_type>::min();
+            auto end = start;
+
+            for (; end < polygon_num; ++end) {
+                const auto* polygon = indices.data() + end * 3;
+                const auto next_min = std::min({ min, polygon[0], polygon[1], polygon[2] });
+                const auto next_max = std::max({ max, polygon[0], polygon[1], polygon[2] });
+
+                if (next_max - next_min >= INDEX_16BIT_VERTEX_NUM) {
+                    break;
+                }
+
+                min = next_min;
+                max = next_max;
+            }
+
+            mesh_draw::draw_chunk chunk = { min, 0, {}, {}, nullptr };
+
+            if (end == start) {
+                // 1 つの三角形で範囲を超える場合
+                for (auto i = 0; i < 3; ++i) {
+                    chunk.local_vertex.emplace_back((*vertex)[indices[start * 3 + i]]);
+                    chunk.index.emplace_back(static_cast<unsigned short>(i));
+                }
+
+                chunk.vertex_num = chunk.local_vertex.size();
+                end = start + 1;
+            }
+            else {
+                chunk.vertex_num = static_cast<std::size_t>(max - min) + 1;
+                chunk.index.reserve((end - start) * 3);
+
+                for (auto i = start * 3; i < end * 3; ++i) {
+                    chunk.index.emplace_back(static_cast<unsigned short>(indices[i] - min));
+                }
+            }
+
+            draw_list.emplace_back(std::move(chunk));
+            start = end;
+        }
+    }
+
     bool primitive_base::render() {
-        if (invisible) {
+        if (invisible || renderer == nullptr) {
             return false;
         }
 
         auto vertex_num = static_cast<int>(vertex->size());
         auto index_num = static_cast<int>(index->size());
 
-        // |S 1 Ε`悵Ȃ
+        // ポリゴンが 1 つも無ければ描画しない
         if (3 > vertex_num || 3 > index_num) {
             return false;
         }
 
-        auto polygon_num = index_num / 3;
+        update_mesh_cache();
+
         auto use_handle = (handle == -1) ? DX_NONE_GRAPH : handle;
+        const auto wrap = get_texture_wrap();
 
-        SetUseZBuffer3D(TRUE);
-        SetWriteZBuffer3D(TRUE);
+        renderer->set_z_buffer(true, true);
+        renderer->set_transform(backend::object_math::to_math(posture_matrix));
+        renderer->set_lighting(lighting);
 
-#if defined(_AMG_MATH)
-        auto posture_dx = ToDX(posture_matrix);
-        SetTransformToWorld(&posture_dx);
-#else
-        SetTransformToWorld(&posture_matrix);
-#endif
-        SetUseLighting(lighting);
+        if (wrap) {
+            renderer->set_texture_wrap(true);
+        }
 
-        DrawPolygonIndexed3D(vertex->data(), vertex_num, index->data(), polygon_num, use_handle, transparent);
+        for (auto& chunk : draw->chunk_list) {
+            const auto* chunk_vertex = chunk.local_vertex.empty() ? vertex->data() + chunk.first_vertex : chunk.local_vertex.data();
+            const auto chunk_vertex_list = std::span<const VERTEX3D>(chunk_vertex, chunk.vertex_num);
 
-        SetUseLighting(TRUE);
-        SetTransformToWorld(&identity);
+            if (!dynamic && chunk.buffer == nullptr) {
+                // 転送に失敗した場合も -1 を持っておき、毎フレーム作り直さない
+                chunk.buffer.reset(new mesh_draw::gpu_buffer{ renderer, renderer->create_buffer(chunk_vertex_list, chunk.index) });
+            }
 
-        if (is_debug) {
-#if defined(_AMG_MATH)
-            MATRIX posture_dx = ToDX(posture_matrix);
-            MATRIX rotate_dx = ToDX(rotate_matrix);
-#else
-            MATRIX posture_dx = posture_matrix;
-            MATRIX rotate_dx = rotate_matrix;
-#endif
-
-            for (const auto& v : *vertex) {
-                VECTOR position = VTransform(v.pos, posture_dx);
-                VECTOR normal = VTransform(v.norm, rotate_dx);
-                DrawLine3D(position, VAdd(position, VScale(normal, DEBUG_NORMAL_SCALE)), debug_normal_color);
+            if (!dynamic && chunk.buffer->renderer == renderer && chunk.buffer->buffer != -1) {
+                renderer->draw_buffer(chunk.buffer->buffer, use_handle, transparent);
+            }
+            else {
+                renderer->draw_stream(chunk_vertex_list, chunk.index, use_handle, transparent);
             }
         }
 
+        if (wrap) {
+            renderer->set_texture_wrap(false);
+        }
+
+        renderer->set_lighting(TRUE);
+        renderer->set_transform(math::matrix44f());
+
+        if (is_debug) {
+            render_debug_normal();
+        }
+
         return true;
     }
+
+    // 頂点と法線を SoA に並べ替えてまとめて変換する
+    void primitive_base::render_debug_normal() {
+        const auto vertex_num = vertex->size();
+
+        debug_position.resize(vertex_num);
+        debug_normal.resize(vertex_num);
+
+        auto position = debug_position.span();
+        auto normal = debug_normal.span();
+
+        for (std::size_t i = 0; i < vertex_num; ++i) {
+            const auto& v = (*vertex)[i];
+
+            position.x[i] = v.pos.x;
+            position.y[i] = v.pos.y;
+            position.z[i] = v.pos.z;
+            normal.x[i] = v.norm.x;
+            normal.y[i] = v.norm.y;
+            normal.z[i] = v.norm.z;
+        }
+
+        math::batch::transform_point(backend::object_math::to_math(posture_matrix), position);
+        math::batch::transform_normal(backend::object_math::to_math(rotate_matrix), normal);
+
+        for (std::size_t i = 0; i < vertex_num; ++i) {
+            const auto start = math::vector4f(position.x[i], position.y[i], position.z[i]);
+            const auto end = math::vector4f(position.x[i] + normal.x[i] * DEBUG_NORMAL_SCALE,
+                                            position.y[i] + normal.y[i] * DEBUG_NORMAL_SCALE,
+                                            position.z[i] + normal.z[i] * DEBUG_NORMAL_SCALE);
+
+            renderer->draw_line(start, end, debug_normal_color);
+        }
+    }
 }
@@ -4,26 +4,55 @@
 #include <tchar.h>
 #include <memory>
 #include <vector>
+#include <functional>
 #include "posture_base.h"
+#include "mesh_cache.h"
+#include "mesh_renderer.h"
+#include "math_fwd.h"
+#include "batch.h"
 
 struct tagVERTEX3D;
 
-namespace math {
-    class vector4;
-}
-
 namespace primitive {
 
     using face = std::tuple<std::array<math::vector4, 4>/*vertex*/, math::vector4/*normal*/>;
 
+    // メッシュを 16bit インデックスで描画する単位に分けたものと、その GPU のバッファ
+    // 同じメッシュ (mesh_cache で共有したものやコピー) を使うプリミティブで共有する
+    struct mesh_draw {
+        // GPU のバッファ(作ったレンダラーで最後に解放する)
+        struct gpu_buffer {
+            std::shared_ptr<mesh_renderer> renderer;
+            int buffer;
+
+            ~gpu_buffer() { renderer->delete_buffer(buffer); }
+        };
+
+        // 16bit インデックスで描画する単位
+        // 頂点の範囲 (first_vertex から vertex_num 個) を参照する。範囲に収まらない三角形は頂点を local_vertex へコピーする
+        struct draw_chunk {
+            std::size_t first_vertex;
+            std::size_t vertex_num;
+            std::vector<VERTEX3D> local_vertex;
+            std::vector<unsigned short> index;
+            std::shared_ptr<gpu_buffer> buffer;
+        };
+
+        // チャンクを作った時の頂点数とインデックス数(頂点を作り直したら作り直す)
+        std::size_t vertex_num = 0;
+        std::size_t index_num = 0;
+        bool dirty = true;
+        std::vector<draw_chunk> chunk_list;
+    };
+
     class primitive_base : public posture_base {
     public:
-        // RXgN^
+        // コンストラクタ
         primitive_base();
-        primitive_base(const primitive_base&) = default; // Rs[
-        primitive_base(primitive_base&&) = default; // [u
+        primitive_base(const primitive_base&) = default; // コピー
+        primitive_base(primitive_base&&) = default; // ムーブ
 
-         // fXgN^
+         // デストラクタ
         virtual ~primitive_base();
 
         virtual bool load(const TCHAR* fileName);
@@ -44,7 +73,18 @@ namespace primitive {
         const int get_transparent() const { return transparent; };
 
         const std::shared_ptr<std::vector<VERTEX3D>>& get_vertex() const { return vertex; }
-        const std::shared_ptr<std::vector<unsigned short>>& get_index() const { return index; }
+        const std::shared_ptr<std::vector<index_type>>& get_index() const { return index; }
+        // 頂点数・インデックス数を変えずに中身を書き換えた場合に呼ぶ(境界と描画用のチャンクを作り直す)
+        void update_mesh() { mesh_dirty = true; draw->dirty = true; }
+
+        // 静的なメッシュは初めて描画する時に GPU のバッファへ転送し、以降は同じメッシュを使うプリミティブ全てでバッファから描画する
+        // 毎フレーム頂点を書き換える場合は dynamic にする(描画の度に転送する)
+        void set_dynamic(const bool dynamic) { this->dynamic = dynamic; }
+        bool get_dynamic() const { return dynamic; }
+
+        // バッファはメッシュを最初に描画したレンダラーで作る(別のレンダラーでは描画の度に転送する)
+        void set_renderer(const std::shared_ptr<mesh_renderer>& renderer) { this->renderer = renderer; }
+        const std::shared_ptr<mesh_renderer>& get_renderer() const { return renderer; }
 
         void set_invisible(const bool invisible) { this->invisible = invisible; };
         const bool get_invisible() const { return invisible; };
@@ -53,14 +93,40 @@ namespace primitive {
         const bool get_debug() const { return is_debug; };
 
     protected:
+        // 同じ key のメッシュが生成済みなら共有し、無ければ新しい vertex / index へ create_mesh で作って登録する
+        bool create_shared(const mesh_key& key, const std::function<bool()>& create_mesh);
+        // source の頂点・インデックスと GPU のバッファを共有する
+        void share_mesh(const primitive_base& source);
+        // テクスチャ座標が 0 ～ 1 を超えるメッシュは描画中だけテクスチャを繰り返す
+        virtual bool get_texture_wrap() const { return false; }
+
         int handle;
         int lighting;
         int transparent;
 
         std::shared_ptr<std::vector<VERTEX3D>> vertex;
-        std::shared_ptr<std::vector<unsigned short>> index;
+        std::shared_ptr<std::vector<index_type>> index;
 
         bool invisible;
         bool is_debug;
+
+    private:
+        void render_debug_normal();
+        void update_mesh_cache();
+        void update_local_bounds();
+        void update_draw_list();
+
+        // 境界を作った時の頂点数とインデックス数(頂点を作り直したら作り直す)
+        std::size_t mesh_vertex_num;
+        std::size_t mesh_index_num;
+        bool mesh_dirty;
+        std::shared_ptr<mesh_draw> draw;
+
+        bool dynamic;
+        std::shared_ptr<mesh_renderer> renderer;
+
+        // デバッグ表示用の作業領域
+        math::basic_soa_buffer<float> debug_position;
+        math::basic_soa_buffer<float> debug_normal;
     };
 }
@@ -10,17 +10,42 @@ namespace {
     constexpr COLOR_U8 DEFAULT_DIFFUSE = { 255, 255, 255, 255 };
     constexpr COLOR_U8 DEFAULT_SPECULAR = { 0, 0, 0, 0 };
 
-    // 6 ʕ̖@
-    math::vector4 normal_front  = {  0.0,  0.0, -1.0 };
-    math::vector4 normal_right  = {  1.0,  0.0,  0.0 };
-    math::vector4 normal_back   = {  0.0,  0.0,  1.0 };
-    math::vector4 normal_left   = { -1.0,  0.0,  0.0 };
-    math::vector4 normal_top    = {  0.0,  1.0,  0.0 };
-    math::vector4 normal_bottom = {  0.0, -1.0,  0.0 };
-    std::array<math::vector4, 6> normal_list = {
+    // 6 面分の法線
+    constexpr math::vector4 normal_front  = {  0.0,  0.0, -1.0 };
+    constexpr math::vector4 normal_right  = {  1.0,  0.0,  0.0 };
+    constexpr math::vector4 normal_back   = {  0.0,  0.0,  1.0 };
+    constexpr math::vector4 normal_left   = { -1.0,  0.0,  0.0 };
+    constexpr math::vector4 normal_top    = {  0.0,  1.0,  0.0 };
+    constexpr math::vector4 normal_bottom = {  0.0, -1.0,  0.0 };
+    constexpr std::array<math::vector4, 6> normal_list = {
         normal_front, normal_right, normal_back, normal_left, normal_top, normal_bottom
     };
 
+    // 一辺 1 の立方体の 6 面分の頂点(create でサイズを掛ける)
+    constexpr auto unit_face_list = [] {
+        constexpr auto half = 0.5;
+        constexpr std::array<math::vector4, 8> position = {
+            math::vector4(-half,  half, -half), math::vector4(-half,  half,  half),
+            math::vector4( half,  half, -half), math::vector4( half,  half,  half),
+            math::vector4(-half, -half, -half), math::vector4(-half, -half,  half),
+            math::vector4( half, -half, -half), math::vector4( half, -half,  half)
+        };
+        // front, right, back, left, top, bottom の順に頂点番号を並べる
+        constexpr std::array<std::array<int, 4>, 6> face_index = { {
+            { 4, 0, 6, 2 }, { 6, 2, 7, 3 }, { 7, 3, 5, 1 },
+            { 5, 1, 4, 0 }, { 0, 1, 2, 3 }, { 4, 5, 6, 7 }
+        } };
+        std::array<std::array<math::vector4, 4>, 6> list;
+
+        for (auto face = 0; face < 6; ++face) {
+            for (auto i = 0; i < 4; ++i) {
+                list[face][i] = position[face_index[face][i]];
+            }
+        }
+
+        return list;
+    }();
+
     constexpr auto DEBUG_NORMAL_SCALE = 50.0f;
     const auto debug_normal_color = GetColor(255, 0, 0);
 }
@@ -42,51 +67,30 @@ namespace primitive {
     }
 
     bool cube::create() {
-        // { 8 _
-        auto half_size = size * 0.5;
-        auto position_0 = math::vector4(-half_size,  half_size, -half_size);
-        auto position_1 = math::vector4(-half_size,  half_size,  half_size);
-        auto position_2 = math::vector4( half_size,  half_size, -half_size);
-        auto position_3 = math::vector4( half_size,  half_size,  half_size);
-        auto position_4 = math::vector4(-half_size, -half_size, -half_size);
-        auto position_5 = math::vector4(-half_size, -half_size,  half_size);
-        auto position_6 = math::vector4( half_size, -half_size, -half_size);
-        auto position_7 = math::vector4( half_size, -half_size,  half_size);
-        std::array<math::vector4, 4> face_front = {
-            position_4, position_0, position_6, position_2
-        };
-        std::array<math::vector4, 4> face_right = {
-            position_6, position_2, position_7, position_3
-        };
-        std::array<math::vector4, 4> face_back = {
-            position_7, position_3, position_5, position_1
-        };
-        std::array<math::vector4, 4> face_left = {
-            position_5, position_1, position_4, position_0
-        };
-        std::array<math::vector4, 4> face_top = {
-            position_0, position_1, position_2, position_3
-        };
-        std::array<math::vector4, 4> face_bottm = {
-            position_4, position_5, position_6, position_7
-        };
+        // 頂点はコンパイル時に作った単位立方体をサイズ倍する
+        for (const auto& unit_face : unit_face_list) {
+            std::array<math::vector4, 4> face_vertices;
+
+            for (auto i = 0; i < 4; ++i) {
+                face_vertices[i] = unit_face[i] * size;
+            }
+
+            face_list.emplace_back(face_vertices);
+        }
 
-        face_list.emplace_back(face_front);
-        face_list.emplace_back(face_right);
-        face_list.emplace_back(face_back);
-        face_list.emplace_back(face_left);
-        face_list.emplace_back(face_top);
-        face_list.emplace_back(face_bottm);
+        return create_shared({ "cube", size, 0, 0 }, [this]() { return create_mesh(); });
+    }
 
-        // uv ̃e[u
+    bool cube::create_mesh() {
+        // uv のテーブル
         constexpr std::array<float, 4> u_list = { 0.0f, 0.0f, 1.0f, 1.0f };
         constexpr std::array<float, 4> v_list = { 0.0f, 1.0f, 0.0f, 1.0f };
 
-        unsigned short offset_index = 0;
+        index_type offset_index = 0;
 
-        // cube  6 
+        // cube の 6 面
         for (auto face = 0; face < 6; ++face) {
-            // ``
+            // 正方形を形成する
             for (auto i = 0; i < 4; ++i) {
                 VERTEX3D vertex;
                 auto face_vertices = face_list[face];
@@ -118,13 +122,16 @@ namespace primitive {
     const face cube::get_face(face_type type) const {
         auto index = static_cast<int>(type);
 #if defined(_AMG_MATH)
+        // コリジョンは double 版で処理する
+        const auto posture_math = math::matrix44(posture_matrix);
         std::array<math::vector4, 4> face_vertices = {
-            face_list[index][0] * posture_matrix,
-            face_list[index][1] * posture_matrix,
-            face_list[index][2] * posture_matrix,
-            face_list[index][3] * posture_matrix
+            face_list[index][0] * posture_math,
+            face_list[index][1] * posture_math,
+            face_list[index][2] * posture_math,
+            face_list[index][3] * posture_math
         };
-        auto face_normal = normal_list[index] * rotate_matrix;
+        const auto rotate_math = math::matrix44(rotate_matrix);
+        auto face_normal = normal_list[index] * rotate_math;
 #else
         MATRIX posture_dx = posture_matrix;
         auto posture_math = ToMath(posture_dx);
@@ -2,10 +2,7 @@
 #include <array>
 #include <vector>
 #include "primitive_base.h"
-
-namespace math {
-    class vector4;
-}
+#include "math_fwd.h"
 
 namespace primitive {
 
@@ -15,13 +12,13 @@ namespace primitive {
             front, right, back, left, top, bottonm
         };
 
-        // RXgN^
+        // コンストラクタ
         cube();
         cube(double size);
-        cube(const cube&) = default; // Rs[
-        cube(cube&&) = default; // [u
+        cube(const cube&) = default; // コピー
+        cube(cube&&) = default; // ムーブ
 
-         // fXgN^
+         // デストラクタ
         virtual ~cube() = default;
 
         bool initialize(double size);
@@ -32,6 +29,8 @@ namespace primitive {
         double get_size() const { return size; }
 
     protected:
+        bool create_mesh();
+
         double size;
         std::vector<std::array<math::vector4, 4>> face_list;
     };
@@ -0,0 +1,279 @@
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+#include "DxLib.h"
+#include "primitive_icosphere.h"
+#include "camera_base.h"
+#include "vector4.h"
+#include "dx_utility.h"
+#include "dx_math_policy.h"
+
+namespace {
+    constexpr auto DEFAULT_RADIUS = 10.0;
+    constexpr auto DEFAULT_LEVEL = 3;
+    constexpr COLOR_U8 DEFAULT_DIFFUSE = { 255, 255, 255, 255 };
+    constexpr COLOR_U8 DEFAULT_SPECULAR = { 0, 0, 0, 0 };
+    constexpr auto PI2_RADIAN = DX_PI * 2.0;
+    // 画面上の辺の長さ(ピクセル)がこれ以下になる最小のレベルを選ぶ
+    constexpr auto LOD_EDGE_PIXEL = 24.0;
+    // 正二十面体の大円に沿った辺の数(分割の度に 2 倍になる)
+    constexpr auto GREAT_CIRCLE_EDGE_NUM = 5.0;
+    // レベルを下げる時は余裕を持たせて、境界付近で毎フレーム切り替わらない様にする
+    constexpr auto LOD_HYSTERESIS = 0.25;
+    // 極とみなす y の大きさ
+    constexpr auto POLE_Y = 1.0 - 1e-9;
+
+    using triangle = std::array<primitive::index_type, 3>;
+
+    // 単位球上の頂点と三角形
+    struct geodesic {
+        std::vector<math::vector4> position;
+        std::vector<triangle> face;
+    };
+
+    // レベル毎の単位球 (描画用のメッシュは半径 x レベル毎に mesh_cache で共有する)
+    std::vector<geodesic> geodesic_list;
+
+    // 三角形の向きは primitive::sphere と同じにする
+    geodesic create_icosahedron() {
+        const auto t = (1.0 + std::sqrt(5.0)) * 0.5;
+        const std::array<math::vector4, 12> position_list = {
+            math::vector4(-1.0,    t,  0.0), math::vector4( 1.0,    t,  0.0),
+            math::vector4(-1.0,   -t,  0.0), math::vector4( 1.0,   -t,  0.0),
+            math::vector4( 0.0, -1.0,    t), math::vector4( 0.0,  1.0,    t),
+            math::vector4( 0.0, -1.0,   -t), math::vector4( 0.0,  1.0,   -t),
+            math::vector4(   t,  0.0, -1.0), math::vector4(   t,  0.0,  1.0),
+            math::vector4(  -t,  0.0, -1.0), math::vector4(  -t,  0.0,  1.0)
+        };
+        constexpr std::array<triangle, 20> face_list = { {
+            { 0, 11, 5 }, { 0, 5, 1 }, { 0, 1, 7 }, { 0, 7, 10 }, { 0, 10, 11 },
+            { 1, 5, 9 }, { 5, 11, 4 }, { 11, 10, 2 }, { 10, 7, 6 }, { 7, 1, 8 },
+            { 3, 9, 4 }, { 3, 4, 2 }, { 3, 2, 6 }, { 3, 6, 8 }, { 3, 8, 9 },
+            { 4, 9, 5 }, { 2, 4, 11 }, { 6, 2, 10 }, { 8, 6, 7 }, { 9, 8, 1 }
+        } };
+
+        geodesic result;
+
+        for (const auto& position : position_list) {
+            result.position.emplace_back(position.normalize());
+        }
+
+        for (auto face : face_list) {
+            const auto& a = result.position[face[0]];
+            const auto& b = result.position[face[1]];
+            const auto& c = result.position[face[2]];
+
+            if ((b - a).cross(c - a).dot(a) > 0.0) {
+                std::swap(face[1], face[2]);
+            }
+
+            result.face.emplace_back(face);
+        }
+
+        return result;
+    }
+
+    // 三角形を 4 分割して、辺の中点を球面へ押し出す(辺を共有する三角形で中点の頂点を共有する)
+    geodesic subdivide(const geodesic& source) {
+        geodesic result;
+        std::unordered_map<std::uint64_t, primitive::index_type> middle_list;
+
+        result.position = source.position;
+        result.position.reserve(source.position.size() + source.face.size() * 3 / 2);
+        result.face.reserve(source.face.size() * 4);
+
+        const auto get_middle = [&](const primitive::index_type a, const primitive::index_type b) {
+            const auto key = (static_cast<std::uint64_t>(std::min(a, b)) << 32) | std::max(a, b);
+            const auto [it, inserted] = middle_list.try_emplace(key, static_cast<primitive::index_type>(result.position.size()));
+
+            if (inserted) {
+                result.position.emplace_back((result.position[a] + result.position[b]).normalize());
+            }
+
+            return it->second;
+        };
+
+        for (const auto& [a, b, c] : source.face) {
+            const auto ab = get_middle(a, b);
+            const auto bc = get_middle(b, c);
+            const auto ca = get_middle(c, a);
+
+            result.face.insert(result.face.end(), { { a, ab, ca }, { b, bc, ab }, { c, ca, bc }, { ab, bc, ca } });
+        }
+
+        return result;
+    }
+
+    // mesh_cache の生成中 (ロックを取得している間) だけ呼ぶ
+    const geodesic& get_geodesic(const int level) {
+        if (geodesic_list.empty()) {
+            geodesic_list.emplace_back(create_icosahedron());
+        }
+
+        while (static_cast<int>(geodesic_list.size()) <= level) {
+            geodesic_list.emplace_back(subdivide(geodesic_list.back()));
+        }
+
+        return geodesic_list[level];
+    }
+
+    // uv は primitive::sphere と同じ経度・緯度の割り当てにする
+    // 経度 0 度をまたぐ三角形は u が 1 を超える頂点を複製し、極の頂点は三角形毎に他の 2 頂点の u の平均で複製する
+    void create_geodesic_mesh(const geodesic& source, const double radius, std::vector<VERTEX3D>& vertex, std::vector<primitive::index_type>& index) {
+        std::unordered_map<primitive::index_type, primitive::index_type> seam_list;
+
+        vertex.reserve(source.position.size() + source.position.size() / 8);
+        index.reserve(source.face.size() * 3);
+
+        for (const auto& position : source.position) {
+            const auto angle_x = std::acos(std::clamp(-position.get_y(), -1.0, 1.0));
+            auto angle_y = std::atan2(-position.get_x(), -position.get_z());
+
+            if (angle_y < 0.0) {
+                angle_y += PI2_RADIAN;
+            }
+
+            VERTEX3D v;
+
+            v.pos = ToDX(position * radius);
+            v.norm = ToDX(position);
+            v.dif = DEFAULT_DIFFUSE;
+            v.spc = DEFAULT_SPECULAR;
+            v.u = static_cast<float>(1.0 - angle_y / PI2_RADIAN);
+            v.v = static_cast<float>(1.0 - angle_x / DX_PI);
+
+            vertex.emplace_back(std::move(v));
+        }
+
+        const auto is_pole = [&](const primitive::index_type i) {
+            return std::abs(source.position[i].get_y()) > POLE_Y;
+        };
+
+        const auto duplicate = [&](const primitive::index_type i, const float u) {
+            auto v = vertex[i];
+
+            v.u = u;
+            vertex.emplace_back(std::move(v));
+
+            return static_cast<primitive::index_type>(vertex.size() - 1);
+        };
+
+        for (auto face : source.face) {
+            auto min_u = 1.0f;
+            auto max_u = 0.0f;
+
+            for (const auto i : face) {
+                if (!is_pole(i)) {
+                    min_u = std::min(min_u, vertex[i].u);
+                    max_u = std::max(max_u, vertex[i].u);
+                }
+            }
+
+            if (max_u - min_u > 0.5f) {
+                for (auto& i : face) {
+                    if (!is_pole(i) && vertex[i].u < 0.5f) {
+                        const auto [it, inserted] = seam_list.try_emplace(i, 0);
+
+                        if (inserted) {
+                            it->second = duplicate(i, vertex[i].u + 1.0f);
+                        }
+
+                        i = it->second;
+                    }
+                }
+            }
+
+            for (auto k = 0; k < 3; ++k) {
+                if (is_pole(face[k])) {
+                    const auto u = (vertex[face[(k + 1) % 3]].u + vertex[face[(k + 2) % 3]].u) * 0.5f;
+
+                    face[k] = duplicate(face[k], u);
+                }
+            }
+
+            index.insert(index.end(), face.begin(), face.end());
+        }
+    }
+}
+
+namespace primitive {
+
+    icosphere::icosphere() : sphere(DEFAULT_RADIUS, 0) {
+        level = DEFAULT_LEVEL;
+        current_level = -1;
+    }
+
+    icosphere::icosphere(double radius, int level) : sphere(radius, 0) {
+        this->level = std::clamp(level, 0, max_level);
+        current_level = -1;
+    }
+
+    bool icosphere::initialize(double radius, int level) {
+        this->radius = radius;
+        this->level = std::clamp(level, 0, max_level);
+        current_level = -1;
+
+        return true;
+    }
+
+    bool icosphere::create() {
+        current_level = -1;
+
+        return set_level(level);
+    }
+
+    void icosphere::process() {
+        sphere::process();
+        select_level();
+    }
+
+    // 画面上の半径 (ピクセル) から、大円に沿った辺が LOD_EDGE_PIXEL 以下になるレベルを求める
+    void icosphere::select_level() {
+        const auto camera = this->camera.lock();
+
+        if (camera == nullptr || !has_bounds() || current_level < 0) {
+            return;
+        }
+
+        const auto camera_position = backend::object_math::to_math(camera->get_position());
+        const auto distance = static_cast<double>((get_bounds_center() - camera_position).length());
+        const auto bounds_radius = static_cast<double>(get_bounds_radius());
+
+        if (distance <= bounds_radius) {
+            set_level(level);
+            return;
+        }
+
+        const auto screen_radius = bounds_radius / (distance * std::tan(camera->get_fov() * 0.5)) * camera->get_screen_height() * 0.5;
+        const auto lod = std::max(std::log2(PI2_RADIAN * screen_radius / (GREAT_CIRCLE_EDGE_NUM * LOD_EDGE_PIXEL)), 0.0);
+        auto next_level = std::clamp(static_cast<int>(std::ceil(lod)), 0, level);
+
+        if (next_level < current_level && lod > current_level - 1 - LOD_HYSTERESIS) {
+            next_level = current_level;
+        }
+
+        set_level(next_level);
+    }
+
+    bool icosphere::set_level(const int level) {
+        if (level == current_level) {
+            return true;
+        }
+
+        const auto created = create_shared({ "icosphere", radius, level, 0 }, [&]() {
+            create_geodesic_mesh(get_geodesic(level), radius, *vertex, *index);
+
+            return true;
+        });
+
+        if (created) {
+            current_level = level;
+        }
+
+        return created;
+    }
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <memory>
+#include "primitive_sphere.h"
+
+namespace world {
+    class camera_base;
+}
+
+namespace primitive {
+
+    // 正二十面体を分割した球 (geodesic sphere)
+    // 分割レベル毎のメッシュと GPU のバッファは mesh_cache でプロセス全体で共有し、画面上の大きさでレベルを選ぶ(レベルを戻しても転送し直さない)
+    // レベル n の三角形数は 20 * 4^n
+    class icosphere : public sphere {
+    public:
+        static constexpr auto max_level = 7;
+
+        // コンストラクタ
+        icosphere();
+        icosphere(double radius, int level);
+        icosphere(const icosphere&) = default; // コピー
+        icosphere(icosphere&&) = default; // ムーブ
+
+         // デストラクタ
+        virtual ~icosphere() = default;
+
+        // level は最も近い時の分割レベル
+        bool initialize(double radius, int level);
+        bool create() override;
+
+        void process() override;
+
+        // 画面上の大きさを求めるカメラ(設定しない場合は常に最大レベル)
+        void set_camera(const std::shared_ptr<world::camera_base>& camera) { this->camera = camera; }
+
+        int get_level() const { return level; }
+        int get_current_level() const { return current_level; }
+
+    protected:
+        // 経度 0 度をまたぐ三角形の u は 1 を超える
+        bool get_texture_wrap() const override { return true; }
+
+        void select_level();
+        bool set_level(const int level);
+
+        int level;
+        int current_level;
+        std::weak_ptr<world::camera_base> camera;
+    };
+}
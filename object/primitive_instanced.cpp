@@ -0,0 +1,347 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include "DxLib.h"
+#include "primitive_instanced.h"
+#include "camera_base.h"
+#include "frustum.h"
+#include "vector4.h"
+#include "matrix44.h"
+#include "dx_utility.h"
+#include "dx_math_policy.h"
+
+namespace {
+    constexpr auto VERTEX_SHADER_FILE = _T("shader/vertex_shader_instancing.vso");
+    constexpr auto PIXEL_SHADER_FILE = _T("shader/pixel_shader_instancing.pso");
+    // 16bit インデックスで参照できる頂点数
+    constexpr std::size_t INDEX_16BIT_VERTEX_NUM = std::numeric_limits<unsigned short>::max() + 1;
+    const MATRIX identity = MGetIdent();
+
+    // 定数バッファの先頭のパラメータ (float4 1 つ、x: ライティング y: 線形フォグ) の float の数
+    constexpr auto PARAM_FLOAT_NUM = 4;
+
+    // シェーダーと定数バッファは全てのインスタンス描画で共有する(読み込めなければ 1 つずつ描画する)
+    struct {
+        bool loaded = false;
+        int vertex_shader = -1;
+        int pixel_shader = -1;
+        int constant_buffer = -1;
+    } instancing_shader;
+
+    bool load_shader() {
+        if (!instancing_shader.loaded) {
+            instancing_shader.loaded = true;
+            instancing_shader.vertex_shader = LoadVertexShader(VERTEX_SHADER_FILE);
+            instancing_shader.pixel_shader = LoadPixelShader(PIXEL_SHADER_FILE);
+            instancing_shader.constant_buffer = CreateShaderConstantBuffer(sizeof(float) * (PARAM_FLOAT_NUM + 4 * 4 * primitive::instanced::batch_num));
+        }
+
+        return (-1 != instancing_shader.vertex_shader && -1 != instancing_shader.pixel_shader && -1 != instancing_shader.constant_buffer);
+    }
+}
+
+namespace primitive {
+
+    instanced::instanced() : primitive_base() {
+        mesh_radius = 0.0f;
+    }
+
+    instanced::batch_buffer::~batch_buffer() {
+        if (vertex_buffer != -1) {
+            DeleteVertexBuffer(vertex_buffer);
+        }
+
+        if (index_buffer != -1) {
+            DeleteIndexBuffer(index_buffer);
+        }
+    }
+
+    bool instanced::create() {
+        return !vertex->empty() && !index->empty();
+    }
+
+    bool instanced::set_mesh(const primitive_base& source) {
+        if (source.get_vertex()->empty() || source.get_index()->empty()) {
+            return false;
+        }
+
+        share_mesh(source);
+        handle = source.get_handle();
+        lighting = source.get_lighting();
+        transparent = source.get_transparent();
+        batch.reset();
+
+        auto min = vertex->front().pos;
+        auto max = min;
+
+        for (const auto& v : *vertex) {
+            min = VGet(std::min(min.x, v.pos.x), std::min(min.y, v.pos.y), std::min(min.z, v.pos.z));
+            max = VGet(std::max(max.x, v.pos.x), std::max(max.y, v.pos.y), std::max(max.z, v.pos.z));
+        }
+
+        const auto center = VScale(VAdd(min, max), 0.5f);
+
+        mesh_radius = 0.0f;
+
+        for (const auto& v : *vertex) {
+            mesh_radius = std::max(mesh_radius, VSize(VSub(v.pos, center)));
+        }
+
+        mesh_center = ToMathF(center);
+        mesh_extent = ToMathF(VScale(VSub(max, min), 0.5f));
+
+        return true;
+    }
+
+    std::size_t instanced::add_instance(const math::matrix44f& world, const COLOR_F& color) {
+        instance_list.emplace_back();
+        set_instance(instance_list.size() - 1, world, color);
+
+        return instance_list.size() - 1;
+    }
+
+    void instanced::set_instance(const std::size_t index, const math::matrix44f& world, const COLOR_F& color) {
+        auto& instance = instance_list[index];
+
+        for (auto column = 0; column < 3; ++column) {
+            for (auto row = 0; row < 4; ++row) {
+                instance.world[column][row] = world.get_value(row, column);
+            }
+        }
+
+        instance.color = { color.r, color.g, color.b, color.a };
+    }
+
+    void instanced::process() {
+        primitive_base::process();
+        cull_instance();
+    }
+
+    // インスタンス毎のワールド座標の境界を求めて視錐台の中に残ったものを visible_list へ詰める
+    // 全インスタンスを囲む境界を自身の境界にして、world_base のカリングでまとめて省けるようにする
+    void instanced::cull_instance() {
+        const auto count = instance_list.size();
+
+        visible_list.clear();
+
+        if (count == 0) {
+            return;
+        }
+
+        cull_center.resize(count);
+        cull_extent.resize(count);
+        cull_radius.resize(count);
+
+        auto center = cull_center.span();
+        auto extent = cull_extent.span();
+        auto min = math::vector4f(std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max());
+        auto max = math::vector4f(std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest());
+        const float local_center[] = { mesh_center.get_x(), mesh_center.get_y(), mesh_center.get_z() };
+        const float local_extent[] = { mesh_extent.get_x(), mesh_extent.get_y(), mesh_extent.get_z() };
+
+        for (std::size_t i = 0; i < count; ++i) {
+            const auto& world = instance_list[i].world;
+            float c[3];
+            float e[3];
+
+            for (auto column = 0; column < 3; ++column) {
+                c[column] = world[column][3];
+                e[column] = 0.0f;
+
+                for (auto row = 0; row < 3; ++row) {
+                    c[column] += local_center[row] * world[column][row];
+                    e[column] += local_extent[row] * std::abs(world[column][row]);
+                }
+            }
+
+            auto scale = 0.0f;
+
+            for (auto row = 0; row < 3; ++row) {
+                scale = std::max(scale, world[0][row] * world[0][row] + world[1][row] * world[1][row] + world[2][row] * world[2][row]);
+            }
+
+            center.x[i] = c[0];
+            center.y[i] = c[1];
+            center.z[i] = c[2];
+            extent.x[i] = e[0];
+            extent.y[i] = e[1];
+            extent.z[i] = e[2];
+            cull_radius[i] = mesh_radius * std::sqrt(scale);
+
+            min = math::vector4f(std::min(min.get_x(), c[0] - e[0]), std::min(min.get_y(), c[1] - e[1]), std::min(min.get_z(), c[2] - e[2]));
+            max = math::vector4f(std::max(max.get_x(), c[0] + e[0]), std::max(max.get_y(), c[1] + e[1]), std::max(max.get_z(), c[2] + e[2]));
+        }
+
+        set_local_bounds(min, max, ((max - min) * 0.5f).length());
+
+        const auto camera = this->camera.lock();
+
+        if (camera == nullptr) {
+            visible_list = instance_list;
+            return;
+        }
+
+        cull_visible.resize(count);
+
+        const auto visible = cull_visible.span();
+
+        math::batch::cull(camera->get_frustum(), center, extent, cull_radius, visible);
+
+        for (std::size_t i = 0; i < count; ++i) {
+            if (visible[i]) {
+                visible_list.emplace_back(instance_list[i]);
+            }
+        }
+    }
+
+    bool instanced::render() {
+        if (invisible || visible_list.empty() || vertex->size() < 3 || index->size() < 3) {
+            return false;
+        }
+
+        if (!render_shader()) {
+            render_each();
+        }
+
+        return true;
+    }
+
+    // メッシュを並べたバッファを 1 回の描画で batch_num 個ずつ描画する
+    // シェーダーのフォグは線形だけなので、他のモードのフォグが有効な場合は 1 つずつ描画する
+    bool instanced::render_shader() {
+        const auto fog = (GetFogEnable() == TRUE);
+
+        if (!load_shader() || (fog && GetFogMode() != DX_FOGMODE_LINEAR)) {
+            return false;
+        }
+
+        if (batch == nullptr) {
+            create_batch_buffer();
+        }
+
+        if (batch->vertex_buffer == -1 || batch->index_buffer == -1) {
+            return false;
+        }
+
+        const auto vertex_num = static_cast<int>(vertex->size());
+        const auto index_num = static_cast<int>(index->size());
+        const auto visible_num = visible_list.size();
+
+        SetUseZBuffer3D(TRUE);
+        SetWriteZBuffer3D(TRUE);
+        SetTransformToWorld(&identity);
+
+        if (transparent) {
+            SetDrawBlendMode(DX_BLENDMODE_ALPHA, 255);
+        }
+
+        SetUseVertexShader(instancing_shader.vertex_shader);
+        SetUsePixelShader(instancing_shader.pixel_shader);
+        SetUseTextureToShader(0, (handle == -1) ? DX_NONE_GRAPH : handle);
+
+        for (std::size_t start = 0; start < visible_num; start += batch->instance_num) {
+            const auto instance_num = static_cast<int>(std::min<std::size_t>(batch->instance_num, visible_num - start));
+            auto* param = static_cast<float*>(GetBufferShaderConstantBuffer(instancing_shader.constant_buffer));
+            auto* data = reinterpret_cast<instance_data*>(param + PARAM_FLOAT_NUM);
+
+            param[0] = (lighting != FALSE) ? 1.0f : 0.0f;
+            param[1] = fog ? 1.0f : 0.0f;
+            param[2] = 0.0f;
+            param[3] = 0.0f;
+            std::copy_n(visible_list.begin() + start, instance_num, data);
+
+            UpdateShaderConstantBuffer(instancing_shader.constant_buffer);
+            SetShaderConstantBuffer(instancing_shader.constant_buffer, DX_SHADERTYPE_VERTEX, 4);
+
+            DrawPrimitiveIndexed3DToShader_UseVertexBuffer2(batch->vertex_buffer, batch->index_buffer, DX_PRIMTYPE_TRIANGLELIST,
+                                                            0, 0, vertex_num * instance_num, 0, index_num * instance_num);
+        }
+
+        SetUseTextureToShader(0, -1);
+        SetUseVertexShader(-1);
+        SetUsePixelShader(-1);
+
+        if (transparent) {
+            SetDrawBlendMode(DX_BLENDMODE_NOBLEND, 0);
+        }
+
+        return true;
+    }
+
+    // 頂点の spos.x にバッファ内のインスタンス番号を入れて、メッシュを 16bit インデックスに収まる数だけ並べる
+    // 16bit に収まらないメッシュはバッファを作らない(1 つずつ描画する)
+    void instanced::create_batch_buffer() {
+        batch.reset(new batch_buffer{ -1, -1, 0 });
+
+        const auto vertex_num = vertex->size();
+        const auto index_num = index->size();
+
+        if (vertex_num > INDEX_16BIT_VERTEX_NUM) {
+            return;
+        }
+
+        const auto instance_num = std::min<std::size_t>(batch_num, INDEX_16BIT_VERTEX_NUM / vertex_num);
+        std::vector<VERTEX3DSHADER> batch_vertex;
+        std::vector<unsigned short> batch_index;
+
+        batch_vertex.reserve(vertex_num * instance_num);
+        batch_index.reserve(index_num * instance_num);
+
+        for (std::size_t i = 0; i < instance_num; ++i) {
+            for (const auto& v : *vertex) {
+                VERTEX3DSHADER shader_vertex = {};
+
+                shader_vertex.pos = v.pos;
+                shader_vertex.spos = { static_cast<float>(i), 0.0f, 0.0f, 0.0f };
+                shader_vertex.norm = v.norm;
+                shader_vertex.dif = v.dif;
+                shader_vertex.spc = v.spc;
+                shader_vertex.u = v.u;
+                shader_vertex.v = v.v;
+                shader_vertex.su = v.su;
+                shader_vertex.sv = v.sv;
+
+                batch_vertex.emplace_back(shader_vertex);
+            }
+
+            for (const auto j : *index) {
+                batch_index.emplace_back(static_cast<unsigned short>(i * vertex_num + j));
+            }
+        }
+
+        batch->vertex_buffer = CreateVertexBuffer(static_cast<int>(batch_vertex.size()), DX_VERTEX_TYPE_SHADER_3D);
+        batch->index_buffer = CreateIndexBuffer(static_cast<int>(batch_index.size()), DX_INDEX_TYPE_16BIT);
+        batch->instance_num = static_cast<int>(instance_num);
+
+        if (batch->vertex_buffer == -1 || batch->index_buffer == -1
+            || SetVertexBufferData(0, batch_vertex.data(), static_cast<int>(batch_vertex.size()), batch->vertex_buffer) == -1
+            || SetIndexBufferData(0, batch_index.data(), static_cast<int>(batch_index.size()), batch->index_buffer) == -1) {
+            batch.reset(new batch_buffer{ -1, -1, 0 });
+        }
+    }
+
+    // シェーダーが使えない場合は姿勢の行列をインスタンスの行列に置き換えて 1 つずつ描画する
+    void instanced::render_each() {
+        const auto posture = posture_matrix;
+
+        for (const auto& instance : visible_list) {
+            math::matrix44f world;
+
+            for (auto column = 0; column < 3; ++column) {
+                for (auto row = 0; row < 4; ++row) {
+                    world.set_value(row, column, instance.world[column][row]);
+                }
+            }
+
+            world.set_value(0, 3, 0.0f);
+            world.set_value(1, 3, 0.0f);
+            world.set_value(2, 3, 0.0f);
+            world.set_value(3, 3, 1.0f);
+
+            posture_matrix = backend::object_math::to_native(world);
+            primitive_base::render();
+        }
+
+        posture_matrix = posture;
+    }
+}
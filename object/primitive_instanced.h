@@ -0,0 +1,93 @@
+#pragma once
+#include <array>
+#include <memory>
+#include <vector>
+#include "primitive_base.h"
+
+struct tagCOLOR_F;
+
+namespace world {
+    class camera_base;
+}
+
+namespace primitive {
+
+    // 同じメッシュを多数描画するプリミティブ
+    // インスタンス毎のワールド行列と色を詰めて持ち、シェーダーの定数バッファから batch_num 個ずつまとめて描画する
+    // インスタンスストリームによる 1 回の描画ではなく、メッシュを batch_num 個複製したバッファを batch_num 個毎に 1 回描画する
+    // (描画回数はインスタンス数 / batch_num、1 万個で 40 回。メッシュの頂点数 x batch_num が 16bit インデックスに収まらない場合は更に分ける)
+    // shader/vertex_shader_instancing.vso / pixel_shader_instancing.pso (コンパイル済み) が読み込めない場合は
+    // インスタンス毎に primitive_base::render で描画する(まとめて描画する利点はない)
+    // インスタンスの行列はワールド座標 (自身の位置・回転・拡大は使わない)
+    // シェーダーはライト 0 の平行光源・アンビエントと線形フォグを DX ライブラリの設定から取る(スペキュラは使わない)
+    class instanced : public primitive_base {
+    public:
+        // 1 回の描画のインスタンス数 (shader/vertex_shader_instancing.hlsl の INSTANCE_NUM と合わせる)
+        static constexpr auto batch_num = 256;
+
+        // コンストラクタ
+        instanced();
+        instanced(const instanced&) = default; // コピー
+        instanced(instanced&&) = default; // ムーブ
+
+         // デストラクタ
+        virtual ~instanced() = default;
+
+        // source の頂点・インデックス・テクスチャを共有する (source は create 済みにしておく)
+        bool set_mesh(const primitive_base& source);
+        bool create() override;
+
+        void process() override;
+        bool render() override;
+
+        // 追加したインスタンスの番号を返す
+        std::size_t add_instance(const math::matrix44f& world, const tagCOLOR_F& color);
+        void set_instance(const std::size_t index, const math::matrix44f& world, const tagCOLOR_F& color);
+        void clear_instance() { instance_list.clear(); visible_list.clear(); }
+
+        std::size_t get_instance_num() const { return instance_list.size(); }
+        // 直前の process で視錐台の中に残った数
+        std::size_t get_visible_num() const { return visible_list.size(); }
+
+        // インスタンス毎に視錐台カリングするカメラ(設定しない場合は全て描画する)
+        void set_camera(const std::shared_ptr<world::camera_base>& camera) { this->camera = camera; }
+
+    private:
+        // シェーダーの INSTANCE と同じ並び (world は行列の列 0 ～ 2、色はディフューズに乗算する)
+        struct instance_data {
+            std::array<std::array<float, 4>, 3> world;
+            std::array<float, 4> color;
+        };
+
+        // メッシュを batch_num 個まで並べた頂点・インデックスバッファ(コピーしたプリミティブと共有して、最後に解放する)
+        struct batch_buffer {
+            int vertex_buffer;
+            int index_buffer;
+            int instance_num;
+
+            ~batch_buffer();
+        };
+
+        void cull_instance();
+        bool render_shader();
+        void render_each();
+        void create_batch_buffer();
+
+        std::vector<instance_data> instance_list;
+        std::vector<instance_data> visible_list;
+        std::weak_ptr<world::camera_base> camera;
+
+        // メッシュのモデル座標の境界 (中心 / 軸平行境界箱の半分の大きさ / 球の半径)
+        math::vector4f mesh_center;
+        math::vector4f mesh_extent;
+        float mesh_radius;
+
+        std::shared_ptr<batch_buffer> batch;
+
+        // カリングの作業領域
+        math::basic_soa_buffer<float> cull_center;
+        math::basic_soa_buffer<float> cull_extent;
+        std::vector<float> cull_radius;
+        math::flag_buffer cull_visible;
+    };
+}
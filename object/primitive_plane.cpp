@@ -1,4 +1,7 @@
+#include <algorithm>
 #include <array>
+#include <cstdint>
+#include <utility>
 #include "DxLib.h"
 #include "primitive_plane.h"
 #include "vector4.h"
@@ -15,7 +18,36 @@ namespace {
     constexpr COLOR_U8 DEFAULT_SPECULAR = { 0, 0, 0, 0 };
     constexpr VECTOR DEFAULT_NORMAL = { 0.0f, 1.0f, 0.0f };
 
+    // 一辺 1 の正方形(コリジョン用の平面全体は中心を原点にする)
+    constexpr std::array<math::vector4, 4> unit_position_list = {
+        math::vector4(-0.5, 0.0, -0.5),
+        math::vector4(-0.5, 0.0,  0.5),
+        math::vector4( 0.5, 0.0, -0.5),
+        math::vector4( 0.5, 0.0,  0.5)
+    };
+    constexpr auto unit_normal = math::vector4(0.0, 1.0, 0.0);
 
+    // x と z のビットを交互に並べる (x が下位)
+    std::uint64_t encode_morton(const std::uint32_t x, const std::uint32_t z) {
+        std::uint64_t code = 0;
+
+        for (auto bit = 0; bit < 32; ++bit) {
+            code |= (static_cast<std::uint64_t>((x >> bit) & 1) << (bit * 2)) | (static_cast<std::uint64_t>((z >> bit) & 1) << (bit * 2 + 1));
+        }
+
+        return code;
+    }
+
+    // 偶数番目のビットを詰める(奇数番目は 1 つずらして渡す)
+    std::uint32_t decode_morton(const std::uint32_t code) {
+        std::uint32_t value = 0;
+
+        for (auto bit = 0; bit < 16; ++bit) {
+            value |= ((code >> (bit * 2)) & 1) << bit;
+        }
+
+        return value;
+    }
 }
 
 namespace primitive {
@@ -23,11 +55,15 @@ namespace primitive {
     plane::plane() : primitive_base() {
         size = DEFAULT_SIZE;
         division_num = DEFAULT_DIVISION_NUM;
+        mode = grid_mode::shared;
+        tiled_uv = true;
     }
 
     plane::plane(double size, int division_num) : primitive_base() {
         this->size = size;
         this->division_num = division_num;
+        mode = grid_mode::shared;
+        tiled_uv = true;
     }
 
     bool plane::initialize(double size, int division_num) {
@@ -38,13 +74,32 @@ namespace primitive {
     }
 
     bool plane::create() {
+        return create_grid(size, division_num);
+    }
+
+    bool plane::create_grid(const double size, const int division_num) {
+        const auto key = mesh_key("plane", size, division_num, static_cast<int>(mode) * 2 + (tiled_uv ? 1 : 0));
+
+        return create_shared(key, [&]() {
+            switch (mode) {
+            case grid_mode::unique:
+                return create_unique_grid(size, division_num);
+            case grid_mode::morton:
+                return create_morton_grid(size, division_num);
+            default:
+                return create_shared_grid(size, division_num);
+            }
+        });
+    }
+
+    bool plane::create_unique_grid(const double size, const int division_num) {
         auto division_num_d = static_cast<double>(division_num);
         auto polygon_size = size / division_num_d;
-        // ʑŜ̒S_ɂItZbg
+        // 平面全体の中心を原点にするオフセット
         auto half_polygon_size = polygon_size * 0.5f;
         auto start_x = -half_polygon_size * division_num_d;
         auto start_z = -half_polygon_size * division_num_d;
-        // ʂ̊{̐`pe[u
+        // 平面の基本の正方形用テーブル
         VECTOR position_0 = { 0.0f, 0.0f, 0.0f };
         VECTOR position_1 = { 0.0f, 0.0f, polygon_size };
         VECTOR position_2 = { polygon_size, 0.0f, 0.0f };
@@ -52,19 +107,22 @@ namespace primitive {
         std::array<VECTOR, 4> position_list = {
             position_0, position_1, position_2, position_3
         };
-        // uv ̃e[u
+        // uv のテーブル
         constexpr std::array<float, 4> u_list = { 0.0f, 0.0f, 1.0f, 1.0f };
         constexpr std::array<float, 4> v_list = { 0.0f, 1.0f, 0.0f, 1.0f };
 
         auto offset_x = start_x;
         auto offset_z = start_z;
-        unsigned short offset_index = 0;
+        index_type offset_index = 0;
+
+        vertex->reserve(vertex->size() + division_num * division_num * 4);
+        index->reserve(index->size() + division_num * division_num * 6);
 
         for (auto z = 0; z < division_num; ++z) {
             offset_x = start_x;
 
             for (auto x = 0; x < division_num; ++x) {
-                // ``
+                // 正方形を形成する
                 for (auto i = 0; i < 4; ++i) {
                     VERTEX3D vertex;
 
@@ -102,19 +160,147 @@ namespace primitive {
         return true;
     }
 
+    // 頂点は z 方向の行毎に x 方向へ並べる(行単位で 16bit インデックスのチャンクに分けられる)
+    // tiled_uv の uv は格子の番号なので、テクスチャを繰り返して貼る
+    bool plane::create_shared_grid(const double size, const int division_num) {
+        const auto line_num = division_num + 1;
+        const auto polygon_size = static_cast<float>(size / division_num);
+        const auto start = static_cast<float>(-size * 0.5);
+        const auto uv_scale = tiled_uv ? 1.0f : 1.0f / static_cast<float>(division_num);
+        const auto offset_index = static_cast<index_type>(vertex->size());
+
+        vertex->reserve(vertex->size() + line_num * line_num);
+        index->reserve(index->size() + division_num * division_num * 6);
+
+        for (auto z = 0; z < line_num; ++z) {
+            for (auto x = 0; x < line_num; ++x) {
+                VERTEX3D v;
+
+                v.pos = VGet(start + polygon_size * x, 0.0f, start + polygon_size * z);
+                v.norm = DEFAULT_NORMAL;
+                v.dif = DEFAULT_DIFFUSE;
+                v.spc = DEFAULT_SPECULAR;
+                v.u = static_cast<float>(x) * uv_scale;
+                v.v = static_cast<float>(z) * uv_scale;
+
+                vertex->emplace_back(std::move(v));
+            }
+        }
+
+        for (auto z = 0; z < division_num; ++z) {
+            for (auto x = 0; x < division_num; ++x) {
+                const auto index_0 = offset_index + static_cast<index_type>(z * line_num + x);
+                const auto index_1 = index_0 + line_num;
+                const auto index_2 = index_0 + 1;
+                const auto index_3 = index_1 + 1;
+
+                index->insert(index->end(), { index_0, index_1, index_2, index_2, index_1, index_3 });
+            }
+        }
+
+        return true;
+    }
+
+    // 頂点は shared と同じ位置と uv で、並びだけを Morton 順にする
+    // 近い格子の頂点がバッファ上でも近くなるので、頂点キャッシュに乗りやすい
+    bool plane::create_morton_grid(const double size, const int division_num) {
+        if (division_num < 1 || (division_num & (division_num - 1)) != 0) {
+            return false;
+        }
+
+        const auto line_num = division_num + 1;
+        const auto polygon_size = static_cast<float>(size / division_num);
+        const auto start = static_cast<float>(-size * 0.5);
+        const auto uv_scale = tiled_uv ? 1.0f : 1.0f / static_cast<float>(division_num);
+        const auto offset_index = static_cast<index_type>(vertex->size());
+        const auto table = create_morton_table(division_num);
+
+        vertex->resize(vertex->size() + line_num * line_num);
+        index->reserve(index->size() + division_num * division_num * 6);
+
+        for (auto z = 0; z < line_num; ++z) {
+            for (auto x = 0; x < line_num; ++x) {
+                auto& v = (*vertex)[offset_index + table[z * line_num + x]];
+
+                v.pos = VGet(start + polygon_size * x, 0.0f, start + polygon_size * z);
+                v.norm = DEFAULT_NORMAL;
+                v.dif = DEFAULT_DIFFUSE;
+                v.spc = DEFAULT_SPECULAR;
+                v.u = static_cast<float>(x) * uv_scale;
+                v.v = static_cast<float>(z) * uv_scale;
+            }
+        }
+
+        add_morton_cell(division_num, 1, [&](const int x, const int z) { return offset_index + table[z * line_num + x]; }, *index);
+
+        return true;
+    }
+
+    // (division_num + 1)^2 の点は 2 のべき乗の格子からはみ出すので、Morton 符号で並べ替えて詰める
+    std::vector<index_type> plane::create_morton_table(const int division_num) {
+        const auto line_num = division_num + 1;
+        std::vector<std::pair<std::uint64_t, int>> code_list;
+        std::vector<index_type> table(line_num * line_num);
+
+        code_list.reserve(table.size());
+
+        for (auto z = 0; z < line_num; ++z) {
+            for (auto x = 0; x < line_num; ++x) {
+                code_list.emplace_back(encode_morton(x, z), z * line_num + x);
+            }
+        }
+
+        std::sort(code_list.begin(), code_list.end());
+
+        for (std::size_t i = 0; i < code_list.size(); ++i) {
+            table[code_list[i].second] = static_cast<index_type>(i);
+        }
+
+        return table;
+    }
+
+    // 三角形の分け方は create_shared_grid と同じ
+    void plane::add_morton_cell(const int division_num, const int step, const std::function<index_type(int, int)>& get_index, std::vector<index_type>& index) {
+        const auto cell_line_num = static_cast<std::uint32_t>(division_num / step);
+
+        for (std::uint32_t i = 0; i < cell_line_num * cell_line_num; ++i) {
+            const auto x = static_cast<int>(decode_morton(i)) * step;
+            const auto z = static_cast<int>(decode_morton(i >> 1)) * step;
+            const auto index_0 = get_index(x, z);
+            const auto index_1 = get_index(x, z + step);
+            const auto index_2 = get_index(x + step, z);
+            const auto index_3 = get_index(x + step, z + step);
+
+            if (index_0 != index_1 && index_1 != index_2 && index_2 != index_0) {
+                index.insert(index.end(), { index_0, index_1, index_2 });
+            }
+
+            if (index_2 != index_1 && index_1 != index_3 && index_3 != index_2) {
+                index.insert(index.end(), { index_2, index_1, index_3 });
+            }
+        }
+    }
+
+    // 格子毎に繰り返す uv は 0 ～ division_num になるので、描画中だけテクスチャを繰り返す
+    bool plane::get_texture_wrap() const {
+        return (mode != grid_mode::unique && tiled_uv && division_num > 1);
+    }
+
     const face plane::get_info() const {
-        auto half_size = size * 0.5;
-        auto base_position_00 = math::vector4(-half_size, 0.0, -half_size);
-        auto base_position_01 = math::vector4(-half_size, 0.0,  half_size);
-        auto base_position_02 = math::vector4( half_size, 0.0, -half_size);
-        auto base_position_03 = math::vector4( half_size, 0.0,  half_size);
-        auto base_normal = math::vector4(0.0, 1.0, 0.0);
+        auto base_position_00 = unit_position_list[0] * size;
+        auto base_position_01 = unit_position_list[1] * size;
+        auto base_position_02 = unit_position_list[2] * size;
+        auto base_position_03 = unit_position_list[3] * size;
+        const auto& base_normal = unit_normal;
 #if defined(_AMG_MATH)
-        auto position_00 = base_position_00 * posture_matrix;
-        auto position_01 = base_position_01 * posture_matrix;
-        auto position_02 = base_position_02 * posture_matrix;
-        auto position_03 = base_position_03 * posture_matrix;
-        auto normal = base_normal * rotate_matrix;
+        // コリジョンは double 版で処理する
+        const auto posture_math = math::matrix44(posture_matrix);
+        auto position_00 = base_position_00 * posture_math;
+        auto position_01 = base_position_01 * posture_math;
+        auto position_02 = base_position_02 * posture_math;
+        auto position_03 = base_position_03 * posture_math;
+        const auto rotate_math = math::matrix44(rotate_matrix);
+        auto normal = base_normal * rotate_math;
 #else
         MATRIX posture_dx = posture_matrix;
         auto posture_math = ToMath(posture_dx);
@@ -6,22 +6,49 @@ namespace primitive {
 
     class plane : public primitive_base {
     public:
-        // RXgN^
+        // 格子の頂点の持ち方
+        enum class grid_mode {
+            unique, // 格子毎に 4 頂点
+            shared, // 隣の格子と頂点を共有する((division_num + 1)^2 頂点)
+            morton  // shared の頂点と格子を Morton 順 (Z 字の順) に並べる(division_num は 2 のべき乗)
+        };
+
+        // コンストラクタ
         plane();
         plane(double size, int division_num);
-        plane(const plane&) = default; // Rs[
-        plane(plane&&) = default; // [u
+        plane(const plane&) = default; // コピー
+        plane(plane&&) = default; // ムーブ
 
-         // fXgN^
+         // デストラクタ
         virtual ~plane() = default;
 
         bool initialize(double size, int division_num);
         bool create() override;
 
+        // tiled_uv は格子毎にテクスチャを貼る(false なら平面全体に 1 枚)
+        void set_grid(const grid_mode mode, const bool tiled_uv) { this->mode = mode; this->tiled_uv = tiled_uv; }
+        grid_mode get_grid_mode() const { return mode; }
+        bool get_tiled_uv() const { return tiled_uv; }
+
         const face get_info() const;
 
     protected:
+        bool get_texture_wrap() const override;
+
+        // 一辺 size を division_num 分割した格子 (mode / tiled_uv で作り、同じ形のメッシュは共有する)
+        bool create_grid(const double size, const int division_num);
+        bool create_unique_grid(const double size, const int division_num);
+        bool create_shared_grid(const double size, const int division_num);
+        bool create_morton_grid(const double size, const int division_num);
+
+        // 格子の点 (x, z) (0 ～ division_num) の Morton 順の頂点番号 (z * (division_num + 1) + x 番目)
+        static std::vector<index_type> create_morton_table(const int division_num);
+        // step x step の格子を Morton 順に 2 つの三角形で追加する(get_index で潰れた三角形は追加しない)
+        static void add_morton_cell(const int division_num, const int step, const std::function<index_type(int, int)>& get_index, std::vector<index_type>& index);
+
         double size;
         int division_num;
+        grid_mode mode;
+        bool tiled_uv;
     };
 }
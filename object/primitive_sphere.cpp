@@ -1,15 +1,16 @@
-#include <array>
+#include <cmath>
+#include <tuple>
+#include <vector>
 #include "DxLib.h"
 #include "primitive_sphere.h"
 
 namespace {
     constexpr auto DEFAULT_RADIUS = 10.0;
     constexpr auto DEFAULT_DIVISION_NUM = 16;
-    constexpr auto DEGREE_TO_RADIAN = DX_PI_F / 180.0f;
     constexpr COLOR_U8 DEFAULT_DIFFUSE = { 255, 255, 255, 255 };
     constexpr COLOR_U8 DEFAULT_SPECULAR = { 0, 0, 0, 0 };
-    constexpr float PI2_ANGLE = 360.0f;
-    constexpr float PI_ANGLE = 180.0f;
+    constexpr auto PI2_RADIAN = DX_PI * 2.0;
+    constexpr auto PI_RADIAN = DX_PI;
 }
 
 namespace primitive {
@@ -32,61 +33,76 @@ namespace primitive {
     }
 
     bool sphere::create() {
-        VECTOR start = VGet(0.0f, -radius, 0.0f);
-        int division_half_num = division_num / 2;
-        unsigned short offset_index = 0;
-        float unit_angle_x = PI_ANGLE / static_cast<float>(division_half_num);
-        float unit_angle_y = PI2_ANGLE / static_cast<float>(division_num);
-        float angle_x = 0.0f;
-        float angle_y = 0.0f;
-        float angle_next_x = unit_angle_x;
-        float angle_next_y = unit_angle_y;
-
-        for (auto height = 0; height < division_half_num; ++height) {
-            const std::array<float, 4> angle_x_list = { angle_x, angle_next_x, angle_x, angle_next_x };
-
-            angle_y = 0.0f;
-            angle_next_y = unit_angle_y;
-
-            for (auto width = 0; width < division_num; ++width) {
-                const std::array<float, 4> angle_y_list = { angle_y, angle_y, angle_next_y, angle_next_y };
-
-                for (auto i = 0; i < 4; ++i) {
-                    const MATRIX rot_x = MGetRotX(angle_x_list[i] * DEGREE_TO_RADIAN);
-                    const MATRIX rot_y = MGetRotY(angle_y_list[i] * DEGREE_TO_RADIAN);
-                    const VECTOR pos = VTransform(start, MMult(rot_x, rot_y));
-
-                    VERTEX3D v;
-
-                    v.pos = pos;
-                    v.norm = VNorm(pos);
-                    v.dif = DEFAULT_DIFFUSE;
-                    v.spc = DEFAULT_SPECULAR;
-                    v.u = 1.0f - angle_y_list[i] / PI2_ANGLE;
-                    v.v = 1.0f - angle_x_list[i] / PI_ANGLE;
-
-                    vertex->emplace_back(std::move(v));
-                }
+        if (division_num / 2 < 1) {
+            return false;
+        }
+
+        return create_shared({ "sphere", radius, division_num, 0 }, [this]() { return create_mesh(); });
+    }
+
+    // 緯度 (行) と経度 (列) の sin / cos を先に求めて、格子状に頂点を共有する
+    // 経度 360 度の列は uv が違うので 0 度の列と同じ位置に重ねて持つ
+    // 極の行は頂点が 1 点に集まるので、面積の無い三角形は作らない
+    bool sphere::create_mesh() {
+        const auto division_half_num = division_num / 2;
+
+        const auto row_num = division_half_num + 1;
+        const auto column_num = division_num + 1;
+        const auto radius_f = static_cast<float>(radius);
+        const auto offset_index = static_cast<index_type>(vertex->size());
+        std::vector<std::tuple<float, float>> row_list;
+        std::vector<std::tuple<float, float>> column_list;
+
+        for (auto row = 0; row < row_num; ++row) {
+            const auto angle_x = PI_RADIAN * row / division_half_num;
+
+            row_list.emplace_back(static_cast<float>(std::sin(angle_x)), static_cast<float>(std::cos(angle_x)));
+        }
+
+        for (auto column = 0; column < column_num; ++column) {
+            const auto angle_y = PI2_RADIAN * column / division_num;
+
+            column_list.emplace_back(static_cast<float>(std::sin(angle_y)), static_cast<float>(std::cos(angle_y)));
+        }
+
+        vertex->reserve(vertex->size() + row_num * column_num);
+        index->reserve(index->size() + division_num * (division_half_num - 1) * 6);
+
+        for (auto row = 0; row < row_num; ++row) {
+            const auto [sin_x, cos_x] = row_list[row];
 
-                // std::initializer_list 
-                index->insert(index->end(), {
-                    static_cast<unsigned short>(offset_index),
-                    static_cast<unsigned short>(offset_index + 1),
-                    static_cast<unsigned short>(offset_index + 2),
-                    // 2ڂ̎Op`
-                    static_cast<unsigned short>(offset_index + 2),
-                    static_cast<unsigned short>(offset_index + 1),
-                    static_cast<unsigned short>(offset_index + 3)
-                });
-
-                offset_index += 4;
-
-                angle_y = angle_next_y;
-                angle_next_y += unit_angle_y;
+            for (auto column = 0; column < column_num; ++column) {
+                const auto [sin_y, cos_y] = column_list[column];
+                // (0, -radius, 0) を X 軸 -> Y 軸の順に回転した位置
+                const auto normal = VGet(-sin_x * sin_y, -cos_x, -sin_x * cos_y);
+                VERTEX3D v;
+
+                v.pos = VScale(normal, radius_f);
+                v.norm = normal;
+                v.dif = DEFAULT_DIFFUSE;
+                v.spc = DEFAULT_SPECULAR;
+                v.u = 1.0f - static_cast<float>(column) / static_cast<float>(division_num);
+                v.v = 1.0f - static_cast<float>(row) / static_cast<float>(division_half_num);
+
+                vertex->emplace_back(std::move(v));
             }
+        }
 
-            angle_x = angle_next_x;
-            angle_next_x += unit_angle_x;
+        for (auto row = 0; row < division_half_num; ++row) {
+            for (auto column = 0; column < division_num; ++column) {
+                const auto index_0 = offset_index + static_cast<index_type>(row * column_num + column);
+                const auto index_1 = index_0 + column_num;
+                const auto index_2 = index_0 + 1;
+                const auto index_3 = index_1 + 1;
+
+                if (row != 0) {
+                    index->insert(index->end(), { index_0, index_1, index_2 });
+                }
+
+                if (row != division_half_num - 1) {
+                    index->insert(index->end(), { index_2, index_1, index_3 });
+                }
+            }
         }
 
         return true;
@@ -6,13 +6,13 @@ namespace primitive {
 
     class sphere : public primitive_base{
     public:
-        // RXgN^
+        // コンストラクタ
         sphere();
         sphere(double radius, int division_num);
-        sphere(const sphere&) = default; // Rs[
-        sphere(sphere&&) = default; // [u
+        sphere(const sphere&) = default; // コピー
+        sphere(sphere&&) = default; // ムーブ
 
-         // fXgN^
+         // デストラクタ
         virtual ~sphere() = default;
 
         bool initialize(double radius, int division_num);
@@ -21,6 +21,8 @@ namespace primitive {
         double get_radius() const { return radius; }
 
     protected:
+        bool create_mesh();
+
         double radius;
         int division_num;
     };
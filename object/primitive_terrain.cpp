@@ -0,0 +1,344 @@
+#include <algorithm>
+#include <cmath>
+#include "DxLib.h"
+#include "primitive_terrain.h"
+#include "camera_base.h"
+#include "vector4.h"
+#include "dx_math_policy.h"
+
+namespace {
+    constexpr auto DEFAULT_SIZE = 100.0;
+    constexpr auto DEFAULT_DIVISION_NUM = 10;
+    constexpr auto DEFAULT_CHUNK_DIVISION_NUM = 16;
+    constexpr auto SQRT2 = 1.41421356f;
+    // 最も細かいレベルで描画する距離(区画の大きさの倍数)
+    constexpr auto LOD_DISTANCE_SCALE = 1.5;
+    // 粗い隣の区画の辺 (-x / +x / -z / +z)
+    constexpr auto EDGE_NUM = 16;
+    constexpr auto EDGE_LEFT = 1;
+    constexpr auto EDGE_RIGHT = 2;
+    constexpr auto EDGE_BACK = 4;
+    constexpr auto EDGE_FRONT = 8;
+    // 三角形の 2 辺の外積がこれ以下なら同じ直線上にあるとみなす(辺の長さとの比)
+    constexpr auto COLLINEAR_EPSILON = 1e-4f;
+}
+
+namespace primitive {
+
+    // 区画の頂点 (Morton 順) を共有し、レベル毎に 2^level 個おきの格子でインデックスを作る
+    // 粗い隣の区画に接する辺は、隣に無い奇数番目の頂点を 1 つ前の偶数番目の頂点へ寄せて隙間を無くす(潰れた三角形は作らない)
+    class terrain::patch : public primitive_base {
+    public:
+        bool create() override { return !index->empty(); }
+        bool get_texture_wrap() const override { return true; }
+
+        bool create(const std::shared_ptr<std::vector<VERTEX3D>>& source, const double chunk_size, const int division_num, const int level, const int edge) {
+            const auto line_num = division_num + 1;
+            const auto step = 1 << level;
+
+            return create_shared({ "terrain_patch", chunk_size, division_num, level * EDGE_NUM + edge }, [&]() {
+                const auto table = create_morton_table(division_num);
+                const auto is_odd = [step](const int value) { return (value / step) % 2 != 0; };
+
+                vertex = source;
+
+                add_morton_cell(division_num, step, [&](int x, int z) {
+                    if (((edge & EDGE_LEFT) != 0 && x == 0 && is_odd(z)) || ((edge & EDGE_RIGHT) != 0 && x == division_num && is_odd(z))) {
+                        z -= step;
+                    }
+
+                    if (((edge & EDGE_BACK) != 0 && z == 0 && is_odd(x)) || ((edge & EDGE_FRONT) != 0 && z == division_num && is_odd(x))) {
+                        x -= step;
+                    }
+
+                    return table[z * line_num + x];
+                }, *index);
+
+                // 2 辺を寄せる角の格子には面積が 0 の三角形が残るので取り除く
+                auto end = index->begin();
+
+                for (auto it = index->begin(); it != index->end(); it += 3) {
+                    const auto& a = (*vertex)[it[0]].pos;
+                    const auto& b = (*vertex)[it[1]].pos;
+                    const auto& c = (*vertex)[it[2]].pos;
+
+                    const auto ab = VSub(b, a);
+                    const auto ac = VSub(c, a);
+
+                    if (std::abs(ab.x * ac.z - ab.z * ac.x) > COLLINEAR_EPSILON * VSize(ab) * VSize(ac)) {
+                        end = std::copy(it, it + 3, end);
+                    }
+                }
+
+                index->erase(end, index->end());
+
+                return true;
+            });
+        }
+
+        void set_material(const int handle, const int lighting, const int transparent) {
+            this->handle = handle;
+            this->lighting = lighting;
+            this->transparent = transparent;
+        }
+    };
+
+    terrain::terrain() : plane(DEFAULT_SIZE, DEFAULT_DIVISION_NUM) {
+        chunk_division_num = DEFAULT_CHUNK_DIVISION_NUM;
+        chunk_line_num = 0;
+        max_level = 0;
+        chunk_size = 0.0;
+        draw_distance = 0.0;
+        lod_distance = 0.0;
+        polygon_num = 0;
+    }
+
+    terrain::terrain(double size, int division_num, int chunk_division_num) : plane(size, division_num) {
+        this->chunk_division_num = chunk_division_num;
+        chunk_line_num = 0;
+        max_level = 0;
+        chunk_size = 0.0;
+        draw_distance = 0.0;
+        lod_distance = 0.0;
+        polygon_num = 0;
+    }
+
+    bool terrain::initialize(double size, int division_num, int chunk_division_num) {
+        this->size = size;
+        this->division_num = division_num;
+        this->chunk_division_num = chunk_division_num;
+
+        return true;
+    }
+
+    // 区画は格子毎に uv が 0 ～ chunk_division_num になるので、隣の区画とテクスチャの継ぎ目が合う
+    bool terrain::create() {
+        if (division_num < 1) {
+            return false;
+        }
+
+        chunk_division_num = std::clamp(chunk_division_num, 1, division_num);
+        max_level = 0;
+
+        if ((chunk_division_num & (chunk_division_num - 1)) == 0) {
+            mode = grid_mode::morton;
+
+            while ((1 << max_level) < chunk_division_num) {
+                ++max_level;
+            }
+        }
+        else {
+            mode = grid_mode::shared;
+        }
+
+        tiled_uv = true;
+        chunk_line_num = (division_num + chunk_division_num - 1) / chunk_division_num;
+
+        const auto polygon_size = size / division_num;
+
+        chunk_size = polygon_size * chunk_division_num;
+        division_num = chunk_line_num * chunk_division_num;
+        size = chunk_size * chunk_line_num;
+
+        const auto start = static_cast<float>((chunk_size - size) * 0.5);
+
+        chunk_offset.clear();
+        chunk_offset.reserve(chunk_line_num * chunk_line_num);
+
+        for (auto z = 0; z < chunk_line_num; ++z) {
+            for (auto x = 0; x < chunk_line_num; ++x) {
+                chunk_offset.emplace_back(start + static_cast<float>(chunk_size * x), 0.0f, start + static_cast<float>(chunk_size * z));
+            }
+        }
+
+        node_list.clear();
+        create_node(0, 0, chunk_line_num, chunk_line_num);
+        patch_list.assign((max_level + 1) * EDGE_NUM, nullptr);
+
+        return create_grid(chunk_size, chunk_division_num);
+    }
+
+    // 範囲を縦横に半分ずつ分ける(区画の数は 2 のべき乗でなくてもよい)
+    int terrain::create_node(const int x, const int z, const int width, const int height) {
+        const auto index = static_cast<int>(node_list.size());
+
+        node_list.emplace_back(quadtree_node{ x, z, width, height, { -1, -1, -1, -1 } });
+
+        if (width == 1 && height == 1) {
+            return index;
+        }
+
+        const auto half_width = (width + 1) / 2;
+        const auto half_height = (height + 1) / 2;
+        const std::array<std::array<int, 4>, 4> child_list = { {
+            { x, z, half_width, half_height },
+            { x + half_width, z, width - half_width, half_height },
+            { x, z + half_height, half_width, height - half_height },
+            { x + half_width, z + half_height, width - half_width, height - half_height }
+        } };
+
+        for (auto i = 0; i < 4; ++i) {
+            const auto [child_x, child_z, child_width, child_height] = child_list[i];
+
+            if (child_width > 0 && child_height > 0) {
+                const auto child = create_node(child_x, child_z, child_width, child_height);
+
+                node_list[index].child[i] = child;
+            }
+        }
+
+        return index;
+    }
+
+    // 境界は 1 区画分のメッシュではなく地面全体にする(world_base のカリング用)
+    void terrain::process() {
+        plane::process();
+
+        const auto half_size = static_cast<float>(size * 0.5);
+
+        set_local_bounds(math::vector4f(-half_size, 0.0f, -half_size), math::vector4f(half_size, 0.0f, half_size), half_size * SQRT2);
+
+        const auto camera = this->camera.lock();
+        const auto half_chunk_size = static_cast<float>(chunk_size * 0.5);
+
+        cull.world = backend::object_math::to_math(posture_matrix);
+        // 区画の y 方向の大きさは 0 なので x と z の行だけで広がる (Arvo の方法)
+        cull.chunk_extent = math::vector4f(half_chunk_size * (std::abs(cull.world.get_value(0, 0)) + std::abs(cull.world.get_value(2, 0))),
+                                           half_chunk_size * (std::abs(cull.world.get_value(0, 1)) + std::abs(cull.world.get_value(2, 1))),
+                                           half_chunk_size * (std::abs(cull.world.get_value(0, 2)) + std::abs(cull.world.get_value(2, 2))));
+        cull.use_camera = (camera != nullptr);
+        cull.frustum = cull.use_camera ? camera->get_frustum() : math::frustumf();
+        cull.camera_position = cull.use_camera ? backend::object_math::to_math(camera->get_position()) : math::vector4f();
+        cull.draw_distance = static_cast<float>(draw_distance);
+        cull.lod_distance = std::max(static_cast<float>((lod_distance > 0.0) ? lod_distance : chunk_size * LOD_DISTANCE_SCALE), cull.chunk_extent.length() * 2.0f);
+
+        visible_chunk.clear();
+
+        if (!node_list.empty()) {
+            cull_node(0);
+        }
+    }
+
+    // 節の範囲が視錐台か描画距離の外なら子の区画をまとめて省く
+    void terrain::cull_node(const int node_index) {
+        const auto& node = node_list[node_index];
+        const auto& first = chunk_offset[node.z * chunk_line_num + node.x];
+        const auto& last = chunk_offset[(node.z + node.height - 1) * chunk_line_num + node.x + node.width - 1];
+        const auto center = ((first + last) * 0.5f) * cull.world;
+        const auto half_width = static_cast<float>(chunk_size * node.width * 0.5);
+        const auto half_height = static_cast<float>(chunk_size * node.height * 0.5);
+        const auto extent = math::vector4f(half_width * std::abs(cull.world.get_value(0, 0)) + half_height * std::abs(cull.world.get_value(2, 0)),
+                                           half_width * std::abs(cull.world.get_value(0, 1)) + half_height * std::abs(cull.world.get_value(2, 1)),
+                                           half_width * std::abs(cull.world.get_value(0, 2)) + half_height * std::abs(cull.world.get_value(2, 2)));
+
+        if (!cull.frustum.intersect_aabb(center - extent, center + extent)) {
+            return;
+        }
+
+        if (cull.use_camera && cull.draw_distance > 0.0f) {
+            const auto dx = std::max(std::abs(cull.camera_position.get_x() - center.get_x()) - extent.get_x(), 0.0f);
+            const auto dy = std::max(std::abs(cull.camera_position.get_y() - center.get_y()) - extent.get_y(), 0.0f);
+            const auto dz = std::max(std::abs(cull.camera_position.get_z() - center.get_z()) - extent.get_z(), 0.0f);
+
+            if (dx * dx + dy * dy + dz * dz > cull.draw_distance * cull.draw_distance) {
+                return;
+            }
+        }
+
+        if (node.width == 1 && node.height == 1) {
+            visible_chunk.emplace_back(node.z * chunk_line_num + node.x);
+            return;
+        }
+
+        for (const auto child : node.child) {
+            if (child >= 0) {
+                cull_node(child);
+            }
+        }
+    }
+
+    // 区画の境界箱上でカメラに最も近い点までの距離
+    float terrain::get_chunk_distance(const int x, const int z) const {
+        const auto center = chunk_offset[z * chunk_line_num + x] * cull.world;
+        const auto dx = std::max(std::abs(cull.camera_position.get_x() - center.get_x()) - cull.chunk_extent.get_x(), 0.0f);
+        const auto dy = std::max(std::abs(cull.camera_position.get_y() - center.get_y()) - cull.chunk_extent.get_y(), 0.0f);
+        const auto dz = std::max(std::abs(cull.camera_position.get_z() - center.get_z()) - cull.chunk_extent.get_z(), 0.0f);
+
+        return std::sqrt(dx * dx + dy * dy + dz * dz);
+    }
+
+    // 隣の区画との距離の差は区画の対角線以下なので、lod_distance が対角線以上ならレベルの差は 1 以下になる
+    int terrain::get_chunk_level(const int x, const int z) const {
+        if (!cull.use_camera || max_level == 0) {
+            return 0;
+        }
+
+        const auto distance = get_chunk_distance(x, z);
+
+        if (distance < cull.lod_distance) {
+            return 0;
+        }
+
+        return std::min(static_cast<int>(std::floor(std::log2(distance / cull.lod_distance))) + 1, max_level);
+    }
+
+    // 姿勢の行列の平行移動に区画の中心を加えて、レベルと粗い隣の区画の辺に合ったメッシュを区画毎に描画する
+    bool terrain::render() {
+        polygon_num = 0;
+
+        if (invisible || visible_chunk.empty()) {
+            return false;
+        }
+
+        auto result = false;
+
+        for (const auto i : visible_chunk) {
+            const auto position = chunk_offset[i] * cull.world;
+            auto chunk_world = cull.world;
+
+            chunk_world.set_value(3, 0, position.get_x());
+            chunk_world.set_value(3, 1, position.get_y());
+            chunk_world.set_value(3, 2, position.get_z());
+
+            // Morton 順で作れない区画 (chunk_division_num が 2 のべき乗でない) は 1 区画分のメッシュをそのまま描画する
+            if (mode != grid_mode::morton) {
+                const auto posture = posture_matrix;
+
+                posture_matrix = backend::object_math::to_native(chunk_world);
+                result = primitive_base::render() || result;
+                polygon_num += index->size() / 3;
+                posture_matrix = posture;
+                continue;
+            }
+
+            const auto x = static_cast<int>(i) % chunk_line_num;
+            const auto z = static_cast<int>(i) / chunk_line_num;
+            const auto level = get_chunk_level(x, z);
+            auto edge = 0;
+
+            if (level < max_level) {
+                edge |= (x > 0 && get_chunk_level(x - 1, z) > level) ? EDGE_LEFT : 0;
+                edge |= (x + 1 < chunk_line_num && get_chunk_level(x + 1, z) > level) ? EDGE_RIGHT : 0;
+                edge |= (z > 0 && get_chunk_level(x, z - 1) > level) ? EDGE_BACK : 0;
+                edge |= (z + 1 < chunk_line_num && get_chunk_level(x, z + 1) > level) ? EDGE_FRONT : 0;
+            }
+
+            auto& chunk_patch = patch_list[level * EDGE_NUM + edge];
+
+            if (chunk_patch == nullptr) {
+                chunk_patch = std::make_shared<patch>();
+                chunk_patch->set_renderer(get_renderer());
+                chunk_patch->set_dynamic(get_dynamic());
+                chunk_patch->create(vertex, chunk_size, chunk_division_num, level, edge);
+            }
+
+            chunk_patch->set_material(handle, lighting, transparent);
+            chunk_patch->set_debug(is_debug);
+            chunk_patch->set_posture_matrix(backend::object_math::to_native(chunk_world));
+            result = chunk_patch->render() || result;
+            polygon_num += chunk_patch->get_index()->size() / 3;
+        }
+
+        return result;
+    }
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <array>
+#include <memory>
+#include <vector>
+#include "primitive_plane.h"
+#include "frustum.h"
+#include "matrix44.h"
+
+namespace world {
+    class camera_base;
+}
+
+namespace primitive {
+
+    // 格子を chunk_division_num x chunk_division_num の区画に分けた地面
+    // 区画の四分木で視錐台と描画距離の外にある区画をまとめて省き、見える区画だけを描画する
+    // 平らな区画は全て同じ形なので、1 区画分のメッシュ (GPU のバッファ) を位置をずらして使い回す
+    // chunk_division_num が 2 のべき乗なら区画の頂点を Morton 順に並べ、カメラからの距離で格子を粗くする (geomipmapping)
+    // コリジョンは plane と同じ (get_info は地面全体の平面)
+    class terrain : public plane {
+    public:
+        // コンストラクタ
+        terrain();
+        terrain(double size, int division_num, int chunk_division_num);
+        terrain(const terrain&) = default; // コピー
+        terrain(terrain&&) = default; // ムーブ
+
+         // デストラクタ
+        virtual ~terrain() = default;
+
+        // division_num が chunk_division_num で割り切れない場合は区画の数を切り上げる(格子の大きさは変えない)
+        bool initialize(double size, int division_num, int chunk_division_num);
+        bool create() override;
+
+        void process() override;
+        bool render() override;
+
+        // 区画を省くカメラ(設定しない場合は全ての区画を最も細かいレベルで描画する)
+        void set_camera(const std::shared_ptr<world::camera_base>& camera) { this->camera = camera; }
+        // カメラからこの距離より遠い区画は描画しない(フォグで見えなくなる距離、0 以下なら制限しない)
+        void set_draw_distance(const double distance) { draw_distance = distance; }
+        double get_draw_distance() const { return draw_distance; }
+        // この距離までは最も細かいレベルで描画し、距離が 2 倍になる毎にレベルを 1 つ上げる
+        // 隣の区画とレベルの差が 1 以下になるように、区画の対角線の長さより短くはしない (0 以下なら区画の大きさから決める)
+        void set_lod_distance(const double distance) { lod_distance = distance; }
+        double get_lod_distance() const { return lod_distance; }
+
+        int get_max_level() const { return max_level; }
+        std::size_t get_chunk_num() const { return chunk_offset.size(); }
+        // 直前の process で描画する区画の数と、render で描画した三角形の数
+        std::size_t get_visible_chunk_num() const { return visible_chunk.size(); }
+        std::size_t get_polygon_num() const { return polygon_num; }
+
+    protected:
+        // 区画の uv は格子毎に 0 ～ 1 を繰り返す
+        bool get_texture_wrap() const override { return true; }
+
+        // 区画の範囲 (x, z から width x height 区画) と子の節
+        struct quadtree_node {
+            int x;
+            int z;
+            int width;
+            int height;
+            std::array<int, 4> child;
+        };
+
+        int create_node(const int x, const int z, const int width, const int height);
+        void cull_node(const int node_index);
+        float get_chunk_distance(const int x, const int z) const;
+        int get_chunk_level(const int x, const int z) const;
+
+        int chunk_division_num;
+        int chunk_line_num;
+        int max_level;
+        double chunk_size;
+        double draw_distance;
+        double lod_distance;
+        std::weak_ptr<world::camera_base> camera;
+
+        // 区画の中心(モデル座標)
+        std::vector<math::vector4f> chunk_offset;
+        std::vector<quadtree_node> node_list;
+        std::vector<std::size_t> visible_chunk;
+        std::size_t polygon_num;
+
+    private:
+        // レベルと粗い隣の区画の辺毎のインデックスで描画するプリミティブ(定義は cpp)
+        class patch;
+
+        // process で求めて cull_node と render で使う値(ワールド座標)
+        struct cull_state {
+            math::frustumf frustum;
+            math::matrix44f world;
+            math::vector4f chunk_extent;
+            math::vector4f camera_position;
+            bool use_camera;
+            float draw_distance;
+            float lod_distance;
+        };
+
+        cull_state cull;
+        // レベル x 16 + 辺の組み合わせ毎に、使う時に作る
+        std::vector<std::shared_ptr<patch>> patch_list;
+    };
+}
@@ -0,0 +1,104 @@
+#include <algorithm>
+#include "recording_mesh_renderer.h"
+
+namespace primitive {
+
+    recording_mesh_renderer::command& recording_mesh_renderer::add_command(const command_type type) {
+        command_list.emplace_back(command{ type, 0, 0, { 0, 0 }, 0, 0, 0, math::matrix44f(), { math::vector4f(), math::vector4f() } });
+
+        return command_list.back();
+    }
+
+    int recording_mesh_renderer::create_buffer(std::span<const tagVERTEX3D> vertex, std::span<const unsigned short> index) {
+        const auto info = buffer_info{ true, vertex.size(), index.size() };
+        const auto it = std::find_if(buffer_list.begin(), buffer_list.end(), [](const auto& buffer) { return !buffer.used; });
+        auto buffer = static_cast<int>(buffer_list.size());
+
+        if (it != buffer_list.end()) {
+            *it = info;
+            buffer = static_cast<int>(it - buffer_list.begin());
+        }
+        else {
+            buffer_list.emplace_back(info);
+        }
+
+        auto& record = add_command(command_type::create_buffer);
+
+        record.buffer = buffer;
+        record.vertex_num = info.vertex_num;
+        record.index_num = info.index_num;
+
+        return buffer;
+    }
+
+    void recording_mesh_renderer::delete_buffer(const int buffer) {
+        if (buffer < 0 || buffer >= static_cast<int>(buffer_list.size()) || !buffer_list[buffer].used) {
+            return;
+        }
+
+        buffer_list[buffer].used = false;
+        add_command(command_type::delete_buffer).buffer = buffer;
+    }
+
+    bool recording_mesh_renderer::draw_buffer(const int buffer, const int handle, const int transparent) {
+        if (buffer < 0 || buffer >= static_cast<int>(buffer_list.size()) || !buffer_list[buffer].used) {
+            return false;
+        }
+
+        const auto& info = buffer_list[buffer];
+        auto& record = add_command(command_type::draw_buffer);
+
+        record.buffer = buffer;
+        record.handle = handle;
+        record.value[0] = transparent;
+        record.vertex_num = info.vertex_num;
+        record.index_num = info.index_num;
+        polygon_num += info.index_num / 3;
+
+        return true;
+    }
+
+    bool recording_mesh_renderer::draw_stream(std::span<const tagVERTEX3D> vertex, std::span<const unsigned short> index, const int handle, const int transparent) {
+        auto& record = add_command(command_type::draw_stream);
+
+        record.buffer = -1;
+        record.handle = handle;
+        record.value[0] = transparent;
+        record.vertex_num = vertex.size();
+        record.index_num = index.size();
+        polygon_num += index.size() / 3;
+
+        return true;
+    }
+
+    void recording_mesh_renderer::set_transform(const math::matrix44f& world) {
+        add_command(command_type::set_transform).transform = world;
+    }
+
+    void recording_mesh_renderer::set_lighting(const int lighting) {
+        add_command(command_type::set_lighting).value[0] = lighting;
+    }
+
+    void recording_mesh_renderer::set_z_buffer(const bool use, const bool write) {
+        auto& record = add_command(command_type::set_z_buffer);
+
+        record.value[0] = use ? 1 : 0;
+        record.value[1] = write ? 1 : 0;
+    }
+
+    void recording_mesh_renderer::set_texture_wrap(const bool wrap) {
+        add_command(command_type::set_texture_wrap).value[0] = wrap ? 1 : 0;
+    }
+
+    void recording_mesh_renderer::draw_line(const math::vector4f& start, const math::vector4f& end, const unsigned int color) {
+        auto& record = add_command(command_type::draw_line);
+
+        record.color = color;
+        record.line[0] = start;
+        record.line[1] = end;
+    }
+
+    std::size_t recording_mesh_renderer::get_buffer_num() const {
+        return static_cast<std::size_t>(std::count_if(buffer_list.begin(), buffer_list.end(), [](const auto& buffer) { return buffer.used; }));
+    }
+}
@@ -0,0 +1,83 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+#include "mesh_renderer.h"
+#include "vector4.h"
+#include "matrix44.h"
+
+namespace primitive {
+
+    // 描画せずに呼び出しを記録する (DX ライブラリを使わない)
+    // set_default_renderer で差し替えると、ウィンドウを作らずに描画の順番や状態、三角形の数を確かめられる
+    class recording_mesh_renderer : public mesh_renderer {
+    public:
+        enum class command_type {
+            create_buffer,
+            delete_buffer,
+            draw_buffer,
+            draw_stream,
+            set_transform,
+            set_lighting,
+            set_z_buffer,
+            set_texture_wrap,
+            draw_line,
+        };
+
+        // 種類毎に使う値だけを入れる(他は 0)
+        // value は transparent / lighting / z_buffer の use と write / wrap
+        struct command {
+            command_type type;
+            int buffer;
+            int handle;
+            int value[2];
+            std::size_t vertex_num;
+            std::size_t index_num;
+            unsigned int color;
+            math::matrix44f transform;
+            math::vector4f line[2];
+        };
+
+        // コンストラクタ
+        recording_mesh_renderer() = default;
+        recording_mesh_renderer(const recording_mesh_renderer&) = delete;
+
+        // デストラクタ
+        virtual ~recording_mesh_renderer() = default;
+
+        int create_buffer(std::span<const tagVERTEX3D> vertex, std::span<const unsigned short> index) override;
+        void delete_buffer(const int buffer) override;
+        bool draw_buffer(const int buffer, const int handle, const int transparent) override;
+
+        bool draw_stream(std::span<const tagVERTEX3D> vertex, std::span<const unsigned short> index, const int handle, const int transparent) override;
+
+        void set_transform(const math::matrix44f& world) override;
+        void set_lighting(const int lighting) override;
+        void set_z_buffer(const bool use, const bool write) override;
+        void set_texture_wrap(const bool wrap) override;
+
+        void draw_line(const math::vector4f& start, const math::vector4f& end, const unsigned int color) override;
+
+        const std::vector<command>& get_command_list() const { return command_list; }
+        // 記録を消す(作ったバッファは残る)
+        void clear() { command_list.clear(); polygon_num = 0; }
+
+        // 削除されていないバッファの数
+        std::size_t get_buffer_num() const;
+        // clear してから draw_buffer / draw_stream で描画した三角形の数
+        std::size_t get_polygon_num() const { return polygon_num; }
+
+    private:
+        // 削除した番号は used を false にして再利用する
+        struct buffer_info {
+            bool used;
+            std::size_t vertex_num;
+            std::size_t index_num;
+        };
+
+        command& add_command(const command_type type);
+
+        std::vector<command> command_list;
+        std::vector<buffer_info> buffer_list;
+        std::size_t polygon_num = 0;
+    };
+}
@@ -3,6 +3,7 @@
 #include "model_base.h"
 #include "primitive_base.h"
 #include "camera_base.h"
+#include "frustum.h"
 
 namespace world {
 
@@ -10,6 +11,7 @@ namespace world {
         camera_index = -1;
         pre_render = nullptr;
         post_render = nullptr;
+        culling = true;
     }
 
     int world_base::add_camera(const std::shared_ptr<camera_base>& camera) {
@@ -42,15 +44,76 @@ namespace world {
         }
     }
 
+    template <typename T>
+    void world_base::cull(const std::vector<std::shared_ptr<T>>& list, cull_work& work) const {
+        work.draw.assign(list.size(), true);
+        work.culled_num = 0;
+
+        if (!culling || camera_index < 0 || camera_index >= camera_list.size()) {
+            return;
+        }
+
+        work.index.clear();
+
+        for (std::size_t i = 0; i < list.size(); ++i) {
+            if (list[i]->has_bounds()) {
+                work.index.emplace_back(i);
+            }
+        }
+
+        const auto count = work.index.size();
+
+        work.center.resize(count);
+        work.extent.resize(count);
+        work.radius.resize(count);
+        work.visible.resize(count);
+
+        auto center = work.center.span();
+        auto extent = work.extent.span();
+
+        for (std::size_t i = 0; i < count; ++i) {
+            const auto& object = list[work.index[i]];
+            const auto& c = object->get_bounds_center();
+            const auto& e = object->get_bounds_extent();
+
+            center.x[i] = c.get_x();
+            center.y[i] = c.get_y();
+            center.z[i] = c.get_z();
+            extent.x[i] = e.get_x();
+            extent.y[i] = e.get_y();
+            extent.z[i] = e.get_z();
+            work.radius[i] = object->get_bounds_radius();
+        }
+
+        const auto visible = work.visible.span();
+
+        math::batch::cull(camera_list[camera_index]->get_frustum(), center, extent, work.radius, visible);
+
+        for (std::size_t i = 0; i < count; ++i) {
+            if (!visible[i]) {
+                work.draw[work.index[i]] = false;
+                ++work.culled_num;
+            }
+        }
+    }
+
     void world_base::render_primitive() const {
-        for (auto primitive : primitive_list) {
-            primitive->render();
+        cull(primitive_list, primitive_cull);
+
+        for (std::size_t i = 0; i < primitive_list.size(); ++i) {
+            if (primitive_cull.draw[i]) {
+                primitive_list[i]->render();
+            }
         }
     }
 
     void world_base::render_model() const {
-        for (auto model : model_list) {
-            model->render();
+        cull(model_list, model_cull);
+
+        for (std::size_t i = 0; i < model_list.size(); ++i) {
+            if (model_cull.draw[i]) {
+                model_list[i]->render();
+            }
         }
     }
 
@@ -2,6 +2,7 @@
 #include <vector>
 #include <memory>
 #include <functional>
+#include "batch.h"
 
 namespace mv1 {
     class model_base;
@@ -16,12 +17,12 @@ namespace world {
 
     class world_base {
     public:
-        // RXgN^
+        // コンストラクタ
         world_base();
-        world_base(const world_base&) = default; // Rs[
-        world_base(world_base&&) = default; // [u
+        world_base(const world_base&) = default; // コピー
+        world_base(world_base&&) = default; // ムーブ
 
-         // fXgN^
+         // デストラクタ
         virtual ~world_base() = default;
 
         virtual void process();
@@ -43,7 +44,28 @@ namespace world {
         void set_pre_render(const std::function<void(void)>& render) {  pre_render = render; }
         void set_post_render(const std::function<void(void)>& render) { post_render = render; }
 
+        // 現在のカメラの視錐台の外にあるオブジェクトを描画しない(境界が無いものは常に描画する)
+        void set_culling(const bool culling) { this->culling = culling; }
+        bool get_culling() const { return culling; }
+        // 直前の render で描画しなかった数 / 登録されている数
+        std::size_t get_culled_num() const { return primitive_cull.culled_num + model_cull.culled_num; }
+        std::size_t get_object_num() const { return primitive_list.size() + model_list.size(); }
+
     protected:
+        // 視錐台カリングの作業領域 (境界を持つオブジェクトだけ詰めて batch::cull へ渡す)
+        struct cull_work {
+            math::basic_soa_buffer<float> center;
+            math::basic_soa_buffer<float> extent;
+            std::vector<float> radius;
+            std::vector<std::size_t> index; // 詰めた境界のリスト上の位置
+            math::flag_buffer visible;
+            std::vector<bool> draw; // リスト毎の描画するか
+            std::size_t culled_num = 0;
+        };
+
+        template <typename T>
+        void cull(const std::vector<std::shared_ptr<T>>& list, cull_work& work) const;
+
         std::vector<std::shared_ptr<mv1::model_base>> model_list;
         std::vector<std::shared_ptr<primitive::primitive_base>> primitive_list;
 
@@ -52,6 +74,10 @@ namespace world {
 
         std::function<void(void)> pre_render;
         std::function<void(void)> post_render;
+
+        bool culling;
+        mutable cull_work primitive_cull;
+        mutable cull_work model_cull;
     };
 
 }
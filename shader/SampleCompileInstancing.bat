@@ -0,0 +1,3 @@
+ShaderCompiler.exe /Tvs_4_0 vertex_shader_instancing.hlsl
+ShaderCompiler.exe /Tps_4_0 pixel_shader_instancing.hlsl
+pause
\ No newline at end of file
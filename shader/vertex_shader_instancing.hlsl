@@ -0,0 +1,174 @@
+// 頂点シェーダーの入力
+// primitive::instanced がメッシュをインスタンス数分並べた VERTEX3DSHADER のバッファ
+struct VS_INPUT {
+	float3 pos        : POSITION0; // 座標(ローカル空間)
+	float4 spos       : POSITION1; // x にバッファ内のインスタンス番号
+	float3 norm       : NORMAL0;   // 法線(ローカル空間)
+	float3 tan        : TANGENT0;  // 接線(使わない)
+	float3 binorm     : BINORMAL0; // 従法線(使わない)
+	float4 diff       : COLOR0;    // ディフューズカラー
+	float4 spe        : COLOR1;    // スペキュラカラー
+	float2 texCoords0 : TEXCOORD0; // テクスチャ座標
+	float2 texCoords1 : TEXCOORD1; // サブテクスチャ座標
+};
+
+// 頂点シェーダーの出力
+struct VS_OUTPUT {
+	float4 diff       : COLOR0;
+	float2 texCoords0 : TEXCOORD0;   // テクスチャ座標
+	float  fog        : TEXCOORD1;   // フォグの割合( 1.0f:フォグ無し  0.0f:フォグの色 )
+	float4 pos        : SV_POSITION;
+};
+
+// ===================================================================================================================
+// DX ライブラリが用意している Constant Buffer
+// ===================================================================================================================
+struct DX_D3D11_CONST_MATERIAL {
+	float4 Diffuse;          // ディフューズカラー
+	float4 Specular;         // スペキュラカラー
+	float4 Ambient_Emissive; // マテリアルエミッシブカラー + マテリアルアンビエントカラー * グローバルアンビエントカラー
+
+	float Power;             // スペキュラの強さ
+	float TypeParam0;        // マテリアルタイプパラメータ0
+	float TypeParam1;        // マテリアルタイプパラメータ1
+	float TypeParam2;        // マテリアルタイプパラメータ2
+};
+
+struct DX_D3D11_VS_CONST_FOG {
+	float LinearAdd; // フォグ用パラメータ end / ( end - start )
+	float LinearDiv; // フォグ用パラメータ -1  / ( end - start )
+	float Density;   // フォグ用パラメータ density
+	float E;         // フォグ用パラメータ 自然対数の低
+
+	float4 Color;    // カラー
+};
+
+struct DX_D3D11_CONST_LIGHT {
+	int    Type;        // ライトタイプ( DX_LIGHTTYPE_POINT など )
+	int3   Padding1;    // パディング１
+
+	float3 Position;    // 座標( ビュー空間 )
+	float  RangePow2;   // 有効距離の２乗
+
+	float3 Direction;   // 方向( ビュー空間 )
+	float  FallOff;     // スポットライト用FallOff
+
+	float3 Diffuse;     // ディフューズカラー
+	float  SpotParam0;  // スポットライト用パラメータ０( cos( Phi / 2.0f ) )
+
+	float3 Specular;    // スペキュラカラー
+	float  SpotParam1;  // スポットライト用パラメータ１( 1.0f / ( cos( Theta / 2.0f ) - cos( Phi / 2.0f ) ) )
+
+	float4 Ambient;     // アンビエントカラーとマテリアルのアンビエントカラーを乗算したもの
+
+	float Attenuation0; // 距離による減衰処理用パラメータ０
+	float Attenuation1; // 距離による減衰処理用パラメータ１
+	float Attenuation2; // 距離による減衰処理用パラメータ２
+	float Padding2;     // パディング２
+};
+
+struct DX_D3D11_CONST_BUFFER_COMMON {
+	DX_D3D11_CONST_LIGHT    Light[6]; // ライトパラメータ
+	DX_D3D11_CONST_MATERIAL Material; // マテリアルパラメータ
+	DX_D3D11_VS_CONST_FOG   Fog;      // フォグパラメータ
+};
+
+// 基本パラメータ
+struct DX_D3D11_VS_CONST_BUFFER_BASE {
+	float4 AntiViewportMatrix[4]; // アンチビューポート行列
+	float4 ProjectionMatrix[4];   // ビュー　→　プロジェクション行列
+	float4 ViewMatrix[3];         // ワールド　→　ビュー行列
+	float4 LocalWorldMatrix[3];   // ローカル　→　ワールド行列
+	float4 ToonOutLineSize;       // トゥーンの輪郭線の大きさ
+	float DiffuseSource;          // ディフューズカラー( 0.0f:マテリアル  1.0f:頂点 )
+	float SpecularSource;         // スペキュラカラー(   0.0f:マテリアル  1.0f:頂点 )
+	float MulSpecularColor;       // スペキュラカラー値に乗算する値( スペキュラ無効処理で使用 )
+	float Padding;
+};
+
+cbuffer cbD3D11_CONST_BUFFER_COMMON : register(b0) {
+	DX_D3D11_CONST_BUFFER_COMMON g_Common;
+};
+
+// 基本パラメータ
+cbuffer cbD3D11_CONST_BUFFER_VS_BASE : register(b1) {
+	DX_D3D11_VS_CONST_BUFFER_BASE g_Base;
+};
+// ===================================================================================================================
+
+// 1 回の描画のインスタンス数 (primitive::instanced::batch_num と合わせる)
+#define INSTANCE_NUM 256
+
+// インスタンス毎のパラメータ
+struct INSTANCE {
+	float4 WorldMatrix[3]; // ローカル　→　ワールド行列(LocalWorldMatrix と同じ列の並び)
+	float4 Color;          // ディフューズカラーに乗算する色
+};
+
+// 全インスタンスで共通のパラメータ
+// x: ライティング( 0.0f:しない  1.0f:ライト 0 の平行光源とアンビエント )  y: 線形フォグ( 0.0f:しない  1.0f:する )
+cbuffer cbINSTANCE_CBUFFER : register(b4) {
+	float4   g_Param;
+	INSTANCE g_Instance[INSTANCE_NUM];
+};
+
+// main関数
+VS_OUTPUT main(VS_INPUT VSInput) {
+	int instance = (int)VSInput.spos.x;
+	float4 localPosition;
+
+	localPosition.xyz = VSInput.pos.xyz;
+	localPosition.w = 1.0f;
+
+	float4 worldPosition;
+
+	worldPosition.x = dot(localPosition, g_Instance[instance].WorldMatrix[0]);
+	worldPosition.y = dot(localPosition, g_Instance[instance].WorldMatrix[1]);
+	worldPosition.z = dot(localPosition, g_Instance[instance].WorldMatrix[2]);
+	worldPosition.w = 1.0f;
+
+	float4 viewPosition;
+
+	viewPosition.x = dot(worldPosition, g_Base.ViewMatrix[0]);
+	viewPosition.y = dot(worldPosition, g_Base.ViewMatrix[1]);
+	viewPosition.z = dot(worldPosition, g_Base.ViewMatrix[2]);
+	viewPosition.w = 1.0f;
+
+	VS_OUTPUT VSOutput;
+
+	VSOutput.pos.x = dot(viewPosition, g_Base.ProjectionMatrix[0]);
+	VSOutput.pos.y = dot(viewPosition, g_Base.ProjectionMatrix[1]);
+	VSOutput.pos.z = dot(viewPosition, g_Base.ProjectionMatrix[2]);
+	VSOutput.pos.w = dot(viewPosition, g_Base.ProjectionMatrix[3]);
+
+	VSOutput.texCoords0 = VSInput.texCoords0;
+
+	// ライティングは DX ライブラリの固定機能と同じく、ディフューズをマテリアルか頂点から取る(スペキュラは使わない)
+	float4 diffuse = lerp(g_Common.Material.Diffuse, VSInput.diff, g_Base.DiffuseSource);
+
+	if (g_Param.x > 0.0f) {
+		float4 localNormal = float4(VSInput.norm, 0.0f);
+		float4 worldNormal;
+
+		worldNormal.x = dot(localNormal, g_Instance[instance].WorldMatrix[0]);
+		worldNormal.y = dot(localNormal, g_Instance[instance].WorldMatrix[1]);
+		worldNormal.z = dot(localNormal, g_Instance[instance].WorldMatrix[2]);
+		worldNormal.w = 0.0f;
+
+		float3 viewNormal;
+
+		viewNormal.x = dot(worldNormal, g_Base.ViewMatrix[0]);
+		viewNormal.y = dot(worldNormal, g_Base.ViewMatrix[1]);
+		viewNormal.z = dot(worldNormal, g_Base.ViewMatrix[2]);
+		viewNormal = normalize(viewNormal);
+
+		float diffusePower = saturate(dot(viewNormal, -g_Common.Light[0].Direction));
+
+		diffuse.rgb = saturate(diffuse.rgb * g_Common.Light[0].Diffuse * diffusePower + g_Common.Light[0].Ambient.rgb + g_Common.Material.Ambient_Emissive.rgb);
+	}
+
+	VSOutput.diff = diffuse * g_Instance[instance].Color;
+	VSOutput.fog = (g_Param.y > 0.0f) ? saturate(g_Common.Fog.LinearAdd + viewPosition.z * g_Common.Fog.LinearDiv) : 1.0f;
+
+    return VSOutput;
+}
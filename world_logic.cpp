@@ -1,7 +1,7 @@
 //!
 //! @file world_logic.cpp
 //!
-//! @brief 3D main_world.cpp p 3D E(world_base class)̎
+//! @brief 3D main_world.cpp 用の 3D 世界(world_base class)の実装
 //!
 #include "DxLib.h"
 #include "utility.h"
@@ -14,12 +14,15 @@
 #include "gun.h"
 #include "missile.h"
 #include "primitive_plane.h"
+#include "primitive_terrain.h"
 #include "primitive_sphere.h"
+#include "primitive_icosphere.h"
 #include "primitive_cube.h"
 #include "dx_utility.h"
+#include "dx_math_policy.h"
 
 namespace {
-    // t@C
+    // ファイル
     constexpr auto MODEL_FILE = _T("model/character/SDChar.mv1");
     constexpr auto MODEL_GUN_FILE = _T("model/gun/Handgun_fbx_6.1_ASCII.mv1");
     constexpr auto MODEL_MISSILE_FILE = _T("model/Patriot-Missile-Poland.mv1");
@@ -29,22 +32,25 @@ namespace {
     constexpr auto TEXTURE_FILE_STEPS = _T("texture/kime-yoko.jpg");
     constexpr auto TEXTURE_FILE_TREE = _T("texture/tree.png");
 
-    // LN^[p[^[
+    // キャラクターパラメーター
     constexpr auto MODEL_MOVEMENT = 10.0;
     constexpr auto MODEL_COLLISION_SPHERE_RADIUS = 60.0;
 
-    // nʂ̐`̐ƃTCY
+    // 地面の正方形の数とサイズ
     constexpr auto PLANE_DIVISION_NUM = 150;
     constexpr auto PLANE_SIZE = 300.0 * static_cast<double>(PLANE_DIVISION_NUM);
+    // 地面の区画の正方形の数 (2 のべき乗なら遠くの区画ほど粗くする) と、描画する距離 (main_world.cpp のフォグの終わり)
+    constexpr auto PLANE_CHUNK_DIVISION_NUM = 8;
+    constexpr auto PLANE_DRAW_DISTANCE = 8000.0;
 
-    // n̏
+    // 地球の情報 (分割レベルは近付いた時の最大)
     constexpr auto SPHERE_RADIUS = 200.0f;
-    constexpr auto SPHERE_DIVISION_NUM = 64;
+    constexpr auto SPHERE_LEVEL = 5;
     constexpr auto SPHERE_POSITION_OFFSET = 500.0;
 
-    // ̏
+    // 爆発の情報
     constexpr auto EXPLOSION_RADIUS = 25.0f;
-    constexpr auto EXPLOSION_DIVISION_NUM = 32;
+    constexpr auto EXPLOSION_LEVEL = 4;
 
     constexpr auto STEPS_CUBE_NUM = 4;
     std::vector<std::shared_ptr<primitive::cube>> cube_list;
@@ -64,11 +70,11 @@ namespace {
             return false;
         }
 
-        // ҋ@[V[vw
+        // 待機モーションをループ指定で
         player->set_attach(0, true);
-        // ړʂw
+        // 移動量を指定
         player->set_movement(MODEL_MOVEMENT);
-        // RWlw
+        // コリジョン値を指定
         player->set_collision_sphere_radius(MODEL_COLLISION_SPHERE_RADIUS);
 
         return true;
@@ -81,11 +87,11 @@ namespace {
             return false;
         }
 
-        // update n\bh posture_base class nĂȂ̂ŁAKvȏ̓_ɃLv`
+        // update 系メソッドは posture_base class しか渡ってこないので、必要な情報はラムダ式にキャプチャさせる
         MATRIX offset = gun->get_offset_matrix();
         auto frame_index = gun->get_target_frame();
 
-        // shared_ptr Ȃǂ͎QƂŃLv`Ă͂Ȃ(Rs[gpɂ)
+        // shared_ptr などは参照でキャプチャしてはいけない(コピー使用にする)
         auto update_gun = [player, offset, frame_index](posture_base* base)-> void {
             auto hundle = player->get_handle();
 
@@ -96,11 +102,7 @@ namespace {
             MATRIX player_hand = MV1GetFrameLocalWorldMatrix(hundle, frame_index/*28*/);
             MATRIX posture = MMult(offset, player_hand);
 
-#if defined(_AMG_MATH)
-            base->set_posture_matrix(ToMath(posture));
-#else
-            base->set_posture_matrix(posture);
-#endif
+            base->set_posture_matrix(backend::object_math::to_native(backend::dx_math::to_math(posture)));
         };
 
         gun->set_update_after(update_gun);
@@ -112,7 +114,7 @@ namespace {
                             std::shared_ptr<mv1::missile>& missile,
                             std::shared_ptr<world::world_base> world,
                             std::shared_ptr<mv1::player>& player,
-                            std::shared_ptr<primitive::sphere>& explosion) {
+                            const std::shared_ptr<primitive::sphere>& explosion) {
         if (!explosion->load(TEXTURE_FILE_EXPLOSION) || !explosion->create()) {
             return false;
         }
@@ -126,7 +128,7 @@ namespace {
         return true;
     }
 
-    bool plane_initialize(std::shared_ptr<primitive::plane>& plane) {
+    bool plane_initialize(const std::shared_ptr<primitive::plane>& plane) {
         if (!plane->load(TEXTURE_FILE_GROUND) || !plane->create()) {
             return false;
         }
@@ -134,7 +136,7 @@ namespace {
         return true;
     }
 
-    bool sphere_initialize(std::shared_ptr<primitive::sphere>& sphere) {
+    bool sphere_initialize(const std::shared_ptr<primitive::sphere>& sphere) {
         if (!sphere->load(TEXTURE_FILE_SPHERE) || !sphere->create()) {
             return false;
         }
@@ -267,29 +269,21 @@ namespace {
             plane->set_lighting(FALSE);
             plane->set_transparent(TRUE);
 
-            // r{[h
+            // ビルボード処理
 #if false
             plane->set_update_posture_matrix(false);
 
             auto update_after_plale = [](posture_base* base)-> void {
-#if defined(_AMG_MATH)
-                auto billboard = camera->get_billboard_matrix();
-                auto scale = base->get_scale_matrix();
-                auto rotate = base->get_rotate_matrix();
-                auto transfer = base->get_transfer_matrix();
-                // plane  XZ ɒ_쐬̂ōŏɉ]s
-                auto posture = scale * rotate * billboard * transfer;
-
-                base->set_posture_matrix(posture);
-#else
-                MATRIX billboard = (*camera)->get_billboard_matrix();
-                MATRIX scale = base->get_scale_matrix();
-                MATRIX rotate = base->get_rotate_matrix();
-                MATRIX transfer = base->get_transfer_matrix();
-                MATRIX posture = MMult(MMult(MMult(scale, rotate), billboard), transfer);
+                using policy = backend::object_math;
 
-                base->set_posture_matrix(posture);
-#endif
+                const auto billboard = policy::to_math((*camera)->get_billboard_matrix());
+                const auto scale = policy::to_math(base->get_scale_matrix());
+                const auto rotate = policy::to_math(base->get_rotate_matrix());
+                const auto transfer = policy::to_math(base->get_transfer_matrix());
+                // plane は XZ 方向に頂点が作成されるので最初に回転処理を行う
+                const auto posture = math::matrix44f::multiply(scale, rotate, billboard, transfer);
+
+                base->set_posture_matrix(policy::to_native(posture));
             };
 
             plane->set_update_after(update_after_plale);
@@ -303,48 +297,53 @@ namespace {
 }
 
 std::shared_ptr<world::world_base> world_initialize(const int screen_width, const int screen_height) {
-    // LN^[ f
+    // キャラクター モデル
     auto player = std::make_shared<mv1::player>();
 
     if (!player_initialize(player)) {
         return nullptr;
     }
 
-    // n
-    auto plane = std::make_shared<primitive::plane>(PLANE_SIZE, PLANE_DIVISION_NUM);
+    // 地面
+    auto plane = std::make_shared<primitive::terrain>(PLANE_SIZE, PLANE_DIVISION_NUM, PLANE_CHUNK_DIVISION_NUM);
 
     if (!plane_initialize(plane)) {
         return nullptr;
     }
 
-    // n
-    auto sphere = std::make_shared<primitive::sphere>(SPHERE_RADIUS, SPHERE_DIVISION_NUM);
+    // 地球
+    auto sphere = std::make_shared<primitive::icosphere>(SPHERE_RADIUS, SPHERE_LEVEL);
 
     if (!sphere_initialize(sphere)) {
         return nullptr;
     }
 
-    // Ki
+    // 階段
     if (!create_steps()) {
         return nullptr;
     }
 
-    // J
+    // カメラ
     camera = camera_initialize(screen_width, screen_height, player);
 
     if (!camera.has_value()) {
         return nullptr;
     }
 
-    // 
+    // 地面は見える区画だけ、地球の分割レベルは画面上の大きさで選ぶ
+    plane->set_camera(*camera);
+    plane->set_draw_distance(PLANE_DRAW_DISTANCE);
+    sphere->set_camera(*camera);
+
+    // 木
     if (!create_trees()) {
         return nullptr;
     }
 
-    // E
+    // 世界
     auto world = std::make_shared<world::world_base>();
 
-    // E֓o^ƃLN^[̃RWo^
+    // 世界へ登録とキャラクターのコリジョン登録
     world->add_camera(*camera);
     world->add_model(player);
     world->add_primitive(plane);
@@ -361,7 +360,7 @@ std::shared_ptr<world::world_base> world_initialize(const int screen_width, cons
 
     player->set_collision_primitive(plane);
 
-    // e fLN^[fɎ
+    // 銃 モデルをキャラクターモデルに持たせる
 #if false
     auto gun = std::make_shared<mv1::gun>();
 
@@ -370,10 +369,12 @@ std::shared_ptr<world::world_base> world_initialize(const int screen_width, cons
     }
 #endif
 
-    // ~TC̏ǉ
+    // ミサイルの処理を追加する
 #if false
     auto missile = std::make_shared<mv1::missile>(screen_width, screen_height);
-    auto explosion = std::make_shared<primitive::sphere>(EXPLOSION_RADIUS, EXPLOSION_DIVISION_NUM);
+    auto explosion = std::make_shared<primitive::icosphere>(EXPLOSION_RADIUS, EXPLOSION_LEVEL);
+
+    explosion->set_camera(*camera);
 
     if (missile_initialize(screen_width, screen_height, missile, world, player, explosion)) {
         world->add_primitive(explosion);